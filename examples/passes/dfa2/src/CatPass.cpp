@@ -44,7 +44,8 @@ struct CAT : public ModulePass {
     for (auto &inst : instructions(mainF)) {
       errs() << " Next are the instructions reachable from " << inst << "\n";
       auto &outSet = dfr->OUT(&inst);
-      for (auto reachInst : outSet) {
+      for (auto reachInstID : outSet.set_bits()) {
+        auto reachInst = dfr->getInstruction(reachInstID);
         errs() << "   " << *reachInst << "\n";
       }
     }
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_ARCHITECTURE_WORKSTEALINGPOOL_H_
+#define NOELLE_SRC_CORE_ARCHITECTURE_WORKSTEALINGPOOL_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Pool of workers that execute a batch of independent tasks.
+ *
+ * The tasks of a batch are split in contiguous ranges, one per worker. A
+ * worker executes the tasks of its own range first and then steals the
+ * remaining tasks of the ranges of the other workers. Hence, a few expensive
+ * tasks do not serialize the batch.
+ *
+ * The thread that runs a batch is one of its workers.
+ */
+class WorkStealingPool {
+public:
+  /*
+   * Create a pool with one worker per logical core.
+   */
+  WorkStealingPool();
+
+  WorkStealingPool(uint32_t numberOfWorkers);
+
+  uint32_t getNumberOfWorkers(void) const;
+
+  /*
+   * Execute @task(taskID, workerID) for every taskID in [0, @numberOfTasks).
+   * Each task is executed exactly once.
+   * The method returns when all tasks have been executed.
+   */
+  void run(uint64_t numberOfTasks,
+           std::function<void(uint64_t taskID, uint32_t workerID)> task);
+
+private:
+  uint32_t numberOfWorkers;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_ARCHITECTURE_WORKSTEALINGPOOL_H_
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/Architecture.hpp"
+#include "arcana/noelle/core/WorkStealingPool.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Tasks not executed yet of the range of a worker.
+ * Ranges are aligned to cache lines to avoid false sharing between workers.
+ */
+struct alignas(64) WorkStealingRange {
+  std::atomic<uint64_t> next;
+  uint64_t end;
+};
+
+WorkStealingPool::WorkStealingPool()
+  : WorkStealingPool(Architecture::getNumberOfLogicalCores()) {
+  return;
+}
+
+WorkStealingPool::WorkStealingPool(uint32_t numberOfWorkers)
+  : numberOfWorkers{ std::max(numberOfWorkers, 1u) } {
+  return;
+}
+
+uint32_t WorkStealingPool::getNumberOfWorkers(void) const {
+  return this->numberOfWorkers;
+}
+
+void WorkStealingPool::run(
+    uint64_t numberOfTasks,
+    std::function<void(uint64_t taskID, uint32_t workerID)> task) {
+
+  /*
+   * Check if there is anything to do.
+   */
+  if (numberOfTasks == 0) {
+    return;
+  }
+
+  /*
+   * Avoid spawning threads that would not have any task to execute.
+   */
+  auto workers = static_cast<uint32_t>(
+      std::min<uint64_t>(this->numberOfWorkers, numberOfTasks));
+  if (workers == 1) {
+    for (uint64_t taskID = 0; taskID < numberOfTasks; taskID++) {
+      task(taskID, 0);
+    }
+    return;
+  }
+
+  /*
+   * Split the tasks in contiguous ranges, one per worker.
+   */
+  std::vector<WorkStealingRange> ranges(workers);
+  auto tasksPerWorker = numberOfTasks / workers;
+  auto leftOver = numberOfTasks % workers;
+  uint64_t begin = 0;
+  for (uint32_t workerID = 0; workerID < workers; workerID++) {
+    auto size = tasksPerWorker + ((workerID < leftOver) ? 1 : 0);
+    auto &range = ranges[workerID];
+    range.next.store(begin, std::memory_order_relaxed);
+    range.end = begin + size;
+    begin += size;
+  }
+
+  /*
+   * Define the code of a worker.
+   * The worker starts from its own range and then visits the ranges of the
+   * other workers in a round-robin order.
+   */
+  auto worker = [&ranges, &task, workers](uint32_t workerID) {
+    for (uint32_t i = 0; i < workers; i++) {
+      auto &range = ranges[(workerID + i) % workers];
+      while (true) {
+        auto taskID = range.next.fetch_add(1, std::memory_order_relaxed);
+        if (taskID >= range.end) {
+          break;
+        }
+        task(taskID, workerID);
+      }
+    }
+  };
+
+  /*
+   * Run the workers.
+   * The current thread is the first worker.
+   */
+  std::vector<std::thread> threads;
+  for (uint32_t workerID = 1; workerID < workers; workerID++) {
+    threads.emplace_back(worker, workerID);
+  }
+  worker(0);
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
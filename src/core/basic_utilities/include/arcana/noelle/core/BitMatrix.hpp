@@ -10,12 +10,17 @@ namespace llvm {
 // BitMatrix is a NxN bit-matrix that depicts whether a relation R
 // holds for a pair with indices (i,j) (i.e., R(i,j) = 0/1)
 // BitMatrix is intended for a dense, asymmetric relation R.
+// Every row is stored as its own BitVector so that rows can be combined a
+// machine word at a time.
 struct BitMatrix {
-  BitMatrix(uint32_t n = 1) : N(n), bv(n * n) {}
+  BitMatrix(uint32_t n = 1) : N(n), rows(n, BitVector(n)) {}
 
-  // Returns the size of BitVector
+  // Returns the number of pairs (i,j) that are related
   uint32_t count() const;
 
+  // Returns N
+  uint32_t size() const;
+
   // Specifies that row is related to col, i.e., R(row,col) = 1
   void set(uint32_t row, uint32_t col, bool v = true);
 
@@ -31,24 +36,31 @@ struct BitMatrix {
   // matrix, where (i,j) is set if there is a directed path from i to j
   void transitiveClosure();
 
+  // Computes the transitive closure of an acyclic relation.
+  // reversedTopologicalOrder lists every index after all of its successors
+  // (e.g., a post-order visit); each row is then closed with one pass over
+  // its direct successors.
+  void transitiveClosureOfDAG(
+      const std::vector<uint32_t> &reversedTopologicalOrder);
+
+  // Sets row dst to row dst | row src
+  void unionRows(uint32_t dst, uint32_t src);
+
+  // Returns the columns set in row
+  const BitVector &getRow(uint32_t row) const;
+
+  // Collapses the indices set in merged into dst, which must be one of them,
+  // while keeping the matrix transitively closed.
+  // The matrix must already be transitively closed.
+  // The rows and columns of the other indices in merged are cleared.
+  void mergeInto(uint32_t dst, const BitVector &merged);
+
   // Emits to fout the BitMatrix
   void dump(raw_ostream &fout) const;
 
 private:
   uint32_t N;
-  BitVector bv;
-
-  // For a given row returns the first col that is set.
-  // Returns -1 if none found.
-  int32_t firstSuccessor(uint32_t row) const;
-
-  // For a given row returns the first col after prev (col>prev) that is set.
-  // Returns -1 if none found.
-  int32_t nextSuccessor(uint32_t row, uint32_t prev) const;
-
-  // Returns the index corresponding to a pair (row.col)
-  // i.e., idx = row * N + col
-  uint32_t idx(uint32_t row, uint32_t col) const;
+  std::vector<BitVector> rows;
 };
 
 } // namespace llvm
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2016 - 2019  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_BASIC_UTILITIES_STRONGLYCONNECTEDCOMPONENTS_H_
+#define NOELLE_SRC_CORE_BASIC_UTILITIES_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Find the strongly connected components of a graph with an iterative version
+ * of Tarjan's algorithm.
+ *
+ * The graph is visited starting from every node of @roots that has not been
+ * reached yet.
+ * @successorsOf(node) returns the range of the successors of a node; its
+ * iterators must stay valid while the graph is visited.
+ * @onSCC(nodes) is invoked once per component with the nodes that belong to
+ * it. Components are reported in reverse topological order (i.e., a component
+ * is reported after all components reachable from it).
+ */
+template <class NodeT, class RootsT, class SuccessorsFn, class SCCFn>
+void forEachSCC(const RootsT &roots, SuccessorsFn successorsOf, SCCFn onSCC) {
+  using SuccessorIt =
+      decltype(successorsOf(std::declval<NodeT>()).begin());
+  struct Frame {
+    uint32_t visitIndex;
+    SuccessorIt nextSuccessor;
+    SuccessorIt endSuccessor;
+  };
+
+  /*
+   * Nodes are identified by the order they are visited in.
+   * A node that has been visited but that does not belong to a component yet
+   * is on the stack of Tarjan's algorithm.
+   */
+  DenseMap<NodeT, uint32_t> visitIndex;
+  std::vector<uint32_t> lowLink;
+  std::vector<bool> isInSCC;
+  std::vector<NodeT> tarjanStack;
+  std::vector<uint32_t> tarjanStackIndices;
+
+  /*
+   * The recursion of the DFS is replaced by an explicit stack of nodes paired
+   * with their next successor to follow.
+   */
+  std::vector<Frame> dfsStack;
+  auto visit = [&](NodeT node) {
+    uint32_t index = lowLink.size();
+    visitIndex[node] = index;
+    lowLink.push_back(index);
+    isInSCC.push_back(false);
+    tarjanStack.push_back(node);
+    tarjanStackIndices.push_back(index);
+    auto successors = successorsOf(node);
+    dfsStack.push_back({ index, successors.begin(), successors.end() });
+  };
+  for (NodeT root : roots) {
+    if (visitIndex.find(root) != visitIndex.end()) {
+      continue;
+    }
+    visit(root);
+
+    while (!dfsStack.empty()) {
+      auto &frame = dfsStack.back();
+      auto index = frame.visitIndex;
+
+      /*
+       * Follow the next successor of the node, if any.
+       */
+      if (frame.nextSuccessor != frame.endSuccessor) {
+        NodeT successor = *frame.nextSuccessor;
+        ++frame.nextSuccessor;
+        auto it = visitIndex.find(successor);
+        if (it == visitIndex.end()) {
+          visit(successor);
+        } else if (!isInSCC[it->second]) {
+          lowLink[index] = std::min(lowLink[index], it->second);
+        }
+        continue;
+      }
+
+      /*
+       * All successors of the node have been visited.
+       */
+      dfsStack.pop_back();
+      if (!dfsStack.empty()) {
+        auto parentIndex = dfsStack.back().visitIndex;
+        lowLink[parentIndex] = std::min(lowLink[parentIndex], lowLink[index]);
+      }
+
+      /*
+       * Check if the node is the root of a component.
+       * Nodes are pushed on the stack of Tarjan's algorithm in the order they
+       * are visited, so the component is the top of that stack down to its
+       * root.
+       */
+      if (lowLink[index] != index) {
+        continue;
+      }
+      auto sccBegin = tarjanStack.size();
+      do {
+        sccBegin--;
+        isInSCC[tarjanStackIndices[sccBegin]] = true;
+      } while (tarjanStackIndices[sccBegin] != index);
+      onSCC(ArrayRef<NodeT>(tarjanStack).slice(sccBegin));
+      tarjanStack.resize(sccBegin);
+      tarjanStackIndices.resize(sccBegin);
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_BASIC_UTILITIES_STRONGLYCONNECTEDCOMPONENTS_H_
@@ -35,6 +35,8 @@
 #include <list>
 #include <deque>
 #include <thread>
+#include <atomic>
+#include <chrono>
 #include <sstream>
 #include <math.h>
 #include <optional>
@@ -47,6 +49,7 @@
 #include <llvm/ADT/StringRef.h>
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/ADT/SCCIterator.h"
+#include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringSet.h"
@@ -74,6 +77,11 @@
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/CFG.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <llvm/IR/Verifier.h>
 
 using namespace llvm;
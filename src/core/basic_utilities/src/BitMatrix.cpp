@@ -4,113 +4,107 @@ namespace llvm {
 
 void BitMatrix::resize(uint32_t n) {
   N = n;
-  bv.clear();
-  bv.resize(n * n);
+  rows.clear();
+  rows.resize(n, BitVector(n));
 }
 
-uint32_t BitMatrix::idx(uint32_t row, uint32_t col) const {
-  assert(row < N);
-  assert(col < N);
-  return row * N + col;
+uint32_t BitMatrix::count() const {
+  uint32_t c = 0;
+  for (const auto &r : rows) {
+    c += r.count();
+  }
+  return c;
 }
 
-uint32_t BitMatrix::count() const {
-  return bv.count();
+uint32_t BitMatrix::size() const {
+  return N;
 }
 
 void BitMatrix::set(uint32_t row, uint32_t col, bool v) {
-  const uint32_t i = idx(row, col);
+  assert(row < N);
+  assert(col < N);
 
   if (v) {
-    bv.set(i);
+    rows[row].set(col);
   } else {
-    bv.reset(i);
+    rows[row].reset(col);
   }
 }
 
 bool BitMatrix::test(uint32_t row, uint32_t col) const {
-  const uint32_t i = idx(row, col);
+  assert(row < N);
+  assert(col < N);
 
-  return bv.test(i);
+  return rows[row].test(col);
 }
 
-int32_t BitMatrix::firstSuccessor(uint32_t row) const {
-  const uint32_t rowBegin = N * row;
-  int32_t next = -1;
-
-  if (0 == rowBegin) {
-    next = bv.find_first();
-  } else {
-    next = bv.find_next(rowBegin - 1);
-  }
-
-  if (-1 == next) {
-    return -1;
-  }
-
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
-  }
+const BitVector &BitMatrix::getRow(uint32_t row) const {
+  assert(row < N);
 
-  return next - rowBegin;
+  return rows[row];
 }
 
-int32_t BitMatrix::nextSuccessor(uint32_t row, uint32_t prev) const {
-  int32_t next = bv.find_next(N * row + prev);
-  if (-1 == next) {
-    return -1;
-  }
-
-  const uint32_t rowBegin = N * row;
-  const uint32_t rowEnd = rowBegin + N;
-  if (((uint32_t)next) >= rowEnd) {
-    return -1;
-  }
+void BitMatrix::unionRows(uint32_t dst, uint32_t src) {
+  assert(dst < N);
+  assert(src < N);
 
-  return next - rowBegin;
+  rows[dst] |= rows[src];
 }
 
 void BitMatrix::transitiveClosure() {
-  uint32_t nAdd = 0;
 
-  typedef std::list<uint32_t> Worklist;
-  Worklist worklist;
-  for (uint32_t i = 0; i < N; ++i) {
-    worklist.push_back(i);
+  // Warshall's algorithm where the innermost loop is a word-wise or:
+  // after step k, (i,j) is set if there is a path from i to j whose
+  // intermediate indices are all <= k.
+  for (uint32_t k = 0; k < N; ++k) {
+    for (uint32_t i = 0; i < N; ++i) {
+      if ((i != k) && rows[i].test(k)) {
+        rows[i] |= rows[k];
+      }
+    }
   }
+}
 
-  while (!worklist.empty()) {
-    uint32_t i = worklist.front();
-    worklist.pop_front();
-
-    bool changedI = false;
+void BitMatrix::transitiveClosureOfDAG(
+    const std::vector<uint32_t> &reversedTopologicalOrder) {
+  assert(reversedTopologicalOrder.size() == N);
+
+  // The successors of i are closed before i is visited, so
+  // row[i] = direct(i) | (row[j] for every direct successor j of i).
+  BitVector direct(N);
+  for (auto i : reversedTopologicalOrder) {
+    direct = rows[i];
+    for (auto j : direct.set_bits()) {
+      rows[i] |= rows[j];
+    }
+  }
+}
 
-    // (i->j)
-    for (int32_t j = firstSuccessor(i); j != -1; j = nextSuccessor(i, j)) {
-      // bit-wise or row[i] |= row[j]
+void BitMatrix::mergeInto(uint32_t dst, const BitVector &merged) {
+  assert(dst < N);
+  assert(merged.size() == N);
+  assert(merged.test(dst));
 
-      // (j->k)
-      for (int32_t k = firstSuccessor(j); k != -1; k = nextSuccessor(j, k)) {
-        // but not (i->k)
-        if (!test(i, k)) {
-          changedI = true;
-          ++nAdd;
-          set(i, k);
-        }
-      }
+  // The merged index reaches whatever any of the indices it replaces did.
+  for (auto i : merged.set_bits()) {
+    if (i != dst) {
+      rows[dst] |= rows[i];
+      rows[i].reset();
     }
-
-    if (changedI) {
-      for (uint32_t p = 0; p < N; ++p) {
-        if (test(p, i)) {
-          if (std::find(worklist.begin(), worklist.end(), p)
-              == worklist.end()) {
-            worklist.push_back(p);
-          }
-        }
-      }
+  }
+  rows[dst].reset(merged);
+
+  // Every index that reached one of the merged indices now reaches the
+  // merged index, and through it all of its successors.
+  // This also accounts for the paths that enter the merged index through one
+  // of the old indices and leave it through another.
+  for (uint32_t p = 0; p < N; ++p) {
+    if (merged.test(p) || !rows[p].anyCommon(merged)) {
+      continue;
     }
+    rows[p].reset(merged);
+    rows[p] |= rows[dst];
+    rows[p].set(dst);
   }
 }
 
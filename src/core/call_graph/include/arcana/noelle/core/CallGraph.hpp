@@ -100,6 +100,8 @@ private:
 
   void mergeCallGraphIslandsForEscapedFunctions(
       std::unordered_map<Function *, CallGraph *> &islands) const;
+
+  friend class FrozenCallGraph;
 };
 
 } // namespace arcana::noelle
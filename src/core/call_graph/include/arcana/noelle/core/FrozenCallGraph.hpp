@@ -0,0 +1,92 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_CALL_GRAPH_FROZENCALLGRAPH_H_
+#define NOELLE_SRC_CORE_CALL_GRAPH_FROZENCALLGRAPH_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/CallGraph.hpp"
+#include "arcana/noelle/core/WorkStealingPool.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Read-only snapshot of a call graph stored in contiguous arrays.
+ *
+ * Functions are numbered from 0 following their order in the module. The
+ * callees of a function are a contiguous slice of the callee array (CSR
+ * layout).
+ *
+ * Sets of functions are bit vectors indexed by function IDs.
+ *
+ * The snapshot does not track changes of the call graph it has been built
+ * from; it must be rebuilt if that call graph is modified.
+ */
+class FrozenCallGraph {
+public:
+  FrozenCallGraph(Module &M, CallGraph &callGraph);
+
+  FrozenCallGraph() = delete;
+
+  uint32_t getNumberOfFunctions(void) const;
+
+  bool isInGraph(Function *f) const;
+
+  uint32_t getFunctionID(Function *f) const;
+
+  Function *getFunction(uint32_t functionID) const;
+
+  /*
+   * Return the IDs of the functions that @functionID may call.
+   */
+  ArrayRef<uint32_t> getCallees(uint32_t functionID) const;
+
+  /*
+   * Return the functions with a body that are reachable from @functionID
+   * through calls to functions with a body. @functionID is included.
+   *
+   * The result is computed on the first request and it is kept for later
+   * ones.
+   */
+  const BitVector &getFunctionsReachableFrom(uint32_t functionID);
+
+  /*
+   * Compute the functions reachable from each of @functionIDs in parallel.
+   */
+  void computeFunctionsReachableFrom(const std::vector<uint32_t> &functionIDs,
+                                     WorkStealingPool &pool);
+
+  std::set<Function *> getFunctions(const BitVector &s) const;
+
+private:
+  std::vector<Function *> functions;
+  DenseMap<Function *, uint32_t> functionIDs;
+  BitVector functionsWithBody;
+  std::vector<uint32_t> calleeOffsets;
+  std::vector<uint32_t> callees;
+  std::unordered_map<uint32_t, BitVector> reachableFunctions;
+
+  BitVector computeFunctionsReachableFrom(uint32_t functionID) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_CALL_GRAPH_FROZENCALLGRAPH_H_
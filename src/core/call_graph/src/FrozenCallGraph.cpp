@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/FrozenCallGraph.hpp"
+
+namespace arcana::noelle {
+
+FrozenCallGraph::FrozenCallGraph(Module &M, CallGraph &callGraph) {
+
+  /*
+   * Number the functions of the call graph following the order of the
+   * module.
+   */
+  for (auto &f : M) {
+    if (callGraph.functions.find(&f) == callGraph.functions.end()) {
+      continue;
+    }
+    this->functionIDs[&f] = this->functions.size();
+    this->functions.push_back(&f);
+  }
+  auto numberOfFunctions = this->functions.size();
+  this->functionsWithBody.resize(numberOfFunctions);
+
+  /*
+   * Store the callees of every function.
+   */
+  this->calleeOffsets.resize(numberOfFunctions + 1, 0);
+  for (uint32_t callerID = 0; callerID < numberOfFunctions; callerID++) {
+    auto caller = this->functions[callerID];
+    this->calleeOffsets[callerID] = this->callees.size();
+    if (!caller->empty()) {
+      this->functionsWithBody.set(callerID);
+    }
+
+    auto callerNode = callGraph.functions.at(caller);
+    auto outgoingEdgesIt = callGraph.outgoingEdges.find(callerNode);
+    if (outgoingEdgesIt == callGraph.outgoingEdges.end()) {
+      continue;
+    }
+    for (auto &pair : outgoingEdgesIt->second) {
+      auto callee = pair.first->getFunction();
+      if (!this->isInGraph(callee)) {
+        continue;
+      }
+      this->callees.push_back(this->getFunctionID(callee));
+    }
+
+    /*
+     * Sort the callees to make the snapshot independent of the order of the
+     * unordered containers of the call graph.
+     */
+    std::sort(this->callees.begin() + this->calleeOffsets[callerID],
+              this->callees.end());
+  }
+  this->calleeOffsets[numberOfFunctions] = this->callees.size();
+
+  return;
+}
+
+uint32_t FrozenCallGraph::getNumberOfFunctions(void) const {
+  return this->functions.size();
+}
+
+bool FrozenCallGraph::isInGraph(Function *f) const {
+  return this->functionIDs.find(f) != this->functionIDs.end();
+}
+
+uint32_t FrozenCallGraph::getFunctionID(Function *f) const {
+  auto it = this->functionIDs.find(f);
+  assert(it != this->functionIDs.end());
+
+  return it->second;
+}
+
+Function *FrozenCallGraph::getFunction(uint32_t functionID) const {
+  assert(functionID < this->functions.size());
+
+  return this->functions[functionID];
+}
+
+ArrayRef<uint32_t> FrozenCallGraph::getCallees(uint32_t functionID) const {
+  auto begin = this->calleeOffsets[functionID];
+  auto end = this->calleeOffsets[functionID + 1];
+
+  return ArrayRef<uint32_t>(this->callees).slice(begin, end - begin);
+}
+
+const BitVector &FrozenCallGraph::getFunctionsReachableFrom(
+    uint32_t functionID) {
+  auto it = this->reachableFunctions.find(functionID);
+  if (it != this->reachableFunctions.end()) {
+    return it->second;
+  }
+
+  auto &s = this->reachableFunctions[functionID];
+  s = this->computeFunctionsReachableFrom(functionID);
+
+  return s;
+}
+
+void FrozenCallGraph::computeFunctionsReachableFrom(
+    const std::vector<uint32_t> &functionIDs,
+    WorkStealingPool &pool) {
+
+  /*
+   * Allocate the results sequentially, so the workers do not modify the map.
+   */
+  std::vector<BitVector *> results;
+  std::vector<uint32_t> roots;
+  for (auto functionID : functionIDs) {
+    if (this->reachableFunctions.find(functionID)
+        != this->reachableFunctions.end()) {
+      continue;
+    }
+    roots.push_back(functionID);
+    results.push_back(&this->reachableFunctions[functionID]);
+  }
+
+  /*
+   * Visit the call graph from every root in parallel.
+   */
+  pool.run(roots.size(), [this, &roots, &results](uint64_t taskID, uint32_t) {
+    *results[taskID] = this->computeFunctionsReachableFrom(roots[taskID]);
+  });
+
+  return;
+}
+
+BitVector FrozenCallGraph::computeFunctionsReachableFrom(
+    uint32_t functionID) const {
+  BitVector reached(this->getNumberOfFunctions());
+
+  /*
+   * Visit the functions with a body that can be reached from @functionID.
+   */
+  std::vector<uint32_t> worklist;
+  reached.set(functionID);
+  worklist.push_back(functionID);
+  while (!worklist.empty()) {
+    auto callerID = worklist.back();
+    worklist.pop_back();
+
+    for (auto calleeID : this->getCallees(callerID)) {
+      if (reached.test(calleeID)) {
+        continue;
+      }
+      if (!this->functionsWithBody.test(calleeID)) {
+        continue;
+      }
+      reached.set(calleeID);
+      worklist.push_back(calleeID);
+    }
+  }
+
+  return reached;
+}
+
+std::set<Function *> FrozenCallGraph::getFunctions(const BitVector &s) const {
+  std::set<Function *> functionsInSet;
+
+  for (auto functionID : s.set_bits()) {
+    functionsInSet.insert(this->getFunction(functionID));
+  }
+
+  return functionsInSet;
+}
+
+} // namespace arcana::noelle
@@ -36,6 +36,17 @@ public:
 
   bool isIncludedInACycle(BasicBlock &bb);
 
+  /*
+   * The basic blocks of a function that are included in a cycle are computed
+   * the first time the function is queried and they are kept for later
+   * queries.
+   * They must be invalidated when the CFG of the function changes.
+   * @f is not dereferenced, so it can be a function that has been erased.
+   */
+  void invalidateCycles(Function *f);
+
+  void invalidateCycles(void);
+
   bool doInitialization(Module &M) override;
 
   void getAnalysisUsage(AnalysisUsage &AU) const override;
@@ -43,6 +54,10 @@ public:
   bool runOnModule(Module &M) override;
 
 private:
+  std::unordered_map<Function *, std::unordered_set<BasicBlock *>>
+      blocksInCycles;
+
+  const std::unordered_set<BasicBlock *> &getBlocksInCycles(Function &f);
 };
 
 } // namespace arcana::noelle
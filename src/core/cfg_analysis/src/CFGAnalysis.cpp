@@ -20,7 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/CFGAnalysis.hpp"
-#include "arcana/noelle/core/DataFlowAnalysis.hpp"
+#include "arcana/noelle/core/StronglyConnectedComponents.hpp"
 
 namespace arcana::noelle {
 
@@ -31,14 +31,15 @@ CFGAnalysis::CFGAnalysis() : ModulePass{ ID } {
 bool CFGAnalysis::isIncludedInACycle(BasicBlock &bb) {
 
   /*
-   * Fetch an instruction of the basic block
+   * Fetch the basic blocks of the function that are included in a cycle.
    */
-  auto inst = &*bb.begin();
+  auto f = bb.getParent();
+  auto &blocks = this->getBlocksInCycles(*f);
 
   /*
-   * Check if that instruction is included in a cycle.
+   * Check if @bb is one of them.
    */
-  auto cycle = this->isIncludedInACycle(*inst);
+  auto cycle = blocks.find(&bb) != blocks.end();
 
   return cycle;
 }
@@ -46,28 +47,65 @@ bool CFGAnalysis::isIncludedInACycle(BasicBlock &bb) {
 bool CFGAnalysis::isIncludedInACycle(Instruction &i) {
 
   /*
-   * Compute the reachable analysis.
+   * There is no cycle within a basic block.
+   * Hence, @i is included in a cycle if and only if its basic block is.
    */
-  DataFlowAnalysis dfa{};
-  auto f = i.getFunction();
-  auto filter = [&i](Instruction *inst) -> bool {
-    if (inst == &i) {
-      return true;
-    }
-    return false;
-  };
-  auto dfr = dfa.runReachableAnalysis(f, filter);
+  auto bb = i.getParent();
+  auto cycle = this->isIncludedInACycle(*bb);
+
+  return cycle;
+}
+
+void CFGAnalysis::invalidateCycles(Function *f) {
+  this->blocksInCycles.erase(f);
+
+  return;
+}
+
+void CFGAnalysis::invalidateCycles(void) {
+  this->blocksInCycles.clear();
+
+  return;
+}
+
+const std::unordered_set<BasicBlock *> &CFGAnalysis::getBlocksInCycles(
+    Function &f) {
+
+  /*
+   * Check if the cycles of @f have already been computed.
+   */
+  auto it = this->blocksInCycles.find(&f);
+  if (it != this->blocksInCycles.end()) {
+    return it->second;
+  }
+  auto &blocks = this->blocksInCycles[&f];
 
   /*
-   * Check if the instruction @i is reachable just after it.
-   * If it is, then @i is within a cycle.
+   * Compute the strongly connected components of the CFG.
+   * All basic blocks are considered, including unreachable ones.
    */
-  auto &outSet = dfr->OUT(&i);
-  if (outSet.count(&i) > 0) {
-    return true;
+  std::vector<BasicBlock *> roots;
+  for (auto &bb : f) {
+    roots.push_back(&bb);
   }
+  auto successorsOf = [](BasicBlock *bb) { return successors(bb); };
+  auto addCycle = [&blocks](ArrayRef<BasicBlock *> scc) {
+    /*
+     * The component is a cycle if it has more than one basic block or if its
+     * only basic block jumps to itself.
+     */
+    auto isCycle = scc.size() > 1;
+    if (!isCycle) {
+      auto bb = scc.front();
+      isCycle = is_contained(successors(bb), bb);
+    }
+    if (isCycle) {
+      blocks.insert(scc.begin(), scc.end());
+    }
+  };
+  forEachSCC<BasicBlock *>(roots, successorsOf, addCycle);
 
-  return false;
+  return blocks;
 }
 
 } // namespace arcana::noelle
@@ -25,6 +25,8 @@
 #include "arcana/noelle/core/SystemHeaders.hpp"
 
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/DataFlowBitVectorResult.hpp"
+#include "arcana/noelle/core/DataFlowSolver.hpp"
 #include "arcana/noelle/core/DataFlowEngine.hpp"
 #include "arcana/noelle/core/DataFlowAnalysis.hpp"
 
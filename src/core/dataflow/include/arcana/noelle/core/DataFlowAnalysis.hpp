@@ -24,6 +24,8 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/DataFlowBitVectorResult.hpp"
+#include "arcana/noelle/core/DataFlowEngine.hpp"
 
 namespace arcana::noelle {
 
@@ -34,13 +36,27 @@ public:
    */
   DataFlowAnalysis();
 
-  DataFlowResult *runReachableAnalysis(Function *f);
+  DataFlowBitVectorResult *runReachableAnalysis(Function *f);
 
-  DataFlowResult *runReachableAnalysis(
+  DataFlowBitVectorResult *runReachableAnalysis(
       Function *f,
       std::function<bool(Instruction *i)> filter);
 
-  DataFlowResult *getFullSets(Function *f);
+  DataFlowBitVectorResult *getFullSets(Function *f);
+
+  /*
+   * Run the reachable analysis on every function of @functions in parallel.
+   * @filter is invoked concurrently and it must be thread safe.
+   * The i-th result returned belongs to the i-th function of @functions.
+   */
+  std::vector<DataFlowBitVectorResult *> runReachableAnalysis(
+      const std::vector<Function *> &functions,
+      std::function<bool(Instruction *i)> filter);
+
+  std::vector<DataFlowBitVectorResult *> runReachableAnalysis(
+      const std::vector<Function *> &functions,
+      std::function<bool(Instruction *i)> filter,
+      WorkStealingPool &pool);
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTORRESULT_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTORRESULT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+enum class DataFlowDirection;
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+class DataFlowSolver;
+
+/*
+ * Result of a data-flow analysis where the GEN, KILL, IN, and OUT sets are
+ * dense bit vectors.
+ *
+ * The values of the function (its instructions first, then its arguments) are
+ * numbered when the result is created. Bit i of a set represents the value
+ * with ID i. Instructions share their value ID with their index in the flat
+ * arrays that store the four sets.
+ *
+ * When the result is produced by a block-summary analysis, it also keeps the
+ * sets of basic blocks. The sets of instructions are derived from them before
+ * the analysis returns, so the result does not refer to the transfer
+ * functions given to the engine.
+ */
+class DataFlowBitVectorResult {
+public:
+  /*
+   * Methods
+   */
+  DataFlowBitVectorResult(Function *f);
+
+  BitVector &GEN(Instruction *inst);
+  BitVector &KILL(Instruction *inst);
+  BitVector &IN(Instruction *inst);
+  BitVector &OUT(Instruction *inst);
+
+  /*
+   * Sets of basic blocks.
+   * They are available only for results of block-summary analyses.
+   * IN is the set at the entry of @bb and OUT is the set at its exit, for both
+   * forward and backward analyses.
+   */
+  BitVector &GEN(BasicBlock *bb);
+  BitVector &KILL(BasicBlock *bb);
+  BitVector &IN(BasicBlock *bb);
+  BitVector &OUT(BasicBlock *bb);
+
+  bool hasBlockSummaries(void) const;
+
+  uint32_t getID(Value *v) const;
+
+  Value *getValue(uint32_t id) const;
+
+  Instruction *getInstruction(uint32_t id) const;
+
+  uint32_t getNumberOfValues(void) const;
+
+  uint32_t getNumberOfInstructions(void) const;
+
+  std::set<Value *> getValues(const BitVector &s) const;
+
+  bool contains(const BitVector &s, Value *v) const;
+
+private:
+  std::vector<Value *> values;
+  std::unordered_map<Value *, uint32_t> valueIDs;
+  uint32_t numberOfInstructions;
+  std::vector<BitVector> gens;
+  std::vector<BitVector> kills;
+  std::vector<BitVector> ins;
+  std::vector<BitVector> outs;
+  std::vector<bool> areInstructionSetsAvailable;
+
+  /*
+   * Block summaries.
+   */
+  bool isForward;
+  std::unordered_map<BasicBlock *, uint32_t> basicBlockIDs;
+  std::vector<BitVector> blockGENs;
+  std::vector<BitVector> blockKILLs;
+  std::vector<BitVector> blockINs;
+  std::vector<BitVector> blockOUTs;
+
+  uint32_t fetchInstructionSets(Instruction *inst);
+
+  uint32_t getBasicBlockID(BasicBlock *bb) const;
+
+  void allocateInstructionSets(uint32_t id);
+
+  void initializeBlockSummaries(Function *f, bool isForward);
+
+  template <class ComputeGEN, class ComputeKILL>
+  void computeBlockGENAndKILL(BasicBlock *bb,
+                              ComputeGEN &computeGEN,
+                              ComputeKILL &computeKILL);
+
+  template <class ComputeGEN, class ComputeKILL>
+  void computeInstructionSetsOfBasicBlock(BasicBlock *bb,
+                                          ComputeGEN &computeGEN,
+                                          ComputeKILL &computeKILL);
+
+  template <DataFlowDirection direction,
+            class DataFlowResultType,
+            class SetType>
+  friend class DataFlowSolver;
+};
+
+template <class ComputeGEN, class ComputeKILL>
+void DataFlowBitVectorResult::computeBlockGENAndKILL(BasicBlock *bb,
+                                                     ComputeGEN &computeGEN,
+                                                     ComputeKILL &computeKILL) {
+  auto bbID = this->getBasicBlockID(bb);
+  auto &genB = this->blockGENs[bbID];
+  auto &killB = this->blockKILLs[bbID];
+
+  /*
+   * Compose the transfer functions of the instructions of @bb following the
+   * direction of the analysis:
+   *
+   * GEN[bb] = GEN[i] U (GEN[bb] - KILL[i])
+   * KILL[bb] = KILL[bb] U KILL[i]
+   */
+  auto compose = [this, &genB, &killB, &computeGEN, &computeKILL](
+                     Instruction *inst) {
+    auto id = this->getID(inst);
+
+    /*
+     * Compute GEN[inst] and KILL[inst] in temporary sets.
+     */
+    auto numberOfValues = this->values.size();
+    this->gens[id].resize(numberOfValues);
+    this->kills[id].resize(numberOfValues);
+    this->areInstructionSetsAvailable[id] = true;
+    computeGEN(inst, this);
+    computeKILL(inst, this);
+
+    /*
+     * Fold them into the summary of the basic block.
+     */
+    auto &genI = this->gens[id];
+    auto &killI = this->kills[id];
+    genB.reset(killI);
+    genB |= genI;
+    killB |= killI;
+
+    /*
+     * Free the temporary sets.
+     */
+    this->gens[id] = BitVector();
+    this->kills[id] = BitVector();
+    this->areInstructionSetsAvailable[id] = false;
+  };
+  if (this->isForward) {
+    for (auto &inst : *bb) {
+      compose(&inst);
+    }
+  } else {
+    for (auto &inst : reverse(*bb)) {
+      compose(&inst);
+    }
+  }
+
+  return;
+}
+
+template <class ComputeGEN, class ComputeKILL>
+void DataFlowBitVectorResult::computeInstructionSetsOfBasicBlock(
+    BasicBlock *bb,
+    ComputeGEN &computeGEN,
+    ComputeKILL &computeKILL) {
+
+  /*
+   * Allocate the sets of the instructions of @bb.
+   */
+  for (auto &inst : *bb) {
+    auto id = this->getID(&inst);
+    this->allocateInstructionSets(id);
+  }
+
+  /*
+   * Compute GEN and KILL of the instructions of @bb.
+   */
+  for (auto &inst : *bb) {
+    computeGEN(&inst, this);
+    computeKILL(&inst, this);
+  }
+
+  /*
+   * Propagate the set at the boundary of @bb through its instructions.
+   */
+  auto bbID = this->getBasicBlockID(bb);
+  if (this->isForward) {
+    auto current = this->blockINs[bbID];
+    for (auto &inst : *bb) {
+      auto id = this->getID(&inst);
+
+      /*
+       * OUT[i] = GEN[i] U (IN[i] - KILL[i])
+       */
+      this->ins[id] = current;
+      current.reset(this->kills[id]);
+      current |= this->gens[id];
+      this->outs[id] = current;
+    }
+
+  } else {
+    auto current = this->blockOUTs[bbID];
+    for (auto &inst : reverse(*bb)) {
+      auto id = this->getID(&inst);
+
+      /*
+       * IN[i] = GEN[i] U (OUT[i] - KILL[i])
+       */
+      this->outs[id] = current;
+      current.reset(this->kills[id]);
+      current |= this->gens[id];
+      this->ins[id] = current;
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWBITVECTORRESULT_H_
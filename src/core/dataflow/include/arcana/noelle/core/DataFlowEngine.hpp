@@ -24,6 +24,9 @@
 
 #include "arcana/noelle/core/SystemHeaders.hpp"
 #include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/DataFlowBitVectorResult.hpp"
+#include "arcana/noelle/core/DataFlowSolver.hpp"
+#include "arcana/noelle/core/WorkStealingPool.hpp"
 
 namespace arcana::noelle {
 
@@ -88,6 +91,90 @@ public:
                          std::set<Value *> &OUT,
                          DataFlowResult *df)> computeOUT);
 
+  DataFlowBitVectorResult *applyForward(
+      Function *f,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)>
+          computeKILL,
+      std::function<void(Instruction *inst, BitVector &IN)> initializeIN,
+      std::function<void(Instruction *inst, BitVector &OUT)> initializeOUT,
+      std::function<void(Instruction *inst,
+                         Instruction *predecessor,
+                         BitVector &IN,
+                         DataFlowBitVectorResult *df)> computeIN,
+      std::function<void(Instruction *inst,
+                         BitVector &OUT,
+                         DataFlowBitVectorResult *df)> computeOUT);
+
+  DataFlowBitVectorResult *applyBackward(
+      Function *f,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)>
+          computeKILL,
+      std::function<void(Instruction *inst,
+                         BitVector &IN,
+                         DataFlowBitVectorResult *df)> computeIN,
+      std::function<void(Instruction *inst,
+                         Instruction *successor,
+                         BitVector &OUT,
+                         DataFlowBitVectorResult *df)> computeOUT);
+
+  /*
+   * Block-summary analyses.
+   *
+   * They solve problems where the transfer function of an instruction is
+   * OUT = GEN U (IN - KILL) (IN = GEN U (OUT - KILL) for backward problems).
+   * The GEN and KILL sets of the instructions of a basic block are composed
+   * once and the fixed point is computed only over the sets at the boundaries
+   * of basic blocks.
+   * The sets of instructions are derived from the sets of basic blocks before
+   * returning; @computeGEN and @computeKILL must only write the GEN and KILL
+   * sets of the instruction given as input.
+   */
+  DataFlowBitVectorResult *applyForwardWithBlockSummaries(
+      Function *f,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)>
+          computeKILL,
+      DataFlowMeetOperator meet);
+
+  DataFlowBitVectorResult *applyBackwardWithBlockSummaries(
+      Function *f,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)>
+          computeKILL,
+      DataFlowMeetOperator meet);
+
+  /*
+   * Batch analyses.
+   *
+   * They run @analysis on every function of @functions using the workers of
+   * @pool (one worker per logical core if no pool is given). Each worker owns
+   * an engine and gives it to @analysis, which is therefore invoked
+   * concurrently on different functions: it must not modify state that is
+   * shared across functions.
+   * The i-th result returned belongs to the i-th function of @functions.
+   */
+  template <class DataFlowResultType>
+  static std::vector<DataFlowResultType *> applyToFunctions(
+      const std::vector<Function *> &functions,
+      std::function<DataFlowResultType *(DataFlowEngine &engine, Function *f)>
+          analysis);
+
+  template <class DataFlowResultType>
+  static std::vector<DataFlowResultType *> applyToFunctions(
+      const std::vector<Function *> &functions,
+      std::function<DataFlowResultType *(DataFlowEngine &engine, Function *f)>
+          analysis,
+      WorkStealingPool &pool);
+
+  /*
+   * Statistics of the last analysis run by the engine.
+   */
+  uint64_t getNumberOfIterations(void) const;
+
+  uint64_t getNumberOfVisits(BasicBlock *bb) const;
+
 protected:
   void computeGENAndKILL(
       Function *f,
@@ -96,37 +183,89 @@ protected:
       DataFlowResult *df);
 
 private:
-  DataFlowResult *applyGeneralizedForwardAnalysis(
+  DataFlowStatistics statistics;
+
+  DataFlowBitVectorResult *applyBlockSummaryAnalysis(
       Function *f,
-      std::function<void(Instruction *, DataFlowResult *)> computeGEN,
-      std::function<void(Instruction *, DataFlowResult *)> computeKILL,
-      std::function<void(Instruction *inst, std::set<Value *> &IN)>
-          initializeIN,
-      std::function<void(Instruction *inst, std::set<Value *> &OUT)>
-          initializeOUT,
-      std::function<std::list<BasicBlock *>(BasicBlock *bb)> getPredecessors,
-      std::function<std::list<BasicBlock *>(BasicBlock *bb)> getSuccessors,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+      std::function<void(Instruction *, DataFlowBitVectorResult *)>
+          computeKILL,
+      DataFlowMeetOperator meet,
+      bool isForward);
+
+  template <typename DataFlowResultType, typename SetType>
+  void applyForwardAnalysis(
+      Function *f,
+      DataFlowResultType *df,
+      std::function<void(Instruction *, DataFlowResultType *)> computeGEN,
+      std::function<void(Instruction *, DataFlowResultType *)> computeKILL,
+      std::function<void(Instruction *inst, SetType &IN)> initializeIN,
+      std::function<void(Instruction *inst, SetType &OUT)> initializeOUT,
       std::function<void(Instruction *inst,
                          Instruction *predecessor,
-                         std::set<Value *> &IN,
-                         DataFlowResult *df)> computeIN,
+                         SetType &IN,
+                         DataFlowResultType *df)> computeIN,
       std::function<void(Instruction *inst,
-                         std::set<Value *> &OUT,
-                         DataFlowResult *df)> computeOUT,
-      std::function<void(std::list<BasicBlock *> &workingList, BasicBlock *bb)>
-          appendBB,
-      std::function<Instruction *(BasicBlock *bb)> getFirstInstruction,
-      std::function<Instruction *(BasicBlock *bb)> getLastInstruction,
-      std::function<std::set<Value *> &(DataFlowResult *df,
-                                        Instruction *instruction)>
-          getInSetOfInst,
-      std::function<std::set<Value *> &(DataFlowResult *df,
-                                        Instruction *instruction)>
-          getOutSetOfInst,
-      std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
-      std::function<void(BasicBlock::iterator &)> incrementIterator);
+                         SetType &OUT,
+                         DataFlowResultType *df)> computeOUT);
+
+  template <typename DataFlowResultType, typename SetType>
+  void applyBackwardAnalysis(
+      Function *f,
+      DataFlowResultType *df,
+      std::function<void(Instruction *, DataFlowResultType *)> computeGEN,
+      std::function<void(Instruction *, DataFlowResultType *)> computeKILL,
+      std::function<void(Instruction *inst,
+                         SetType &IN,
+                         DataFlowResultType *df)> computeIN,
+      std::function<void(Instruction *inst,
+                         Instruction *successor,
+                         SetType &OUT,
+                         DataFlowResultType *df)> computeOUT);
 };
 
+template <class DataFlowResultType>
+std::vector<DataFlowResultType *> DataFlowEngine::applyToFunctions(
+    const std::vector<Function *> &functions,
+    std::function<DataFlowResultType *(DataFlowEngine &engine, Function *f)>
+        analysis) {
+  WorkStealingPool pool{};
+
+  return DataFlowEngine::applyToFunctions<DataFlowResultType>(functions,
+                                                              analysis,
+                                                              pool);
+}
+
+template <class DataFlowResultType>
+std::vector<DataFlowResultType *> DataFlowEngine::applyToFunctions(
+    const std::vector<Function *> &functions,
+    std::function<DataFlowResultType *(DataFlowEngine &engine, Function *f)>
+        analysis,
+    WorkStealingPool &pool) {
+
+  /*
+   * Allocate one engine per worker.
+   * Engines keep the statistics of their last analysis, so they cannot be
+   * shared between workers.
+   */
+  std::vector<DataFlowEngine> engines(pool.getNumberOfWorkers());
+
+  /*
+   * Solve the problem of each function.
+   * Every task writes only its own slot of the results.
+   */
+  std::vector<DataFlowResultType *> results(functions.size(), nullptr);
+  pool.run(functions.size(),
+           [&functions, &analysis, &engines, &results](uint64_t taskID,
+                                                       uint32_t workerID) {
+             auto f = functions[taskID];
+             auto &engine = engines[workerID];
+             results[taskID] = analysis(engine, f);
+           });
+
+  return results;
+}
+
 } // namespace arcana::noelle
 
 #endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWENGINE_H_
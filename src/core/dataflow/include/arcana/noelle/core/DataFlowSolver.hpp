@@ -0,0 +1,512 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DATAFLOWSOLVER_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWSOLVER_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DataFlowResult.hpp"
+#include "arcana/noelle/core/DataFlowBitVectorResult.hpp"
+#include "arcana/noelle/core/DataFlowWorkingList.hpp"
+#include "arcana/noelle/core/DataFlowStatistics.hpp"
+
+namespace arcana::noelle {
+
+enum class DataFlowDirection { Forward, Backward };
+
+enum class DataFlowMeetOperator { Union, Intersection };
+
+/*
+ * Fixed-point solver of data-flow problems.
+ *
+ * The direction of the problem and the type of its sets are template
+ * parameters, and so are the equations. Hence, the equations are invoked
+ * without any indirect call and can be inlined.
+ *
+ * The equations follow the direction of the problem. For a forward problem,
+ * computeMeet(inst, predecessor, IN, df) merges OUT[predecessor] into IN[inst]
+ * and computeTransfer(inst, OUT, df) computes OUT[inst]. For a backward
+ * problem, computeMeet(inst, successor, OUT, df) merges IN[successor] into
+ * OUT[inst] and computeTransfer(inst, IN, df) computes IN[inst].
+ */
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+class DataFlowSolver {
+public:
+  DataFlowSolver();
+
+  template <class ComputeGEN,
+            class ComputeKILL,
+            class InitializeIN,
+            class InitializeOUT,
+            class ComputeMeet,
+            class ComputeTransfer>
+  void solve(Function *f,
+             DataFlowResultType *df,
+             ComputeGEN &&computeGEN,
+             ComputeKILL &&computeKILL,
+             InitializeIN &&initializeIN,
+             InitializeOUT &&initializeOUT,
+             ComputeMeet &&computeMeet,
+             ComputeTransfer &&computeTransfer);
+
+  /*
+   * Solve a problem where the transfer function of an instruction is
+   * GEN U (IN - KILL) (GEN U (OUT - KILL) for backward problems) over the
+   * sets at the boundaries of basic blocks.
+   * The GEN and KILL sets of the basic blocks of @df must be already computed.
+   */
+  void solveWithBlockSummaries(Function *f,
+                               DataFlowBitVectorResult *df,
+                               DataFlowMeetOperator meet);
+
+  /*
+   * Solve the same kind of problem starting from the GEN and KILL sets of
+   * instructions.
+   * The sets of the basic blocks of @df are composed from the ones computed by
+   * @computeGEN and @computeKILL, and the sets of the instructions are derived
+   * from the solution before returning.
+   */
+  template <class ComputeGEN, class ComputeKILL>
+  void solveWithBlockSummaries(Function *f,
+                               DataFlowBitVectorResult *df,
+                               ComputeGEN &&computeGEN,
+                               ComputeKILL &&computeKILL,
+                               DataFlowMeetOperator meet);
+
+  const DataFlowStatistics &getStatistics(void) const;
+
+private:
+  DataFlowStatistics statistics;
+
+  static constexpr bool isForward(void);
+
+  static SetType &getMeetSet(DataFlowResultType *df, Instruction *inst);
+
+  static SetType &getTransferredSet(DataFlowResultType *df, Instruction *inst);
+
+  static Instruction *getFirstInstruction(BasicBlock *bb);
+
+  static Instruction *getLastInstruction(BasicBlock *bb);
+
+  template <class Visitor>
+  static void forEachPredecessor(BasicBlock *bb, Visitor &&visitor);
+
+  template <class Visitor>
+  static void forEachSuccessor(BasicBlock *bb, Visitor &&visitor);
+
+  static uint64_t getNumberOfElements(const std::set<Value *> &s);
+
+  static uint64_t getNumberOfElements(const BitVector &s);
+};
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+DataFlowSolver<direction, DataFlowResultType, SetType>::DataFlowSolver() {
+  return;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+template <class ComputeGEN,
+          class ComputeKILL,
+          class InitializeIN,
+          class InitializeOUT,
+          class ComputeMeet,
+          class ComputeTransfer>
+void DataFlowSolver<direction, DataFlowResultType, SetType>::solve(
+    Function *f,
+    DataFlowResultType *df,
+    ComputeGEN &&computeGEN,
+    ComputeKILL &&computeKILL,
+    InitializeIN &&initializeIN,
+    InitializeOUT &&initializeOUT,
+    ComputeMeet &&computeMeet,
+    ComputeTransfer &&computeTransfer) {
+  assert(f != nullptr);
+  assert(df != nullptr);
+
+  /*
+   * Reset the statistics of the previous problem.
+   */
+  this->statistics.reset();
+
+  /*
+   * Initialize IN and OUT sets.
+   */
+  for (auto &bb : *f) {
+    for (auto &i : bb) {
+      auto &INSet = df->IN(&i);
+      auto &OUTSet = df->OUT(&i);
+      initializeIN(&i, INSet);
+      initializeOUT(&i, OUTSet);
+    }
+  }
+
+  /*
+   * Compute the GENs and KILLs
+   */
+  for (auto &bb : *f) {
+    for (auto &i : bb) {
+      computeGEN(&i, df);
+      computeKILL(&i, df);
+    }
+  }
+
+  /*
+   * Create the working list by adding all basic blocks to it.
+   */
+  DataFlowWorkingList workingList(f, isForward());
+  workingList.pushAll();
+
+  /*
+   * Compute the INs and OUTs iteratively until the working list is empty.
+   */
+  std::vector<bool> computedOnce(f->size(), false);
+  while (!workingList.empty()) {
+
+    /*
+     * Fetch a basic block that needs to be processed.
+     */
+    auto bb = workingList.pop();
+    this->statistics.recordVisit(bb);
+
+    /*
+     * Fetch the first instruction of the basic block.
+     */
+    auto inst = getFirstInstruction(bb);
+
+    /*
+     * Fetch the sets of the first instruction.
+     */
+    auto &meetSetOfInst = getMeetSet(df, inst);
+    auto &transferredSetOfInst = getTransferredSet(df, inst);
+
+    /*
+     * Merge the sets coming from the predecessors of the basic block.
+     */
+    forEachPredecessor(bb, [&](BasicBlock *predecessorBB) {
+      auto predecessorInst = getLastInstruction(predecessorBB);
+      computeMeet(inst, predecessorInst, meetSetOfInst, df);
+    });
+
+    /*
+     * Apply the transfer function of the first instruction.
+     */
+    auto oldSize = getNumberOfElements(transferredSetOfInst);
+    computeTransfer(inst, transferredSetOfInst, df);
+
+    /*
+     * Check if the set of the first instruction of the current basic block
+     * changed.
+     */
+    auto bbPriority = workingList.getPriority(bb);
+    if (computedOnce[bbPriority]
+        && (getNumberOfElements(transferredSetOfInst) == oldSize)) {
+      continue;
+    }
+    computedOnce[bbPriority] = true;
+
+    /*
+     * Propagate the new set to the rest of the instructions of the current
+     * basic block.
+     */
+    auto predI = inst;
+    auto propagate = [&](Instruction *i) {
+      auto &meetSetOfI = getMeetSet(df, i);
+      computeMeet(i, predI, meetSetOfI, df);
+      auto &transferredSetOfI = getTransferredSet(df, i);
+      computeTransfer(i, transferredSetOfI, df);
+      predI = i;
+    };
+    if constexpr (isForward()) {
+      auto iter = std::next(BasicBlock::iterator(inst));
+      for (; iter != bb->end(); iter++) {
+        propagate(&*iter);
+      }
+    } else {
+      auto iter = BasicBlock::iterator(inst);
+      while (iter != bb->begin()) {
+        iter--;
+        propagate(&*iter);
+      }
+    }
+
+    /*
+     * Add successors of the current basic block to the working list.
+     */
+    forEachSuccessor(bb,
+                     [&workingList](BasicBlock *succBB) {
+                       workingList.push(succBB);
+                     });
+  }
+
+  return;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+void DataFlowSolver<direction, DataFlowResultType, SetType>::
+    solveWithBlockSummaries(Function *f,
+                            DataFlowBitVectorResult *df,
+                            DataFlowMeetOperator meet) {
+  assert(f != nullptr);
+  assert(df != nullptr);
+
+  /*
+   * Reset the statistics of the previous problem.
+   */
+  this->statistics.reset();
+
+  /*
+   * Define the customization.
+   *
+   * For a forward problem, the set at the entry of a basic block is the meet
+   * of the sets at the exit of its predecessors. For a backward one, the set
+   * at the exit of a basic block is the meet of the sets at the entry of its
+   * successors.
+   */
+  auto getMeetSetOfBB = [df](BasicBlock *bb) -> BitVector & {
+    if constexpr (isForward()) {
+      return df->IN(bb);
+    } else {
+      return df->OUT(bb);
+    }
+  };
+  auto getTransferredSetOfBB = [df](BasicBlock *bb) -> BitVector & {
+    if constexpr (isForward()) {
+      return df->OUT(bb);
+    } else {
+      return df->IN(bb);
+    }
+  };
+
+  /*
+   * Initialize the sets.
+   * The meet of an intersection starts from the set of all values.
+   */
+  if (meet == DataFlowMeetOperator::Intersection) {
+    for (auto &bb : *f) {
+      auto &transferredSet = getTransferredSetOfBB(&bb);
+      transferredSet.set();
+    }
+  }
+
+  /*
+   * Create the working list by adding all basic blocks to it.
+   */
+  DataFlowWorkingList workingList(f, isForward());
+  workingList.pushAll();
+
+  /*
+   * Compute the sets of the basic blocks iteratively until the working list is
+   * empty.
+   */
+  std::vector<bool> computedOnce(f->size(), false);
+  BitVector newSet;
+  while (!workingList.empty()) {
+
+    /*
+     * Fetch a basic block that needs to be processed.
+     */
+    auto bb = workingList.pop();
+    this->statistics.recordVisit(bb);
+
+    /*
+     * Apply the meet operator.
+     * Basic blocks at the boundary of the CFG start from the empty set.
+     */
+    auto &meetSet = getMeetSetOfBB(bb);
+    meetSet.reset();
+    auto isFirst = true;
+    forEachPredecessor(bb, [&](BasicBlock *predecessorBB) {
+      auto &predecessorSet = getTransferredSetOfBB(predecessorBB);
+      if (isFirst || (meet == DataFlowMeetOperator::Union)) {
+        meetSet |= predecessorSet;
+      } else {
+        meetSet &= predecessorSet;
+      }
+      isFirst = false;
+    });
+
+    /*
+     * Apply the transfer function of the basic block:
+     * GEN[bb] U (meetSet - KILL[bb])
+     */
+    newSet = meetSet;
+    newSet.reset(df->KILL(bb));
+    newSet |= df->GEN(bb);
+
+    /*
+     * Check if the set changed.
+     */
+    auto &transferredSet = getTransferredSetOfBB(bb);
+    auto bbPriority = workingList.getPriority(bb);
+    if (computedOnce[bbPriority] && (newSet == transferredSet)) {
+      continue;
+    }
+    computedOnce[bbPriority] = true;
+    transferredSet = newSet;
+
+    /*
+     * Add successors of the current basic block to the working list.
+     */
+    forEachSuccessor(bb,
+                     [&workingList](BasicBlock *succBB) {
+                       workingList.push(succBB);
+                     });
+  }
+
+  return;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+template <class ComputeGEN, class ComputeKILL>
+void DataFlowSolver<direction, DataFlowResultType, SetType>::
+    solveWithBlockSummaries(Function *f,
+                            DataFlowBitVectorResult *df,
+                            ComputeGEN &&computeGEN,
+                            ComputeKILL &&computeKILL,
+                            DataFlowMeetOperator meet) {
+  assert(f != nullptr);
+  assert(df != nullptr);
+
+  /*
+   * Compute GEN and KILL of the basic blocks.
+   */
+  df->initializeBlockSummaries(f, isForward());
+  for (auto &bb : *f) {
+    df->computeBlockGENAndKILL(&bb, computeGEN, computeKILL);
+  }
+
+  /*
+   * Solve the data-flow equations over the basic blocks.
+   */
+  this->solveWithBlockSummaries(f, df, meet);
+
+  /*
+   * Derive the sets of the instructions from the sets of their basic blocks.
+   * This is done now because @computeGEN and @computeKILL might refer to
+   * state of the caller that does not outlive this invocation.
+   */
+  for (auto &bb : *f) {
+    df->computeInstructionSetsOfBasicBlock(&bb, computeGEN, computeKILL);
+  }
+
+  return;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+const DataFlowStatistics &DataFlowSolver<direction,
+                                         DataFlowResultType,
+                                         SetType>::getStatistics(void) const {
+  return this->statistics;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+constexpr bool DataFlowSolver<direction, DataFlowResultType, SetType>::
+    isForward(void) {
+  return direction == DataFlowDirection::Forward;
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+SetType &DataFlowSolver<direction, DataFlowResultType, SetType>::getMeetSet(
+    DataFlowResultType *df,
+    Instruction *inst) {
+  if constexpr (isForward()) {
+    return df->IN(inst);
+  } else {
+    return df->OUT(inst);
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+SetType &DataFlowSolver<direction, DataFlowResultType, SetType>::
+    getTransferredSet(DataFlowResultType *df, Instruction *inst) {
+  if constexpr (isForward()) {
+    return df->OUT(inst);
+  } else {
+    return df->IN(inst);
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+Instruction *DataFlowSolver<direction, DataFlowResultType, SetType>::
+    getFirstInstruction(BasicBlock *bb) {
+  if constexpr (isForward()) {
+    return &*bb->begin();
+  } else {
+    return bb->getTerminator();
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+Instruction *DataFlowSolver<direction, DataFlowResultType, SetType>::
+    getLastInstruction(BasicBlock *bb) {
+  if constexpr (isForward()) {
+    return bb->getTerminator();
+  } else {
+    return &*bb->begin();
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+template <class Visitor>
+void DataFlowSolver<direction, DataFlowResultType, SetType>::
+    forEachPredecessor(BasicBlock *bb, Visitor &&visitor) {
+  if constexpr (isForward()) {
+    for (auto predecessorBB : predecessors(bb)) {
+      visitor(predecessorBB);
+    }
+  } else {
+    for (auto successorBB : successors(bb)) {
+      visitor(successorBB);
+    }
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+template <class Visitor>
+void DataFlowSolver<direction, DataFlowResultType, SetType>::forEachSuccessor(
+    BasicBlock *bb,
+    Visitor &&visitor) {
+  if constexpr (isForward()) {
+    for (auto successorBB : successors(bb)) {
+      visitor(successorBB);
+    }
+  } else {
+    for (auto predecessorBB : predecessors(bb)) {
+      visitor(predecessorBB);
+    }
+  }
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+uint64_t DataFlowSolver<direction, DataFlowResultType, SetType>::
+    getNumberOfElements(const std::set<Value *> &s) {
+  return s.size();
+}
+
+template <DataFlowDirection direction, class DataFlowResultType, class SetType>
+uint64_t DataFlowSolver<direction, DataFlowResultType, SetType>::
+    getNumberOfElements(const BitVector &s) {
+  return s.count();
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWSOLVER_H_
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKINGLIST_H_
+#define NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKINGLIST_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Working list of basic blocks used by the data-flow engine.
+ *
+ * Basic blocks are popped in reverse post-order for forward analyses and in
+ * post-order for backward ones. A basic block is in the list at most once.
+ */
+class DataFlowWorkingList {
+public:
+  /*
+   * Methods
+   */
+  DataFlowWorkingList(Function *f, bool isForward);
+
+  void push(BasicBlock *bb);
+
+  void pushAll(void);
+
+  BasicBlock *pop(void);
+
+  bool empty(void) const;
+
+  uint32_t getPriority(BasicBlock *bb) const;
+
+private:
+  std::vector<BasicBlock *> blocks;
+  std::unordered_map<BasicBlock *, uint32_t> priorities;
+  BitVector queued;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DATAFLOW_DATAFLOWWORKINGLIST_H_
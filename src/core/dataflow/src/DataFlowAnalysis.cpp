@@ -27,34 +27,32 @@ DataFlowAnalysis::DataFlowAnalysis() {
   return;
 }
 
-DataFlowResult *DataFlowAnalysis::getFullSets(Function *f) {
+DataFlowBitVectorResult *DataFlowAnalysis::getFullSets(Function *f) {
 
-  auto df = new DataFlowResult{};
+  /*
+   * Every instruction of @f belongs to the IN and OUT sets of every
+   * instruction of @f.
+   */
+  auto df = new DataFlowBitVectorResult(f);
+  auto numberOfInstructions = df->getNumberOfInstructions();
   for (auto &inst : instructions(*f)) {
     auto &inSetOfInst = df->IN(&inst);
     auto &outSetOfInst = df->OUT(&inst);
-    for (auto &inst2 : instructions(*f)) {
-      inSetOfInst.insert(&inst2);
-      outSetOfInst.insert(&inst2);
-    }
+    inSetOfInst.set(0, numberOfInstructions);
+    outSetOfInst.set(0, numberOfInstructions);
   }
 
   return df;
 }
 
-DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
+DataFlowBitVectorResult *DataFlowAnalysis::runReachableAnalysis(
     Function *f,
     std::function<bool(Instruction *i)> filter) {
 
-  /*
-   * Allocate the engine
-   */
-  auto dfa = DataFlowEngine{};
-
   /*
    * Define the data-flow equations
    */
-  auto computeGEN = [filter](Instruction *i, DataFlowResult *df) {
+  auto computeGEN = [&filter](Instruction *i, DataFlowBitVectorResult *df) {
     /*
      * Check if the instruction should be considered.
      */
@@ -66,44 +64,38 @@ DataFlowResult *DataFlowAnalysis::runReachableAnalysis(
      * Add the instruction to the GEN set.
      */
     auto &gen = df->GEN(i);
-    gen.insert(i);
+    auto id = df->getID(i);
+    gen.set(id);
 
     return;
   };
-  auto computeKILL = [](Instruction *, DataFlowResult *) { return; };
-  auto computeOUT = [](Instruction *inst,
-                       Instruction *succ,
-                       std::set<Value *> &OUT,
-                       DataFlowResult *df) {
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
-    return;
-  };
-  auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-
-        /*
-         * IN[i] = GEN[i] U OUT[i]
-         */
-        IN.insert(genI.begin(), genI.end());
-        IN.insert(outI.begin(), outI.end());
-
-        return;
-      };
+  auto computeKILL = [](Instruction *, DataFlowBitVectorResult *) { return; };
 
   /*
    * Run the data flow analysis needed to identify the instructions that could
    * be executed from a given point.
+   *
+   * The equations are IN[i] = GEN[i] U OUT[i] and OUT[i] = U IN[s] for every
+   * successor s of i. Hence, we can solve them at the granularity of basic
+   * blocks.
+   * The solver is used directly so the equations above are not wrapped in
+   * std::function.
    */
-  auto df =
-      dfa.applyBackward(f, computeGEN, computeKILL, computeIN, computeOUT);
+  auto df = new DataFlowBitVectorResult(f);
+  auto solver = DataFlowSolver<DataFlowDirection::Backward,
+                               DataFlowBitVectorResult,
+                               BitVector>{};
+  solver.solveWithBlockSummaries(f,
+                                 df,
+                                 computeGEN,
+                                 computeKILL,
+                                 DataFlowMeetOperator::Union);
 
   return df;
 }
 
-DataFlowResult *DataFlowAnalysis::runReachableAnalysis(Function *f) {
+DataFlowBitVectorResult *DataFlowAnalysis::runReachableAnalysis(
+    Function *f) {
 
   /*
    * Create the function that doesn't filter out instructions.
@@ -118,4 +110,39 @@ DataFlowResult *DataFlowAnalysis::runReachableAnalysis(Function *f) {
   return dfr;
 }
 
+std::vector<DataFlowBitVectorResult *> DataFlowAnalysis::runReachableAnalysis(
+    const std::vector<Function *> &functions,
+    std::function<bool(Instruction *i)> filter) {
+  WorkStealingPool pool{};
+
+  auto dfrs = this->runReachableAnalysis(functions, filter, pool);
+
+  return dfrs;
+}
+
+std::vector<DataFlowBitVectorResult *> DataFlowAnalysis::runReachableAnalysis(
+    const std::vector<Function *> &functions,
+    std::function<bool(Instruction *i)> filter,
+    WorkStealingPool &pool) {
+
+  /*
+   * Define the analysis to run on each function.
+   */
+  auto analysis = [this, &filter](DataFlowEngine &,
+                                  Function *f) -> DataFlowBitVectorResult * {
+    auto dfr = this->runReachableAnalysis(f, filter);
+    return dfr;
+  };
+
+  /*
+   * Run the analysis on all functions.
+   */
+  auto dfrs =
+      DataFlowEngine::applyToFunctions<DataFlowBitVectorResult>(functions,
+                                                                analysis,
+                                                                pool);
+
+  return dfrs;
+}
+
 } // namespace arcana::noelle
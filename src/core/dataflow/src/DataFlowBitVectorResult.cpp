@@ -0,0 +1,236 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DataFlowBitVectorResult.hpp"
+
+namespace arcana::noelle {
+
+DataFlowBitVectorResult::DataFlowBitVectorResult(Function *f)
+  : numberOfInstructions{ 0 },
+    isForward{ true } {
+  assert(f != nullptr);
+
+  /*
+   * Number the instructions.
+   * Instructions come first so their value IDs can index the flat arrays.
+   */
+  for (auto &inst : instructions(*f)) {
+    this->valueIDs[&inst] = this->values.size();
+    this->values.push_back(&inst);
+  }
+  this->numberOfInstructions = this->values.size();
+
+  /*
+   * Number the arguments.
+   */
+  for (auto &arg : f->args()) {
+    this->valueIDs[&arg] = this->values.size();
+    this->values.push_back(&arg);
+  }
+
+  /*
+   * Prepare the flat arrays.
+   * The sets of an instruction are allocated when they are first accessed.
+   */
+  this->gens.resize(this->numberOfInstructions);
+  this->kills.resize(this->numberOfInstructions);
+  this->ins.resize(this->numberOfInstructions);
+  this->outs.resize(this->numberOfInstructions);
+  this->areInstructionSetsAvailable.resize(this->numberOfInstructions, false);
+
+  return;
+}
+
+BitVector &DataFlowBitVectorResult::GEN(Instruction *inst) {
+  auto id = this->fetchInstructionSets(inst);
+  auto &s = this->gens[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::KILL(Instruction *inst) {
+  auto id = this->fetchInstructionSets(inst);
+  auto &s = this->kills[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::IN(Instruction *inst) {
+  auto id = this->fetchInstructionSets(inst);
+  auto &s = this->ins[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::OUT(Instruction *inst) {
+  auto id = this->fetchInstructionSets(inst);
+  auto &s = this->outs[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::GEN(BasicBlock *bb) {
+  auto id = this->getBasicBlockID(bb);
+  auto &s = this->blockGENs[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::KILL(BasicBlock *bb) {
+  auto id = this->getBasicBlockID(bb);
+  auto &s = this->blockKILLs[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::IN(BasicBlock *bb) {
+  auto id = this->getBasicBlockID(bb);
+  auto &s = this->blockINs[id];
+
+  return s;
+}
+
+BitVector &DataFlowBitVectorResult::OUT(BasicBlock *bb) {
+  auto id = this->getBasicBlockID(bb);
+  auto &s = this->blockOUTs[id];
+
+  return s;
+}
+
+bool DataFlowBitVectorResult::hasBlockSummaries(void) const {
+  return !this->basicBlockIDs.empty();
+}
+
+uint32_t DataFlowBitVectorResult::getID(Value *v) const {
+  assert(v != nullptr);
+  assert(this->valueIDs.find(v) != this->valueIDs.end()
+         && "The value does not belong to the function of the result");
+
+  auto id = this->valueIDs.at(v);
+
+  return id;
+}
+
+Value *DataFlowBitVectorResult::getValue(uint32_t id) const {
+  assert(id < this->values.size());
+
+  return this->values[id];
+}
+
+Instruction *DataFlowBitVectorResult::getInstruction(uint32_t id) const {
+  assert(id < this->numberOfInstructions);
+
+  auto inst = cast<Instruction>(this->values[id]);
+
+  return inst;
+}
+
+uint32_t DataFlowBitVectorResult::getNumberOfValues(void) const {
+  return this->values.size();
+}
+
+uint32_t DataFlowBitVectorResult::getNumberOfInstructions(void) const {
+  return this->numberOfInstructions;
+}
+
+std::set<Value *> DataFlowBitVectorResult::getValues(
+    const BitVector &s) const {
+  std::set<Value *> valuesInSet;
+
+  for (auto id : s.set_bits()) {
+    auto v = this->getValue(id);
+    valuesInSet.insert(v);
+  }
+
+  return valuesInSet;
+}
+
+bool DataFlowBitVectorResult::contains(const BitVector &s, Value *v) const {
+  auto id = this->getID(v);
+  if (id >= s.size()) {
+    return false;
+  }
+
+  return s.test(id);
+}
+
+uint32_t DataFlowBitVectorResult::fetchInstructionSets(Instruction *inst) {
+  auto id = this->getID(inst);
+  assert(id < this->numberOfInstructions);
+
+  /*
+   * Check if the sets of @inst are already available.
+   */
+  if (this->areInstructionSetsAvailable[id]) {
+    return id;
+  }
+
+  /*
+   * Allocate empty sets.
+   */
+  this->allocateInstructionSets(id);
+
+  return id;
+}
+
+uint32_t DataFlowBitVectorResult::getBasicBlockID(BasicBlock *bb) const {
+  assert(bb != nullptr);
+  assert(this->basicBlockIDs.find(bb) != this->basicBlockIDs.end()
+         && "The result does not have the summary of the basic block");
+
+  auto id = this->basicBlockIDs.at(bb);
+
+  return id;
+}
+
+void DataFlowBitVectorResult::allocateInstructionSets(uint32_t id) {
+  auto numberOfValues = this->values.size();
+
+  this->gens[id].resize(numberOfValues);
+  this->kills[id].resize(numberOfValues);
+  this->ins[id].resize(numberOfValues);
+  this->outs[id].resize(numberOfValues);
+  this->areInstructionSetsAvailable[id] = true;
+
+  return;
+}
+
+void DataFlowBitVectorResult::initializeBlockSummaries(Function *f,
+                                                       bool isForward) {
+  this->isForward = isForward;
+
+  /*
+   * Number the basic blocks and allocate their sets.
+   */
+  auto numberOfValues = this->values.size();
+  auto emptySet = BitVector(numberOfValues, false);
+  for (auto &bb : *f) {
+    this->basicBlockIDs[&bb] = this->blockGENs.size();
+    this->blockGENs.push_back(emptySet);
+    this->blockKILLs.push_back(emptySet);
+    this->blockINs.push_back(emptySet);
+    this->blockOUTs.push_back(emptySet);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -27,6 +27,14 @@ DataFlowEngine::DataFlowEngine() {
   return;
 }
 
+uint64_t DataFlowEngine::getNumberOfIterations(void) const {
+  return this->statistics.getNumberOfIterations();
+}
+
+uint64_t DataFlowEngine::getNumberOfVisits(BasicBlock *bb) const {
+  return this->statistics.getNumberOfVisits(bb);
+}
+
 DataFlowResult *DataFlowEngine::applyForward(
     Function *f,
     std::function<void(Instruction *, DataFlowResult *)> computeGEN,
@@ -76,73 +84,92 @@ DataFlowResult *DataFlowEngine::applyForward(
                        DataFlowResult *df)> computeOUT) {
 
   /*
-   * Define the customization.
+   * Allocate the result.
    */
-  auto appendBB = [](std::list<BasicBlock *> &workingList, BasicBlock *bb) {
-    workingList.push_back(bb);
-  };
-
-  auto getFirstInst = [](BasicBlock *bb) -> Instruction * {
-    return &*bb->begin();
-  };
-
-  auto getLastInst = [](BasicBlock *bb) -> Instruction * {
-    return bb->getTerminator();
-  };
-
-  auto getPredecessors = [](BasicBlock *bb) -> std::list<BasicBlock *> {
-    std::list<BasicBlock *> Predecessors;
-    for (auto predecessor : predecessors(bb)) {
-      Predecessors.push_back(predecessor);
-    }
-    return Predecessors;
-  };
+  auto df = new DataFlowResult{};
 
-  auto getSuccessors = [](BasicBlock *bb) -> std::list<BasicBlock *> {
-    std::list<BasicBlock *> Successors;
-    for (auto predecessor : successors(bb)) {
-      Successors.push_back(predecessor);
-    }
-    return Successors;
-  };
+  /*
+   * Run the data-flow analysis.
+   */
+  this->applyForwardAnalysis<DataFlowResult, std::set<Value *>>(f,
+                                                                df,
+                                                                computeGEN,
+                                                                computeKILL,
+                                                                initializeIN,
+                                                                initializeOUT,
+                                                                computeIN,
+                                                                computeOUT);
 
-  auto inSetOfInst = [](DataFlowResult *df,
-                        Instruction *inst) -> std::set<Value *> & {
-    return df->IN(inst);
-  };
+  return df;
+}
 
-  auto outSetOfInst = [](DataFlowResult *df,
-                         Instruction *inst) -> std::set<Value *> & {
-    return df->OUT(inst);
-  };
+DataFlowBitVectorResult *DataFlowEngine::applyForward(
+    Function *f,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeKILL,
+    std::function<void(Instruction *inst, BitVector &IN)> initializeIN,
+    std::function<void(Instruction *inst, BitVector &OUT)> initializeOUT,
+    std::function<void(Instruction *inst,
+                       Instruction *predecessor,
+                       BitVector &IN,
+                       DataFlowBitVectorResult *df)> computeIN,
+    std::function<void(Instruction *inst,
+                       BitVector &OUT,
+                       DataFlowBitVectorResult *df)> computeOUT) {
+
+  /*
+   * Allocate the result.
+   * This numbers the values of @f, which fixes the size of the bit vectors.
+   */
+  auto df = new DataFlowBitVectorResult(f);
+
+  /*
+   * Run the data-flow analysis.
+   */
+  this->applyForwardAnalysis<DataFlowBitVectorResult, BitVector>(f,
+                                                                 df,
+                                                                 computeGEN,
+                                                                 computeKILL,
+                                                                 initializeIN,
+                                                                 initializeOUT,
+                                                                 computeIN,
+                                                                 computeOUT);
 
-  auto getEndIterator = [](BasicBlock *bb) -> BasicBlock::iterator {
-    return bb->end();
-  };
+  return df;
+}
 
-  auto incrementIterator = [](BasicBlock::iterator &iter) { iter++; };
+template <typename DataFlowResultType, typename SetType>
+void DataFlowEngine::applyForwardAnalysis(
+    Function *f,
+    DataFlowResultType *df,
+    std::function<void(Instruction *, DataFlowResultType *)> computeGEN,
+    std::function<void(Instruction *, DataFlowResultType *)> computeKILL,
+    std::function<void(Instruction *inst, SetType &IN)> initializeIN,
+    std::function<void(Instruction *inst, SetType &OUT)> initializeOUT,
+    std::function<void(Instruction *inst,
+                       Instruction *predecessor,
+                       SetType &IN,
+                       DataFlowResultType *df)> computeIN,
+    std::function<void(Instruction *inst,
+                       SetType &OUT,
+                       DataFlowResultType *df)> computeOUT) {
 
   /*
-   * Run the pass.
+   * Solve the data-flow equations.
    */
+  DataFlowSolver<DataFlowDirection::Forward, DataFlowResultType, SetType>
+      solver{};
+  solver.solve(f,
+               df,
+               computeGEN,
+               computeKILL,
+               initializeIN,
+               initializeOUT,
+               computeIN,
+               computeOUT);
+  this->statistics = solver.getStatistics();
 
-  auto dfa = this->applyGeneralizedForwardAnalysis(f,
-                                                   computeGEN,
-                                                   computeKILL,
-                                                   initializeIN,
-                                                   initializeOUT,
-                                                   getPredecessors,
-                                                   getSuccessors,
-                                                   computeIN,
-                                                   computeOUT,
-                                                   appendBB,
-                                                   getFirstInst,
-                                                   getLastInst,
-                                                   inSetOfInst,
-                                                   outSetOfInst,
-                                                   getEndIterator,
-                                                   incrementIterator);
-  return dfa;
+  return;
 }
 
 DataFlowResult *DataFlowEngine::applyBackward(
@@ -183,257 +210,168 @@ DataFlowResult *DataFlowEngine::applyBackward(
                        DataFlowResult *df)> computeOUT) {
 
   /*
-   * Define the customization
+   * Allocate the result.
    */
-  auto appendBB = [](std::list<BasicBlock *> &workingList, BasicBlock *bb) {
-    workingList.push_front(bb);
-  };
-
-  auto getPredecessors = [](BasicBlock *bb) -> std::list<BasicBlock *> {
-    std::list<BasicBlock *> Successors;
-    for (auto predecessor : successors(bb)) {
-      Successors.push_back(predecessor);
-    }
-    return Successors;
-  };
+  auto df = new DataFlowResult{};
 
-  auto getSuccessors = [](BasicBlock *bb) -> std::list<BasicBlock *> {
-    std::list<BasicBlock *> Predecessors;
-    for (auto predecessor : predecessors(bb)) {
-      Predecessors.push_back(predecessor);
-    }
-    return Predecessors;
-  };
-
-  auto getFirstInst = [](BasicBlock *bb) -> Instruction * {
-    return bb->getTerminator();
-  };
-
-  auto getLastInst = [](BasicBlock *bb) -> Instruction * {
-    return &*bb->begin();
-  };
-
-  auto initializeIN = [](Instruction *inst, std::set<Value *> &IN) { return; };
-
-  auto initializeOUT = [](Instruction *inst, std::set<Value *> &OUT) {
-    return;
-  };
-
-  auto inSetOfInst = [](DataFlowResult *df,
-                        Instruction *inst) -> std::set<Value *> & {
-    return df->OUT(inst);
-  };
-
-  auto outSetOfInst = [](DataFlowResult *df,
-                         Instruction *inst) -> std::set<Value *> & {
-    return df->IN(inst);
-  };
-
-  auto getEndIterator = [](BasicBlock *bb) -> BasicBlock::iterator {
-    return bb->begin();
-  };
-
-  auto incrementIterator = [](BasicBlock::iterator &iter) { iter--; };
-
-  auto dfr = this->applyGeneralizedForwardAnalysis(f,
-                                                   computeGEN,
-                                                   computeKILL,
-                                                   initializeIN,
-                                                   initializeOUT,
-                                                   getPredecessors,
-                                                   getSuccessors,
-                                                   computeOUT,
-                                                   computeIN,
-                                                   appendBB,
-                                                   getFirstInst,
-                                                   getLastInst,
-                                                   inSetOfInst,
-                                                   outSetOfInst,
-                                                   getEndIterator,
-                                                   incrementIterator);
+  /*
+   * Run the data-flow analysis.
+   */
+  this->applyBackwardAnalysis<DataFlowResult, std::set<Value *>>(f,
+                                                                 df,
+                                                                 computeGEN,
+                                                                 computeKILL,
+                                                                 computeIN,
+                                                                 computeOUT);
 
-  return dfr;
+  return df;
 }
 
-void DataFlowEngine::computeGENAndKILL(
+DataFlowBitVectorResult *DataFlowEngine::applyBackward(
     Function *f,
-    std::function<void(Instruction *, DataFlowResult *)> computeGEN,
-    std::function<void(Instruction *, DataFlowResult *)> computeKILL,
-    DataFlowResult *df) {
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeKILL,
+    std::function<void(Instruction *inst,
+                       BitVector &IN,
+                       DataFlowBitVectorResult *df)> computeIN,
+    std::function<void(Instruction *inst,
+                       Instruction *successor,
+                       BitVector &OUT,
+                       DataFlowBitVectorResult *df)> computeOUT) {
 
   /*
-   * Compute the GENs and KILLs
+   * Allocate the result.
+   * This numbers the values of @f, which fixes the size of the bit vectors.
    */
-  for (auto &bb : *f) {
-    for (auto &i : bb) {
-      computeGEN(&i, df);
-      computeKILL(&i, df);
-    }
-  }
+  auto df = new DataFlowBitVectorResult(f);
 
-  return;
+  /*
+   * Run the data-flow analysis.
+   */
+  this->applyBackwardAnalysis<DataFlowBitVectorResult, BitVector>(f,
+                                                                  df,
+                                                                  computeGEN,
+                                                                  computeKILL,
+                                                                  computeIN,
+                                                                  computeOUT);
+
+  return df;
 }
 
-DataFlowResult *DataFlowEngine::applyGeneralizedForwardAnalysis(
+template <typename DataFlowResultType, typename SetType>
+void DataFlowEngine::applyBackwardAnalysis(
     Function *f,
-    std::function<void(Instruction *, DataFlowResult *)> computeGEN,
-    std::function<void(Instruction *, DataFlowResult *)> computeKILL,
-    std::function<void(Instruction *inst, std::set<Value *> &IN)> initializeIN,
-    std::function<void(Instruction *inst, std::set<Value *> &OUT)>
-        initializeOUT,
-    std::function<std::list<BasicBlock *>(BasicBlock *bb)> getPredecessors,
-    std::function<std::list<BasicBlock *>(BasicBlock *bb)> getSuccessors,
+    DataFlowResultType *df,
+    std::function<void(Instruction *, DataFlowResultType *)> computeGEN,
+    std::function<void(Instruction *, DataFlowResultType *)> computeKILL,
     std::function<void(Instruction *inst,
-                       Instruction *predecessor,
-                       std::set<Value *> &IN,
-                       DataFlowResult *df)> computeIN,
+                       SetType &IN,
+                       DataFlowResultType *df)> computeIN,
     std::function<void(Instruction *inst,
-                       std::set<Value *> &OUT,
-                       DataFlowResult *df)> computeOUT,
-    std::function<void(std::list<BasicBlock *> &workingList, BasicBlock *bb)>
-        appendBB,
-    std::function<Instruction *(BasicBlock *bb)> getFirstInstruction,
-    std::function<Instruction *(BasicBlock *bb)> getLastInstruction,
-    std::function<std::set<Value *> &(DataFlowResult *df,
-                                      Instruction *instruction)> getInSetOfInst,
-    std::function<std::set<Value *> &(DataFlowResult *df,
-                                      Instruction *instruction)>
-        getOutSetOfInst,
-    std::function<BasicBlock::iterator(BasicBlock *)> getEndIterator,
-    std::function<void(BasicBlock::iterator &)> incrementIterator) {
+                       Instruction *successor,
+                       SetType &OUT,
+                       DataFlowResultType *df)> computeOUT) {
 
   /*
-   * Initialize IN and OUT sets.
+   * The IN and OUT sets of a backward analysis start empty.
    */
-  auto df = new DataFlowResult{};
-  for (auto &bb : *f) {
-    for (auto &i : bb) {
-      auto &INSet = df->IN(&i);
-      auto &OUTSet = df->OUT(&i);
-      initializeIN(&i, INSet);
-      initializeOUT(&i, OUTSet);
-    }
-  }
+  auto initializeIN = [](Instruction *inst, SetType &IN) { return; };
+  auto initializeOUT = [](Instruction *inst, SetType &OUT) { return; };
 
   /*
-   * Compute the GENs and KILLs
+   * Solve the data-flow equations.
+   * The meet of a backward analysis computes OUT and its transfer function
+   * computes IN.
+   */
+  DataFlowSolver<DataFlowDirection::Backward, DataFlowResultType, SetType>
+      solver{};
+  solver.solve(f,
+               df,
+               computeGEN,
+               computeKILL,
+               initializeIN,
+               initializeOUT,
+               computeOUT,
+               computeIN);
+  this->statistics = solver.getStatistics();
+
+  return;
+}
+
+DataFlowBitVectorResult *DataFlowEngine::applyForwardWithBlockSummaries(
+    Function *f,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeKILL,
+    DataFlowMeetOperator meet) {
+  auto dfr =
+      this->applyBlockSummaryAnalysis(f, computeGEN, computeKILL, meet, true);
+
+  return dfr;
+}
+
+DataFlowBitVectorResult *DataFlowEngine::applyBackwardWithBlockSummaries(
+    Function *f,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeKILL,
+    DataFlowMeetOperator meet) {
+  auto dfr =
+      this->applyBlockSummaryAnalysis(f, computeGEN, computeKILL, meet, false);
+
+  return dfr;
+}
+
+DataFlowBitVectorResult *DataFlowEngine::applyBlockSummaryAnalysis(
+    Function *f,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowBitVectorResult *)> computeKILL,
+    DataFlowMeetOperator meet,
+    bool isForward) {
+
+  /*
+   * Allocate the result.
    */
-  computeGENAndKILL(f, computeGEN, computeKILL, df);
+  auto df = new DataFlowBitVectorResult(f);
 
   /*
-   * Compute the IN and OUT
-   *
-   * Create the working list by adding all basic blocks to it.
+   * Solve the data-flow equations over the basic blocks.
    */
-  std::list<BasicBlock *> workingList;
-  for (auto &bb : *f) {
-    appendBB(workingList, &bb);
+  if (isForward) {
+    DataFlowSolver<DataFlowDirection::Forward,
+                   DataFlowBitVectorResult,
+                   BitVector>
+        solver{};
+    solver.solveWithBlockSummaries(f, df, computeGEN, computeKILL, meet);
+    this->statistics = solver.getStatistics();
+
+  } else {
+    DataFlowSolver<DataFlowDirection::Backward,
+                   DataFlowBitVectorResult,
+                   BitVector>
+        solver{};
+    solver.solveWithBlockSummaries(f, df, computeGEN, computeKILL, meet);
+    this->statistics = solver.getStatistics();
   }
 
+  return df;
+}
+
+void DataFlowEngine::computeGENAndKILL(
+    Function *f,
+    std::function<void(Instruction *, DataFlowResult *)> computeGEN,
+    std::function<void(Instruction *, DataFlowResult *)> computeKILL,
+    DataFlowResult *df) {
+
   /*
-   * Compute the INs and OUTs iteratively until the working list is empty.
+   * Compute the GENs and KILLs
    */
-  std::unordered_set<BasicBlock *> computedOnce;
-
-  while (!workingList.empty()) {
-
-    /*
-     * Fetch a basic block that needs to be processed.
-     */
-    auto bb = workingList.front();
-
-    /*
-     * Remove the basic block from the workingList.
-     */
-    workingList.pop_front();
-
-    /*
-     * Fetch the first instruction of the basic block.
-     */
-    auto inst = getFirstInstruction(bb);
-
-    /*
-     * Fetch IN[inst], OUT[inst], GEN[inst], and KILL[inst]
-     */
-    auto &inSetOfInst = getInSetOfInst(df, inst);
-    auto &outSetOfInst = getOutSetOfInst(df, inst);
-
-    /*
-     * Compute the IN of the first instruction of the current basic block.
-     */
-    for (auto predecessorBB : getPredecessors(bb)) {
-
-      /*
-       * Fetch the current predecessor of "inst".
-       */
-      auto predecessorInst = getLastInstruction(predecessorBB);
-
-      /*
-       * Compute IN[inst]
-       */
-      computeIN(inst, predecessorInst, inSetOfInst, df);
-    }
-
-    /*
-     * Compute OUT[inst]
-     */
-    auto oldSizeOut = outSetOfInst.size();
-    computeOUT(inst, outSetOfInst, df);
-
-    /* Check if the OUT of the first instruction of the current basic block
-     * changed.
-     */
-    if ((computedOnce.find(bb) == computedOnce.end())
-        || (outSetOfInst.size() != oldSizeOut)) {
-
-      computedOnce.insert(bb);
-
-      /*
-       * Propagate the new OUT[inst] to the rest of the instructions of the
-       * current basic block.
-       */
-      BasicBlock::iterator iter(inst);
-      auto predI = cast<Instruction>(inst);
-      while (iter != getEndIterator(bb)) {
-
-        /*
-         * Move the iterator.
-         */
-        incrementIterator(iter);
-
-        /*
-         * Fetch the current instruction.
-         */
-        auto i = &*iter;
-
-        /*
-         * Compute IN[i]
-         */
-        auto &inSetOfI = getInSetOfInst(df, i);
-        computeIN(i, predI, inSetOfI, df);
-
-        /*
-         * Compute OUT[i]
-         */
-        auto &outSetOfI = getOutSetOfInst(df, i);
-        computeOUT(i, outSetOfI, df);
-
-        /*
-         * Update the predecessor.
-         */
-        predI = i;
-      }
-
-      /*
-       * Add successors of the current basic block to the working list.
-       */
-      for (auto succBB : getSuccessors(bb)) {
-        workingList.push_back(succBB);
-      }
+  for (auto &bb : *f) {
+    for (auto &i : bb) {
+      computeGEN(&i, df);
+      computeKILL(&i, df);
     }
   }
 
-  return df;
+  return;
 }
 
 } // namespace arcana::noelle
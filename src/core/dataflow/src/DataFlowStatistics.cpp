@@ -0,0 +1,57 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DataFlowStatistics.hpp"
+
+namespace arcana::noelle {
+
+DataFlowStatistics::DataFlowStatistics() : numberOfIterations{ 0 } {
+  return;
+}
+
+void DataFlowStatistics::recordVisit(BasicBlock *bb) {
+  this->numberOfIterations++;
+  this->numberOfVisits[bb]++;
+
+  return;
+}
+
+void DataFlowStatistics::reset(void) {
+  this->numberOfIterations = 0;
+  this->numberOfVisits.clear();
+
+  return;
+}
+
+uint64_t DataFlowStatistics::getNumberOfIterations(void) const {
+  return this->numberOfIterations;
+}
+
+uint64_t DataFlowStatistics::getNumberOfVisits(BasicBlock *bb) const {
+  auto it = this->numberOfVisits.find(bb);
+  if (it == this->numberOfVisits.end()) {
+    return 0;
+  }
+
+  return it->second;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/DataFlowWorkingList.hpp"
+
+namespace arcana::noelle {
+
+DataFlowWorkingList::DataFlowWorkingList(Function *f, bool isForward) {
+  assert(f != nullptr);
+
+  /*
+   * Order the basic blocks that are reachable from the entry in reverse
+   * post-order.
+   */
+  ReversePostOrderTraversal<Function *> rpot(f);
+  for (auto bb : rpot) {
+    this->blocks.push_back(bb);
+  }
+
+  /*
+   * Backward analyses process basic blocks in post-order.
+   */
+  if (!isForward) {
+    std::reverse(this->blocks.begin(), this->blocks.end());
+  }
+
+  /*
+   * Add the unreachable basic blocks at the end of the order.
+   */
+  std::unordered_set<BasicBlock *> reachableBBs(this->blocks.begin(),
+                                                this->blocks.end());
+  for (auto &bb : *f) {
+    if (reachableBBs.find(&bb) == reachableBBs.end()) {
+      this->blocks.push_back(&bb);
+    }
+  }
+
+  /*
+   * Assign the priorities.
+   */
+  for (auto i = 0u; i < this->blocks.size(); i++) {
+    auto bb = this->blocks[i];
+    this->priorities[bb] = i;
+  }
+  this->queued.resize(this->blocks.size());
+
+  return;
+}
+
+void DataFlowWorkingList::push(BasicBlock *bb) {
+  auto priority = this->getPriority(bb);
+  this->queued.set(priority);
+
+  return;
+}
+
+void DataFlowWorkingList::pushAll(void) {
+  this->queued.set();
+
+  return;
+}
+
+BasicBlock *DataFlowWorkingList::pop(void) {
+  assert(!this->empty());
+
+  /*
+   * Fetch the queued basic block with the highest priority.
+   */
+  auto priority = this->queued.find_first();
+  this->queued.reset(priority);
+  auto bb = this->blocks[priority];
+
+  return bb;
+}
+
+bool DataFlowWorkingList::empty(void) const {
+  return this->queued.none();
+}
+
+uint32_t DataFlowWorkingList::getPriority(BasicBlock *bb) const {
+  assert(this->priorities.find(bb) != this->priorities.end());
+
+  auto priority = this->priorities.at(bb);
+
+  return priority;
+}
+
+} // namespace arcana::noelle
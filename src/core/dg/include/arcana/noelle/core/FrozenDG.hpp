@@ -0,0 +1,275 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DG_FROZENDG_H_
+#define NOELLE_SRC_CORE_DG_FROZENDG_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/DGBase.hpp"
+#include "arcana/noelle/core/StronglyConnectedComponents.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Read-only snapshot of a DG<T> stored in contiguous arrays.
+ *
+ * Nodes are numbered from 0: internal nodes come first, then external ones.
+ * Edges are sorted by their source node, so the outgoing edges of a node are
+ * a contiguous slice of the edge array (CSR layout). Incoming edges are
+ * stored as a second CSR array of edge IDs.
+ *
+ * The snapshot does not track changes of the graph it has been built from;
+ * it must be rebuilt if that graph is modified.
+ */
+template <class T>
+class FrozenDG {
+public:
+  struct Edge {
+    uint32_t src;
+    uint32_t dst;
+    typename DGEdge<T, T>::DependenceKind kind;
+    bool isLoopCarried;
+    DGEdge<T, T> *edge;
+  };
+
+  FrozenDG(DG<T> &graph);
+
+  FrozenDG() = delete;
+
+  uint32_t getNumberOfNodes(void) const;
+
+  uint32_t getNumberOfInternalNodes(void) const;
+
+  uint64_t getNumberOfEdges(void) const;
+
+  bool isInGraph(T *theT) const;
+
+  bool isInternal(uint32_t nodeID) const;
+
+  uint32_t getNodeID(T *theT) const;
+
+  T *getT(uint32_t nodeID) const;
+
+  DGNode<T> *getNode(uint32_t nodeID) const;
+
+  const Edge &getEdge(uint64_t edgeID) const;
+
+  ArrayRef<Edge> getEdges(void) const;
+
+  /*
+   * Return the outgoing edges of @nodeID.
+   */
+  ArrayRef<Edge> getOutgoingEdges(uint32_t nodeID) const;
+
+  /*
+   * Return the IDs of the incoming edges of @nodeID.
+   */
+  ArrayRef<uint64_t> getIncomingEdgeIDs(uint32_t nodeID) const;
+
+  uint64_t outDegree(uint32_t nodeID) const;
+
+  uint64_t inDegree(uint32_t nodeID) const;
+
+  /*
+   * Compute the strongly connected components of the graph with an iterative
+   * version of Tarjan's algorithm.
+   *
+   * @sccOfNode is set to have, for each node ID, the ID of its SCC.
+   * SCC IDs are assigned in reverse topological order of the SCCs (i.e., an
+   * SCC only depends on SCCs with smaller IDs).
+   * The number of SCCs is returned.
+   */
+  uint32_t computeSCCs(std::vector<uint32_t> &sccOfNode) const;
+
+private:
+  uint32_t numberOfInternalNodes;
+  std::vector<DGNode<T> *> nodes;
+  DenseMap<T *, uint32_t> nodeIDs;
+  std::vector<Edge> edges;
+  std::vector<uint64_t> outgoingOffsets;
+  std::vector<uint64_t> incomingOffsets;
+  std::vector<uint64_t> incomingEdgeIDs;
+};
+
+template <class T>
+FrozenDG<T>::FrozenDG(DG<T> &graph) : numberOfInternalNodes{ 0 } {
+
+  /*
+   * Number the nodes.
+   */
+  this->nodes.reserve(graph.numNodes());
+  for (auto nodePair : graph.internalNodePairs()) {
+    this->nodeIDs[nodePair.first] = this->nodes.size();
+    this->nodes.push_back(nodePair.second);
+  }
+  this->numberOfInternalNodes = this->nodes.size();
+  for (auto nodePair : graph.externalNodePairs()) {
+    this->nodeIDs[nodePair.first] = this->nodes.size();
+    this->nodes.push_back(nodePair.second);
+  }
+  auto numberOfNodes = this->nodes.size();
+
+  /*
+   * Store the edges sorted by their source node.
+   */
+  this->edges.reserve(graph.numEdges());
+  this->outgoingOffsets.resize(numberOfNodes + 1, 0);
+  this->incomingOffsets.resize(numberOfNodes + 1, 0);
+  for (uint32_t srcID = 0; srcID < numberOfNodes; srcID++) {
+    this->outgoingOffsets[srcID] = this->edges.size();
+    for (auto edge : this->nodes[srcID]->getOutgoingEdges()) {
+      auto dstID = this->getNodeID(edge->getDst());
+      this->edges.push_back({ srcID,
+                              dstID,
+                              edge->getKind(),
+                              edge->isLoopCarriedDependence(),
+                              edge });
+      this->incomingOffsets[dstID + 1]++;
+    }
+  }
+  this->outgoingOffsets[numberOfNodes] = this->edges.size();
+
+  /*
+   * Store the incoming edges.
+   */
+  for (uint32_t nodeID = 0; nodeID < numberOfNodes; nodeID++) {
+    this->incomingOffsets[nodeID + 1] += this->incomingOffsets[nodeID];
+  }
+  this->incomingEdgeIDs.resize(this->edges.size());
+  std::vector<uint64_t> nextIncomingSlot(this->incomingOffsets.begin(),
+                                         this->incomingOffsets.end() - 1);
+  for (uint64_t edgeID = 0; edgeID < this->edges.size(); edgeID++) {
+    auto dstID = this->edges[edgeID].dst;
+    this->incomingEdgeIDs[nextIncomingSlot[dstID]++] = edgeID;
+  }
+
+  return;
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNumberOfNodes(void) const {
+  return this->nodes.size();
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNumberOfInternalNodes(void) const {
+  return this->numberOfInternalNodes;
+}
+
+template <class T>
+uint64_t FrozenDG<T>::getNumberOfEdges(void) const {
+  return this->edges.size();
+}
+
+template <class T>
+bool FrozenDG<T>::isInGraph(T *theT) const {
+  return this->nodeIDs.find(theT) != this->nodeIDs.end();
+}
+
+template <class T>
+bool FrozenDG<T>::isInternal(uint32_t nodeID) const {
+  return nodeID < this->numberOfInternalNodes;
+}
+
+template <class T>
+uint32_t FrozenDG<T>::getNodeID(T *theT) const {
+  auto it = this->nodeIDs.find(theT);
+  assert(it != this->nodeIDs.end());
+
+  return it->second;
+}
+
+template <class T>
+T *FrozenDG<T>::getT(uint32_t nodeID) const {
+  return this->nodes[nodeID]->getT();
+}
+
+template <class T>
+DGNode<T> *FrozenDG<T>::getNode(uint32_t nodeID) const {
+  return this->nodes[nodeID];
+}
+
+template <class T>
+const typename FrozenDG<T>::Edge &FrozenDG<T>::getEdge(uint64_t edgeID) const {
+  return this->edges[edgeID];
+}
+
+template <class T>
+ArrayRef<typename FrozenDG<T>::Edge> FrozenDG<T>::getEdges(void) const {
+  return ArrayRef<Edge>(this->edges);
+}
+
+template <class T>
+ArrayRef<typename FrozenDG<T>::Edge> FrozenDG<T>::getOutgoingEdges(
+    uint32_t nodeID) const {
+  auto begin = this->outgoingOffsets[nodeID];
+  auto end = this->outgoingOffsets[nodeID + 1];
+
+  return ArrayRef<Edge>(this->edges).slice(begin, end - begin);
+}
+
+template <class T>
+ArrayRef<uint64_t> FrozenDG<T>::getIncomingEdgeIDs(uint32_t nodeID) const {
+  auto begin = this->incomingOffsets[nodeID];
+  auto end = this->incomingOffsets[nodeID + 1];
+
+  return ArrayRef<uint64_t>(this->incomingEdgeIDs).slice(begin, end - begin);
+}
+
+template <class T>
+uint64_t FrozenDG<T>::outDegree(uint32_t nodeID) const {
+  return this->outgoingOffsets[nodeID + 1] - this->outgoingOffsets[nodeID];
+}
+
+template <class T>
+uint64_t FrozenDG<T>::inDegree(uint32_t nodeID) const {
+  return this->incomingOffsets[nodeID + 1] - this->incomingOffsets[nodeID];
+}
+
+template <class T>
+uint32_t FrozenDG<T>::computeSCCs(std::vector<uint32_t> &sccOfNode) const {
+  auto numberOfNodes = this->getNumberOfNodes();
+  sccOfNode.assign(numberOfNodes, UINT32_MAX);
+
+  /*
+   * Components are found in reverse topological order, so they are numbered
+   * following that order.
+   */
+  auto successorsOf = [this](uint32_t nodeID) {
+    return map_range(this->getOutgoingEdges(nodeID),
+                     [](const Edge &edge) { return edge.dst; });
+  };
+  uint32_t numberOfSCCs = 0;
+  forEachSCC<uint32_t>(seq<uint32_t>(0, numberOfNodes),
+                       successorsOf,
+                       [&](ArrayRef<uint32_t> scc) {
+                         for (auto nodeID : scc) {
+                           sccOfNode[nodeID] = numberOfSCCs;
+                         }
+                         numberOfSCCs++;
+                       });
+
+  return numberOfSCCs;
+}
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DG_FROZENDG_H_
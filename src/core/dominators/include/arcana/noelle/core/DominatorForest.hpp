@@ -24,6 +24,7 @@
 #define NOELLE_SRC_CORE_DOMINATORS_DOMINATORFOREST_H_
 
 #include "arcana/noelle/core/DominatorNode.hpp"
+#include "arcana/noelle/core/InstructionOrdinals.hpp"
 
 namespace arcana::noelle {
 
@@ -68,6 +69,7 @@ private:
   std::set<DominatorNode *> nodes;
   std::unordered_map<BasicBlock *, DominatorNode *> bbNodeMap;
   bool post;
+  InstructionOrdinals *ordinals;
 
   DominatorForest(std::set<DTAliases::Node *> nodes);
   DominatorForest(std::set<DominatorNode *> nodesSubset);
@@ -78,6 +80,9 @@ private:
   template <typename NodeType>
   void cloneNodes(std::set<NodeType *> &nodes);
   void addDescendants(DominatorNode *n, std::set<BasicBlock *> &ds) const;
+  void computeDFSNumbers(void);
+
+  friend class DominatorSummary;
 };
 
 } // namespace arcana::noelle
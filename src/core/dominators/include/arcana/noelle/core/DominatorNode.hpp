@@ -41,6 +41,14 @@ public:
   std::vector<DominatorNode *> getChildren(void) const;
   uint32_t getLevel(void) const;
 
+  /*
+   * Numbers assigned by a depth-first visit of the tree the node belongs to.
+   * A node dominates another one if and only if the interval of the latter
+   * is nested within the interval of the former.
+   */
+  uint32_t getDFSNumberIn(void) const;
+  uint32_t getDFSNumberOut(void) const;
+
   raw_ostream &print(raw_ostream &stream, std::string prefixToUse = "");
 
   friend class DominatorForest;
@@ -48,6 +56,8 @@ public:
 private:
   BasicBlock *B;
   uint32_t level;
+  uint32_t dfsNumberIn;
+  uint32_t dfsNumberOut;
 
   DominatorNode *parent;
   std::vector<DominatorNode *> children;
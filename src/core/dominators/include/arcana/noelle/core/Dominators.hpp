@@ -24,6 +24,7 @@
 
 #include "arcana/noelle/core/DominatorNode.hpp"
 #include "arcana/noelle/core/DominatorForest.hpp"
+#include "arcana/noelle/core/InstructionOrdinals.hpp"
 
 namespace arcana::noelle {
 
@@ -33,6 +34,23 @@ public:
   DominatorSummary(DominatorSummary &DS, std::set<BasicBlock *> &bbSubset);
 
   DominatorForest DT, PDT;
+
+  /*
+   * Forget the positions of instructions within their basic blocks.
+   * This must be invoked after instructions are moved or inserted in basic
+   * blocks of the summary.
+   */
+  void invalidateInstructionOrdinals(void);
+  void invalidateInstructionOrdinals(BasicBlock *bb);
+
+private:
+  /*
+   * Positions of instructions, shared by DT and PDT to answer intra-block
+   * dominance queries.
+   */
+  InstructionOrdinals ordinals;
+
+  void shareInstructionOrdinals(void);
 };
 
 } // namespace arcana::noelle
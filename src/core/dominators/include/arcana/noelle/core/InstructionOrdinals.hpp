@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_DOMINATORS_INSTRUCTIONORDINALS_H_
+#define NOELLE_SRC_CORE_DOMINATORS_INSTRUCTIONORDINALS_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Positions of instructions within their basic blocks.
+ *
+ * The instructions of a basic block are numbered the first time one of them
+ * is queried. Numbers are kept until they are invalidated: invalidating all
+ * basic blocks only bumps an epoch, and basic blocks numbered in an older
+ * epoch are renumbered lazily.
+ *
+ * Before an ordinal is returned, it is checked against the ordinals of the
+ * previous and next instructions; a mismatch (e.g., an instruction has been
+ * added, removed, or moved next to the queried one) triggers the renumbering
+ * of the basic block. This check only looks at the neighbors of the queried
+ * instruction, so code that reorders whole ranges of instructions must still
+ * invalidate the cache.
+ */
+class InstructionOrdinals {
+public:
+  InstructionOrdinals();
+
+  /*
+   * Return the position of @inst within its basic block.
+   */
+  uint32_t getOrdinal(Instruction *inst);
+
+  /*
+   * Return true if @I is before @J or if they are the same instruction.
+   * @I and @J must belong to the same basic block.
+   */
+  bool isBeforeOrEqual(Instruction *I, Instruction *J);
+
+  void invalidate(void);
+
+  void invalidate(BasicBlock *bb);
+
+private:
+  uint64_t epoch;
+  DenseMap<BasicBlock *, uint64_t> blockEpochs;
+  DenseMap<Instruction *, std::pair<BasicBlock *, uint32_t>> ordinals;
+
+  void numberInstructionsOf(BasicBlock *bb);
+
+  bool isConsistentWithNeighbors(Instruction *inst, uint32_t ordinal) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_DOMINATORS_INSTRUCTIONORDINALS_H_
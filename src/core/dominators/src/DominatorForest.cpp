@@ -37,21 +37,28 @@ DominatorForest::DominatorForest(llvm::PostDominatorTree &PDT)
 
 DominatorForest::DominatorForest(std::set<DTAliases::Node *> nodeSubset)
   : nodes{},
-    bbNodeMap{} {
+    bbNodeMap{},
+    post{ false },
+    ordinals{ nullptr } {
   this->cloneNodes<DTAliases::Node>(nodeSubset);
+  this->computeDFSNumbers();
   return;
 }
 
 DominatorForest::DominatorForest(DominatorForest &DTS,
                                  std::set<BasicBlock *> &bbSubset)
   : DominatorForest{ filterNodes(DTS.nodes, bbSubset) } {
+  this->post = DTS.post;
   return;
 }
 
 DominatorForest::DominatorForest(std::set<DominatorNode *> nodeSubset)
   : nodes{},
-    bbNodeMap{} {
+    bbNodeMap{},
+    post{ false },
+    ordinals{ nullptr } {
   this->cloneNodes<DominatorNode>(nodeSubset);
+  this->computeDFSNumbers();
   return;
 }
 
@@ -155,56 +162,31 @@ bool DominatorForest::dominates(Instruction *I, Instruction *J) const {
   if (B1 == B2) {
 
     /*
-     * Define the first and second instruction.
+     * Check whether I comes before J (or I is J).
      */
-    auto firstOne = I;
-    auto secondOne = J;
-
-    /*
-     * Check the dominance relation between I and J
-     */
-    while (firstOne != nullptr) {
-      if (firstOne == secondOne) {
-
-        /*
-         * The secondOne instruction is found after the first one.
-         * Hence, I dominates J.
-         * Also, J postdominates I.
-         */
-        if (this->post) {
-
-          /*
-           * I does not post-dominate J.
-           */
-          return false;
+    bool isIBeforeJ;
+    if (this->ordinals != nullptr) {
+      isIBeforeJ = this->ordinals->isBeforeOrEqual(I, J);
+    } else {
+      isIBeforeJ = false;
+      for (auto inst = I; inst != nullptr; inst = inst->getNextNode()) {
+        if (inst == J) {
+          isIBeforeJ = true;
+          break;
         }
-
-        /*
-         * I dominates J
-         */
-        return true;
       }
-
-      firstOne = firstOne->getNextNode();
     }
 
     /*
-     * The secondOne instruction has not been found after the first one.
-     * Hence, J dominates I.
-     * Also, I post-dominates J.
+     * If I comes before J, then I dominates J but I does not post-dominate
+     * J.
+     * Otherwise, J dominates I and I post-dominates J.
      */
     if (this->post) {
-
-      /*
-       * I post-dominates J.
-       */
-      return true;
+      return !isIBeforeJ;
     }
 
-    /*
-     * I does not dominates J.
-     */
-    return false;
+    return isIBeforeJ;
   }
 
   /*
@@ -244,20 +226,44 @@ bool DominatorForest::strictlyDominates(BasicBlock *B1, BasicBlock *B2) const {
 
 bool DominatorForest::dominates(DominatorNode *node1,
                                 DominatorNode *node2) const {
-  std::queue<DominatorNode *> worklist;
-  worklist.push(node1);
-  while (!worklist.empty()) {
-    auto node = worklist.front();
-    worklist.pop();
-
-    if (node == node2) {
-      return true;
+
+  /*
+   * node1 dominates node2 if and only if node2 is in the sub-tree rooted at
+   * node1.
+   */
+  return (node1->dfsNumberIn <= node2->dfsNumberIn)
+         && (node2->dfsNumberOut <= node1->dfsNumberOut);
+}
+
+void DominatorForest::computeDFSNumbers(void) {
+
+  /*
+   * Visit every tree of the forest starting from its root.
+   */
+  uint32_t dfsNumber = 0;
+  std::vector<std::pair<DominatorNode *, uint32_t>> stack;
+  for (auto root : this->nodes) {
+    if (root->parent != nullptr) {
+      continue;
+    }
+    root->dfsNumberIn = dfsNumber++;
+    stack.push_back({ root, 0 });
+    while (!stack.empty()) {
+      auto node = stack.back().first;
+      auto nextChild = stack.back().second;
+      if (nextChild < node->children.size()) {
+        stack.back().second++;
+        auto child = node->children[nextChild];
+        child->dfsNumberIn = dfsNumber++;
+        stack.push_back({ child, 0 });
+        continue;
+      }
+      node->dfsNumberOut = dfsNumber++;
+      stack.pop_back();
     }
-    for (auto child : node->children)
-      worklist.push(child);
   }
 
-  return false;
+  return;
 }
 
 std::set<DominatorNode *> DominatorForest::dominates(
@@ -387,19 +393,11 @@ DominatorNode *DominatorForest::findNearestCommonDominator(
     DominatorNode *node1,
     DominatorNode *node2) const {
 
-  /*
-   * Helpers to determine whether a node n dominates node2
-   */
-  auto dominatorsOf2 = this->dominates(node2);
-  auto dominates2 = [&](DominatorNode *node) -> bool {
-    return dominatorsOf2.find(node) != dominatorsOf2.end();
-  };
-
   /*
    * Traversal of parents of node1 to find common dominator
    */
   DominatorNode *node = node1;
-  while (node && !dominates2(node))
+  while (node && !this->dominates(node, node2))
     node = node->parent;
   return node;
 }
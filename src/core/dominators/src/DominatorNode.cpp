@@ -26,6 +26,8 @@ namespace arcana::noelle {
 DominatorNode::DominatorNode(const DTAliases::Node &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
+    dfsNumberIn{ 0 },
+    dfsNumberOut{ 0 },
     parent{ nullptr },
     children{} {
 
@@ -35,6 +37,8 @@ DominatorNode::DominatorNode(const DTAliases::Node &node)
 DominatorNode::DominatorNode(const DominatorNode &node)
   : B{ node.getBlock() },
     level{ node.getLevel() },
+    dfsNumberIn{ 0 },
+    dfsNumberOut{ 0 },
     parent{ nullptr },
     children{} {
 
@@ -80,4 +84,12 @@ uint32_t DominatorNode::getLevel(void) const {
   return level;
 }
 
+uint32_t DominatorNode::getDFSNumberIn(void) const {
+  return dfsNumberIn;
+}
+
+uint32_t DominatorNode::getDFSNumberOut(void) const {
+  return dfsNumberOut;
+}
+
 } // namespace arcana::noelle
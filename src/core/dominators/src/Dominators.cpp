@@ -26,12 +26,35 @@ namespace arcana::noelle {
 DominatorSummary::DominatorSummary(DominatorTree &dt, PostDominatorTree &pdt)
   : DT{ dt },
     PDT{ pdt } {
+  this->shareInstructionOrdinals();
   return;
 }
 
 DominatorSummary::DominatorSummary(DominatorSummary &ds,
                                    std::set<BasicBlock *> &bbSubset)
   : DT{ ds.DT, bbSubset },
-    PDT{ ds.PDT, bbSubset } {}
+    PDT{ ds.PDT, bbSubset } {
+  this->shareInstructionOrdinals();
+  return;
+}
+
+void DominatorSummary::shareInstructionOrdinals(void) {
+  this->DT.ordinals = &this->ordinals;
+  this->PDT.ordinals = &this->ordinals;
+
+  return;
+}
+
+void DominatorSummary::invalidateInstructionOrdinals(void) {
+  this->ordinals.invalidate();
+
+  return;
+}
+
+void DominatorSummary::invalidateInstructionOrdinals(BasicBlock *bb) {
+  this->ordinals.invalidate(bb);
+
+  return;
+}
 
 } // namespace arcana::noelle
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/InstructionOrdinals.hpp"
+
+namespace arcana::noelle {
+
+InstructionOrdinals::InstructionOrdinals() : epoch{ 1 } {
+  return;
+}
+
+uint32_t InstructionOrdinals::getOrdinal(Instruction *inst) {
+  assert(inst != nullptr);
+
+  /*
+   * Check if the basic block of @inst has been numbered in the current epoch.
+   */
+  auto bb = inst->getParent();
+  auto blockEpochIt = this->blockEpochs.find(bb);
+  if ((blockEpochIt == this->blockEpochs.end())
+      || (blockEpochIt->second != this->epoch)) {
+    this->numberInstructionsOf(bb);
+  }
+
+  /*
+   * Fetch the ordinal.
+   * An instruction added to a numbered basic block is either not known yet or
+   * known as part of another basic block. An instruction moved within its
+   * basic block, or next to an instruction that has been added or removed,
+   * has a neighbor whose ordinal does not match its own. In all these cases,
+   * the basic block is renumbered.
+   */
+  auto ordinalIt = this->ordinals.find(inst);
+  if ((ordinalIt == this->ordinals.end()) || (ordinalIt->second.first != bb)
+      || (!this->isConsistentWithNeighbors(inst, ordinalIt->second.second))) {
+    this->numberInstructionsOf(bb);
+    ordinalIt = this->ordinals.find(inst);
+  }
+  assert(ordinalIt != this->ordinals.end());
+
+  return ordinalIt->second.second;
+}
+
+bool InstructionOrdinals::isBeforeOrEqual(Instruction *I, Instruction *J) {
+  assert(I->getParent() == J->getParent());
+
+  auto ordinalI = this->getOrdinal(I);
+  auto ordinalJ = this->getOrdinal(J);
+
+  return ordinalI <= ordinalJ;
+}
+
+void InstructionOrdinals::invalidate(void) {
+  this->epoch++;
+
+  return;
+}
+
+void InstructionOrdinals::invalidate(BasicBlock *bb) {
+  this->blockEpochs.erase(bb);
+
+  return;
+}
+
+bool InstructionOrdinals::isConsistentWithNeighbors(Instruction *inst,
+                                                    uint32_t ordinal) const {
+  auto bb = inst->getParent();
+
+  /*
+   * Check the previous instruction.
+   */
+  auto prev = inst->getPrevNode();
+  if (prev == nullptr) {
+    if (ordinal != 0) {
+      return false;
+    }
+  } else {
+    auto prevIt = this->ordinals.find(prev);
+    if ((prevIt == this->ordinals.end()) || (prevIt->second.first != bb)
+        || ((prevIt->second.second + 1) != ordinal)) {
+      return false;
+    }
+  }
+
+  /*
+   * Check the next instruction.
+   */
+  auto next = inst->getNextNode();
+  if (next != nullptr) {
+    auto nextIt = this->ordinals.find(next);
+    if ((nextIt == this->ordinals.end()) || (nextIt->second.first != bb)
+        || (nextIt->second.second != (ordinal + 1))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void InstructionOrdinals::numberInstructionsOf(BasicBlock *bb) {
+  uint32_t ordinal = 0;
+  for (auto &inst : *bb) {
+    this->ordinals[&inst] = { bb, ordinal };
+    ordinal++;
+  }
+  this->blockEpochs[bb] = this->epoch;
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -26,6 +26,7 @@
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "arcana/noelle/core/Hot.hpp"
 #include "arcana/noelle/core/CallGraph.hpp"
+#include "arcana/noelle/core/FrozenCallGraph.hpp"
 #include "arcana/noelle/core/SCCCAG.hpp"
 
 namespace arcana::noelle {
@@ -34,6 +35,8 @@ class FunctionsManager {
 public:
   FunctionsManager(Module &m, PDGGenerator &noellePDGGenerator, Hot *profiles);
 
+  ~FunctionsManager();
+
   Function *getEntryFunction(void) const;
 
   std::set<Function *> getProgramConstructors(void) const;
@@ -57,15 +60,33 @@ public:
 
   std::set<Function *> getFunctionsReachableFrom(Function *startingPoint);
 
+  /*
+   * Compute the functions reachable from each starting point.
+   * Starting points are visited in parallel.
+   */
+  std::unordered_map<Function *, std::set<Function *>>
+  getFunctionsReachableFrom(const std::vector<Function *> &startingPoints);
+
   void sortByHotness(std::vector<Function *> &functions);
 
   void removeFunction(Function &f);
 
+  /*
+   * Drop the program call graph and its snapshot; both are computed again
+   * the next time they are requested.
+   * This must be invoked after the calls of the program change (e.g., after
+   * inlining).
+   */
+  void invalidateProgramCallGraphSnapshot(void);
+
 private:
   Module &program;
   PDGGenerator &pdgAnalysis;
   CallGraph *pcg;
+  FrozenCallGraph *frozenPCG;
   Hot *prof;
+
+  FrozenCallGraph *getFrozenProgramCallGraph(void);
 };
 
 } // namespace arcana::noelle
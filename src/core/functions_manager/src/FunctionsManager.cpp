@@ -29,10 +29,15 @@ FunctionsManager::FunctionsManager(Module &m,
   : program{ m },
     pdgAnalysis{ noellePDGGenerator },
     pcg{ nullptr },
+    frozenPCG{ nullptr },
     prof{ profiles } {
   return;
 }
 
+FunctionsManager::~FunctionsManager() {
+  delete this->frozenPCG;
+}
+
 Function *FunctionsManager::getEntryFunction(void) const {
   auto f = this->program.getFunction("main");
   return f;
@@ -46,6 +51,15 @@ CallGraph *FunctionsManager::getProgramCallGraph(void) {
   return this->pcg;
 }
 
+FrozenCallGraph *FunctionsManager::getFrozenProgramCallGraph(void) {
+  if (this->frozenPCG == nullptr) {
+    auto cg = this->getProgramCallGraph();
+    this->frozenPCG = new FrozenCallGraph(this->program, *cg);
+  }
+
+  return this->frozenPCG;
+}
+
 SCCCAG *FunctionsManager::getSCCDAGOfProgramCallGraph(void) {
   auto cg = this->getProgramCallGraph();
   auto sccdag = new SCCCAG(cg);
@@ -200,50 +214,55 @@ std::set<Function *> FunctionsManager::getFunctionsWithBody(void) const {
 
 std::set<Function *> FunctionsManager::getFunctionsReachableFrom(
     Function *startingPoint) {
-  std::set<Function *> functions;
 
   /*
-   * Fetch the call graph.
+   * Fetch the snapshot of the call graph.
    */
-  auto callGraph = this->getProgramCallGraph();
+  auto callGraph = this->getFrozenProgramCallGraph();
+  if (!callGraph->isInGraph(startingPoint)) {
+    return { startingPoint };
+  }
 
   /*
    * Compute the set of functions reachable from the starting point.
+   *
+   * Function IDs follow the order of the module, so the functions returned
+   * follow the one of the module.
+   */
+  auto startingPointID = callGraph->getFunctionID(startingPoint);
+  auto &reachable = callGraph->getFunctionsReachableFrom(startingPointID);
+  auto functions = callGraph->getFunctions(reachable);
+
+  return functions;
+}
+
+std::unordered_map<Function *, std::set<Function *>> FunctionsManager::
+    getFunctionsReachableFrom(const std::vector<Function *> &startingPoints) {
+  std::unordered_map<Function *, std::set<Function *>> functions;
+
+  /*
+   * Fetch the snapshot of the call graph.
+   */
+  auto callGraph = this->getFrozenProgramCallGraph();
+
+  /*
+   * Visit the call graph from all starting points in parallel.
    */
-  std::set<Function *> funcSet;
-  std::queue<Function *> funcToTraverse;
-  funcToTraverse.push(startingPoint);
-  while (!funcToTraverse.empty()) {
-    auto func = funcToTraverse.front();
-    funcToTraverse.pop();
-    if (funcSet.find(func) != funcSet.end())
+  std::vector<uint32_t> startingPointIDs;
+  for (auto startingPoint : startingPoints) {
+    if (!callGraph->isInGraph(startingPoint)) {
       continue;
-    funcSet.insert(func);
-
-    auto funcCGNode = callGraph->getFunctionNode(func);
-    for (auto outEdge : callGraph->getOutgoingEdges(funcCGNode)) {
-      auto calleeNode = outEdge->getCallee();
-      auto F = calleeNode->getFunction();
-      if (!F) {
-        continue;
-      }
-      if (F->empty()) {
-        continue;
-      }
-      funcToTraverse.push(F);
     }
+    startingPointIDs.push_back(callGraph->getFunctionID(startingPoint));
   }
+  WorkStealingPool pool;
+  callGraph->computeFunctionsReachableFrom(startingPointIDs, pool);
 
   /*
-   * Iterate over functions of the module and add to the vector only the ones
-   * that are reachable from the starting point. This will enforce that the
-   * order of the functions returned follows the one of the module.
+   * Collect the results.
    */
-  for (auto &f : this->program) {
-    if (funcSet.find(&f) == funcSet.end()) {
-      continue;
-    }
-    functions.insert(&f);
+  for (auto startingPoint : startingPoints) {
+    functions[startingPoint] = this->getFunctionsReachableFrom(startingPoint);
   }
 
   return functions;
@@ -270,6 +289,26 @@ void FunctionsManager::sortByHotness(std::vector<Function *> &functions) {
 
 void FunctionsManager::removeFunction(Function &f) {
   f.eraseFromParent();
+
+  /*
+   * The call graph and its snapshot refer to the removed function.
+   */
+  this->invalidateProgramCallGraphSnapshot();
+
+  return;
+}
+
+void FunctionsManager::invalidateProgramCallGraphSnapshot(void) {
+  delete this->frozenPCG;
+  this->frozenPCG = nullptr;
+
+  /*
+   * The call graph is computed again the next time it is requested.
+   */
+  this->pcg = nullptr;
+  this->pdgAnalysis.invalidateProgramCallGraph();
+
+  return;
 }
 
 } // namespace arcana::noelle
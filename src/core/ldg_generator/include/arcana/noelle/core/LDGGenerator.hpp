@@ -49,6 +49,43 @@ public:
                                    Loop *l,
                                    LoopTree &loopNode);
 
+  /*
+   * Refine @loopDG, the subgraph of a function dependence graph that relates
+   * to the loop @l, into the dependence graph of that loop.
+   * The loop-centric dependence analyses run only if
+   * @enableLoopDependenceAnalyses is true, whatever the state of "this" is.
+   */
+  PDG *generateLoopDependenceGraph(PDG *loopDG,
+                                   ScalarEvolution &scalarEvolution,
+                                   DominatorSummary &DS,
+                                   CompilationOptionsManager *com,
+                                   Loop *l,
+                                   LoopTree &loopNode,
+                                   bool enableLoopDependenceAnalyses);
+
+  /*
+   * The two steps of generateLoopDependenceGraph.
+   *
+   * The first one removes the dependences of @loopDG that the compilation
+   * options allow to remove and it flags the loop-carried ones. It returns the
+   * SCCDAG of the variable and control dependences of the loop, which the
+   * second step needs. No LLVM analysis is used, so this step can run on loops
+   * that do not share @DS or the loop tree of @loopNode in parallel.
+   *
+   * The second step runs the analyses that need the LLVM ones.
+   */
+  SCCDAG *prepareLoopDependenceGraph(PDG *loopDG,
+                                     DominatorSummary &DS,
+                                     CompilationOptionsManager *com,
+                                     LoopTree &loopNode);
+
+  PDG *refineLoopDependenceGraph(PDG *loopDG,
+                                 SCCDAG *loopSCCDAGWithoutMemoryDeps,
+                                 ScalarEvolution &scalarEvolution,
+                                 Loop *l,
+                                 LoopTree &loopNode,
+                                 bool enableLoopDependenceAnalyses);
+
   SCCDAG *computeSCCDAGWithOnlyVariableAndControlDependences(PDG *loopDG);
 
   static std::set<AliasAnalysisEngine *> getLoopAliasAnalysisEngines(void);
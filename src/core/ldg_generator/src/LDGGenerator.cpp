@@ -28,7 +28,7 @@
 namespace arcana::noelle {
 
 // TODO: Refactor along with HELIX's exact same implementation of this method
-DataFlowResult *computeReachabilityFromInstructions(
+DataFlowBitVectorResult *computeReachabilityFromInstructions(
     LoopStructure *loopStructure) {
   assert(loopStructure != nullptr);
 
@@ -38,19 +38,25 @@ DataFlowResult *computeReachabilityFromInstructions(
   /*
    * Run the data flow analysis needed to identify the locations where signal
    * instructions will be placed.
+   *
+   * The equations are given to the solver directly so they are inlined in its
+   * fixed-point loop.
    */
-  auto dfa = DataFlowEngine{};
-  auto computeGEN = [](Instruction *i, DataFlowResult *df) {
+  auto computeGEN = [](Instruction *i, DataFlowBitVectorResult *df) {
     assert(i != nullptr);
     assert(df != nullptr);
     auto &gen = df->GEN(i);
-    gen.insert(i);
+    gen.set(df->getID(i));
+    return;
+  };
+  auto computeKILL = [](Instruction *, DataFlowBitVectorResult *) {
     return;
   };
+  auto initializeSet = [](Instruction *, BitVector &) { return; };
   auto computeOUT = [loopHeader](Instruction *inst,
                                  Instruction *succ,
-                                 std::set<Value *> &OUT,
-                                 DataFlowResult *df) {
+                                 BitVector &OUT,
+                                 DataFlowBitVectorResult *df) {
     assert(succ != nullptr);
     assert(df != nullptr);
 
@@ -68,23 +74,33 @@ DataFlowResult *computeReachabilityFromInstructions(
     /*
      * Propagate the data flow values.
      */
-    auto &inS = df->IN(succ);
-    OUT.insert(inS.begin(), inS.end());
+    OUT |= df->IN(succ);
     return;
   };
   auto computeIN =
-      [](Instruction *inst, std::set<Value *> &IN, DataFlowResult *df) {
+      [](Instruction *inst, BitVector &IN, DataFlowBitVectorResult *df) {
         assert(inst != nullptr);
         assert(df != nullptr);
 
-        auto &genI = df->GEN(inst);
-        auto &outI = df->OUT(inst);
-        IN.insert(outI.begin(), outI.end());
-        IN.insert(genI.begin(), genI.end());
+        IN |= df->OUT(inst);
+        IN |= df->GEN(inst);
         return;
       };
 
-  return dfa.applyBackward(loopFunction, computeGEN, computeIN, computeOUT);
+  auto dfr = new DataFlowBitVectorResult(loopFunction);
+  auto solver = DataFlowSolver<DataFlowDirection::Backward,
+                               DataFlowBitVectorResult,
+                               BitVector>{};
+  solver.solve(loopFunction,
+               dfr,
+               computeGEN,
+               computeKILL,
+               initializeSet,
+               initializeSet,
+               computeOUT,
+               computeIN);
+
+  return dfr;
 }
 
 void LDGGenerator::improveDependenceGraph(PDG *loopDG, LoopStructure *loop) {
@@ -210,6 +226,40 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
     assert(!edge->isLoopCarriedDependence() && "Flag was already set");
   }
   auto loopDG = functionDG->createLoopsSubgraph(l);
+
+  return this->generateLoopDependenceGraph(loopDG,
+                                           scalarEvolution,
+                                           DS,
+                                           com,
+                                           l,
+                                           loopNode,
+                                           this->loopDependenceAnalysesEnabled);
+}
+
+PDG *LDGGenerator::generateLoopDependenceGraph(
+    PDG *loopDG,
+    ScalarEvolution &scalarEvolution,
+    DominatorSummary &DS,
+    CompilationOptionsManager *com,
+    Loop *l,
+    LoopTree &loopNode,
+    bool enableLoopDependenceAnalyses) {
+  auto loopSCCDAGWithoutMemoryDeps =
+      this->prepareLoopDependenceGraph(loopDG, DS, com, loopNode);
+
+  return this->refineLoopDependenceGraph(loopDG,
+                                         loopSCCDAGWithoutMemoryDeps,
+                                         scalarEvolution,
+                                         l,
+                                         loopNode,
+                                         enableLoopDependenceAnalyses);
+}
+
+SCCDAG *LDGGenerator::prepareLoopDependenceGraph(
+    PDG *loopDG,
+    DominatorSummary &DS,
+    CompilationOptionsManager *com,
+    LoopTree &loopNode) {
   for (auto edge : loopDG->getEdges()) {
     assert(!edge->isLoopCarriedDependence() && "Flag was already set");
   }
@@ -298,6 +348,17 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
    */
   LoopCarriedDependencies::setLoopCarriedDependencies(&loopNode, DS, *loopDG);
 
+  return loopSCCDAGWithoutMemoryDeps;
+}
+
+PDG *LDGGenerator::refineLoopDependenceGraph(
+    PDG *loopDG,
+    SCCDAG *loopSCCDAGWithoutMemoryDeps,
+    ScalarEvolution &scalarEvolution,
+    Loop *l,
+    LoopTree &loopNode,
+    bool enableLoopDependenceAnalyses) {
+
   /*
    * Detect loop invariants and induction variables.
    */
@@ -315,7 +376,7 @@ PDG *LDGGenerator::generateLoopDependenceGraph(PDG *functionDG,
   /*
    * Check if loop-centric dependence analyses are enabled.
    */
-  if (this->areLoopDependenceAnalysesEnabled()) {
+  if (enableLoopDependenceAnalyses) {
 
     /*
      * Run SCAF.
@@ -382,7 +443,7 @@ void LDGGenerator::runAffineAnalysis(PDG &loopDG,
      * producer can NEVER reach the consumer during the same iteration
      */
     auto &afterInstructions = dfr->OUT(fromInst);
-    if (afterInstructions.find(toInst) != afterInstructions.end()) {
+    if (dfr->contains(afterInstructions, toInst)) {
       continue;
     }
 
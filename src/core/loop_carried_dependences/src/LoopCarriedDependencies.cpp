@@ -87,16 +87,20 @@ bool LoopCarriedDependencies::isALoopCarriedDependence(
   /*
    * Fetch the innermost loops that contain the two instructions.
    */
-  auto producerLoop = loopNode->getInnermostLoopThatContains(producerI);
-  auto consumerLoop = loopNode->getInnermostLoopThatContains(consumerI);
+  auto producerLoopNode =
+      loopNode->getInnermostLoopNodeThatContains(producerI->getParent());
+  auto consumerLoopNode =
+      loopNode->getInnermostLoopNodeThatContains(consumerI->getParent());
 
   /*
    * If either of the instruction does not belong to a loop, then the dependence
    * cannot be loop-carried.
    */
-  if (!producerLoop || !consumerLoop) {
+  if (!producerLoopNode || !consumerLoopNode) {
     return false;
   }
+  auto producerLoop = producerLoopNode->getLoop();
+  auto consumerLoop = consumerLoopNode->getLoop();
 
   /*
    * If the dependence is a control one and the two instructions belong to a
@@ -183,11 +187,15 @@ bool LoopCarriedDependencies::isALoopCarriedDependence(
        *
        * If the producer cannot reach the header of the loop without reaching
        * the consumer, then the dependence cannot be loop-carried.
+       * The loop checked must include both instructions, which might belong
+       * to sibling sub-loops.
        */
       auto producerB = producerI->getParent();
       auto consumerB = consumerI->getParent();
+      auto commonLoopNode =
+          loopNode->getLowestCommonAncestor(producerLoopNode, consumerLoopNode);
       auto mustProducerReachConsumerBeforeHeader =
-          !canBasicBlockReachHeaderBeforeOther(*consumerLoop,
+          !canBasicBlockReachHeaderBeforeOther(*commonLoopNode->getLoop(),
                                                producerB,
                                                consumerB);
       if (mustProducerReachConsumerBeforeHeader) {
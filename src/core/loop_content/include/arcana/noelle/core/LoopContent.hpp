@@ -38,10 +38,40 @@
 
 namespace arcana::noelle {
 
+/*
+ * LLVM analyses needed to compute the sub-analyses of a loop.
+ *
+ * LLVM recomputes the analyses of a function (and frees the previous ones)
+ * every time a module pass requests one of them. Hence, the scalar evolution
+ * and the LLVM loop are fetched together every time a sub-analysis needs
+ * them. The loop returned is nullptr if the header of the loop no longer
+ * starts a loop.
+ */
+struct LoopContentFunctionAnalyses {
+  std::function<std::pair<ScalarEvolution *, Loop *>(void)> fetchSEAndLLVMLoop;
+};
+
+/*
+ * Sub-analyses of a loop content.
+ */
+enum LoopContentAnalysis {
+  LOOP_DG_ANALYSIS,
+  LOOP_SCCDAG_ANALYSIS,
+  LOOP_ENVIRONMENT_ANALYSIS,
+  LOOP_INVARIANTS_ANALYSIS,
+  LOOP_INDUCTION_VARIABLES_ANALYSIS,
+  LOOP_SCCDAG_ATTRIBUTES_ANALYSIS,
+  LOOP_ITERATION_SPACE_ANALYSIS,
+  NUMBER_OF_LOOP_CONTENT_ANALYSES
+};
+
 class LoopContent {
 public:
   /*
    * Constructors.
+   *
+   * The constructors that take the dominators of the function compute all
+   * sub-analyses of the loop immediately.
    */
   LoopContent(LDGGenerator &ldgAnalysis,
               CompilationOptionsManager *compilationOptionsManager,
@@ -103,6 +133,33 @@ public:
               bool enableLoopAwareDependenceAnalyses,
               uint32_t chunkSize);
 
+  /*
+   * Only the trip count of the loop is computed by this constructor.
+   * Every other sub-analysis is computed the first time it is requested, and
+   * it is then kept for later requests.
+   *
+   * The state these sub-analyses depend on is captured here: the function
+   * dependence graph @fG (kept alive by "this" until the dependences of the
+   * loop are taken from it), the dominators @DS (which can be shared by the
+   * loops of a function), and the options of the loop. Only the LLVM analyses
+   * are fetched later through @analyses.
+   * Sub-analyses must be requested before the loop is transformed; clients
+   * that transform code first should call computeAllAnalyses() right after
+   * creating "this".
+   */
+  LoopContent(LDGGenerator &ldgAnalysis,
+              CompilationOptionsManager *compilationOptionsManager,
+              std::shared_ptr<PDG> fG,
+              LoopTree *loop,
+              Loop *l,
+              ScalarEvolution &SE,
+              std::shared_ptr<DominatorSummary> DS,
+              LoopContentFunctionAnalyses analyses,
+              uint32_t maxCores,
+              std::unordered_set<LoopContentOptimization> optimizations,
+              bool enableLoopAwareDependenceAnalyses,
+              uint32_t chunkSize);
+
   LoopContent() = delete;
 
   /*
@@ -157,6 +214,45 @@ public:
 
   uint64_t getCompileTimeTripCount(void) const;
 
+  /*
+   * Compute the sub-analyses that have not been computed yet.
+   */
+  void computeAllAnalyses(void);
+
+  /*
+   * Compute the sub-analyses that have not been computed yet using the LLVM
+   * analyses given as input.
+   * These analyses must be valid for the duration of the call.
+   */
+  void computeLoopDG(ScalarEvolution &SE, Loop *l);
+
+  void computeAllAnalyses(ScalarEvolution &SE, Loop *l);
+
+  /*
+   * Take the dependences of the loop from the function dependence graph and
+   * refine them as far as possible without the LLVM analyses (see
+   * LDGGenerator::prepareLoopDependenceGraph).
+   * The dominators and the loop tree are shared with the other loops of the
+   * function, so this can run on loops of different functions in parallel.
+   */
+  void prepareLoopDG(void);
+
+  /*
+   * Compute the sub-analyses that only need the loop dependence graph (i.e.,
+   * the SCCDAG, the environment, and the invariants).
+   * The loop dependence graph must be already available.
+   * No LLVM analysis is used, so this can run on different loops in parallel.
+   */
+  void computeAnalysesOfLoopDG(void);
+
+  /*
+   * Return the time (in microseconds) spent computing @analysis for all loop
+   * contents, and the number of times it has been computed.
+   */
+  static uint64_t getTimeSpentIn(LoopContentAnalysis analysis);
+
+  static uint64_t getNumberOfComputationsOf(LoopContentAnalysis analysis);
+
   /*
    * Deconstructor.
    */
@@ -165,58 +261,134 @@ public:
 private:
   /*
    * Fields
+   *
+   * Sub-analyses are computed on demand, also by const methods; hence, they
+   * are mutable.
    */
   LoopTree *loop;
 
-  LoopEnvironment *environment;
+  mutable LoopEnvironment *environment;
 
-  PDG *loopDG; /* Dependence graph of the loop.
-                * This graph does not include instructions outside the loop
-                * (i.e., no external dependences are included).
-                */
+  mutable PDG *loopDG; /* Dependence graph of the loop.
+                        * This graph does not include instructions outside the
+                        * loop (i.e., no external dependences are included).
+                        */
 
-  InductionVariableManager *inductionVariables;
+  mutable SCCDAG *loopSCCDAG;
 
-  InvariantManager *invariantManager;
+  mutable InductionVariableManager *inductionVariables;
 
-  LoopIterationSpaceAnalysis *domainSpaceAnalysis;
+  mutable InvariantManager *invariantManager;
 
-  MemoryCloningAnalysis *memoryCloningAnalysis;
+  mutable LoopIterationSpaceAnalysis *domainSpaceAnalysis;
+
+  mutable MemoryCloningAnalysis *memoryCloningAnalysis;
 
   bool compileTimeKnownTripCount;
 
   uint64_t tripCount;
 
-  SCCDAGAttrs *sccdagAttrs;
+  mutable SCCDAGAttrs *sccdagAttrs;
 
   LoopTransformationsManager *loopTransformationsManager;
 
   CompilationOptionsManager *com;
 
+  /*
+   * State needed to compute the sub-analyses on demand.
+   * It is captured when "this" is created.
+   */
+  LDGGenerator &ldgAnalysis;
+
+  mutable std::shared_ptr<PDG> functionDG; /* Function dependence graph the
+                                            * dependences of the loop are
+                                            * taken from.
+                                            */
+
+  mutable PDG *loopSubgraph; /* Dependences of the loop in the function
+                              * dependence graph. It is refined into the
+                              * loop dependence graph.
+                              */
+
+  mutable SCCDAG *loopSCCDAGWithoutMemoryDeps; /* Set when the refinements of
+                                                * the loop subgraph that do
+                                                * not need the LLVM analyses
+                                                * have been applied.
+                                                */
+
+  bool loopDependenceAnalysesEnabled;
+
+  std::unordered_set<LoopContentOptimization> optimizations;
+
+  DominatorSummary *DS;
+
+  std::shared_ptr<DominatorSummary> sharedDS;
+
+  LoopContentFunctionAnalyses analyses;
+
+  /*
+   * LLVM analyses that are valid while a sub-analysis is computed.
+   */
+  mutable ScalarEvolution *SE;
+
+  mutable Loop *llvmLoop;
+
+  static std::atomic<uint64_t> timeSpentIn[NUMBER_OF_LOOP_CONTENT_ANALYSES];
+
+  static std::atomic<uint64_t>
+      numberOfComputationsOf[NUMBER_OF_LOOP_CONTENT_ANALYSES];
+
   /*
    * Methods
    */
   void fetchLoopAndBBInfo(Loop *l, ScalarEvolution &SE);
 
-  std::pair<PDG *, SCCDAG *> createDGsForLoop(LDGGenerator &ldgAnalysis,
-                                              CompilationOptionsManager *com,
-                                              Loop *l,
-                                              LoopTree *loopNode,
-                                              PDG *functionDG,
-                                              DominatorSummary &DS,
-                                              ScalarEvolution &SE);
+  void computeMissingAnalyses(void) const;
+
+  void fetchFunctionAnalyses(void) const;
+
+  void releaseFunctionAnalyses(void) const;
+
+  void computeLoopSubgraph(void) const;
+
+  void prepareLoopSubgraph(void) const;
+
+  void computeLoopDG(void) const;
+
+  void computeLoopSCCDAG(void) const;
+
+  void computeEnvironment(void) const;
+
+  void computeInvariants(void) const;
+
+  void computeInductionVariables(void) const;
+
+  void computeSCCDAGAttributes(void) const;
+
+  void computeIterationSpace(void) const;
+
+  static void recordTime(LoopContentAnalysis analysis,
+                         std::chrono::steady_clock::time_point start);
+
+  static void addTime(LoopContentAnalysis analysis,
+                      std::chrono::steady_clock::time_point start);
+
+  PDG *createLoopDG(PDG *loopSubgraph,
+                    Loop *l,
+                    DominatorSummary &DS,
+                    ScalarEvolution &SE) const;
 
   uint64_t computeTripCounts(Loop *l, ScalarEvolution &SE);
 
   void removeUnnecessaryDependenciesThatCloningMemoryNegates(
       LoopTree *loopNode,
       PDG *loopInternalDG,
-      DominatorSummary &DS);
+      DominatorSummary &DS) const;
 
   void removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
       LoopTree *loopNode,
       PDG *loopDG,
-      DominatorSummary &DS);
+      DominatorSummary &DS) const;
 };
 
 } // namespace arcana::noelle
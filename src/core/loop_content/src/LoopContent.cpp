@@ -28,6 +28,12 @@
 
 namespace arcana::noelle {
 
+std::atomic<uint64_t>
+    LoopContent::timeSpentIn[NUMBER_OF_LOOP_CONTENT_ANALYSES];
+
+std::atomic<uint64_t>
+    LoopContent::numberOfComputationsOf[NUMBER_OF_LOOP_CONTENT_ANALYSES];
+
 LoopContent::LoopContent(LDGGenerator &ldgAnalysis,
                          CompilationOptionsManager *compilationOptionsManager,
                          PDG *fG,
@@ -140,8 +146,27 @@ LoopContent::LoopContent(
     bool enableLoopAwareDependenceAnalyses,
     uint32_t chunkSize)
   : loop{ loopNode },
+    environment{ nullptr },
+    loopDG{ nullptr },
+    loopSCCDAG{ nullptr },
+    inductionVariables{ nullptr },
+    invariantManager{ nullptr },
+    domainSpaceAnalysis{ nullptr },
     memoryCloningAnalysis{ nullptr },
-    com{ compilationOptionsManager } {
+    sccdagAttrs{ nullptr },
+    com{ compilationOptionsManager },
+    ldgAnalysis{ ldgAnalysis },
+    functionDG{},
+    loopSubgraph{ nullptr },
+    loopSCCDAGWithoutMemoryDeps{ nullptr },
+    loopDependenceAnalysesEnabled{
+      ldgAnalysis.areLoopDependenceAnalysesEnabled() },
+    optimizations{ optimizations },
+    DS{ nullptr },
+    sharedDS{},
+    analyses{},
+    SE{ nullptr },
+    llvmLoop{ nullptr } {
   assert(this->loop != nullptr);
 
   /*
@@ -166,21 +191,304 @@ LoopContent::LoopContent(
   this->loopTransformationsManager->enableAllTransformations();
 
   /*
-   * Fetch the loop dependence graph (i.e., the subset of the PDG that relates
-   * to the loop @l) and its SCCDAG.
+   * Compute the trip count of the loop.
    */
   this->fetchLoopAndBBInfo(l, SE);
-  auto ls = this->getLoopStructure();
-  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
-  auto DGs = this->createDGsForLoop(ldgAnalysis,
-                                    compilationOptionsManager,
-                                    l,
-                                    loopNode,
-                                    fG,
-                                    DS,
-                                    SE);
-  this->loopDG = DGs.first;
-  auto loopSCCDAG = DGs.second;
+
+  /*
+   * Compute all sub-analyses of the loop.
+   * The dominators given as input are not owned by "this", so they are not
+   * kept.
+   */
+  this->loopSubgraph = fG->createLoopsSubgraph(l);
+  this->DS = &DS;
+  this->computeAllAnalyses(SE, l);
+  this->DS = nullptr;
+
+  return;
+}
+
+LoopContent::LoopContent(
+    LDGGenerator &ldgAnalysis,
+    CompilationOptionsManager *compilationOptionsManager,
+    std::shared_ptr<PDG> fG,
+    LoopTree *loopNode,
+    Loop *l,
+    ScalarEvolution &SE,
+    std::shared_ptr<DominatorSummary> DS,
+    LoopContentFunctionAnalyses analyses,
+    uint32_t maxCores,
+    std::unordered_set<LoopContentOptimization> optimizations,
+    bool enableLoopAwareDependenceAnalyses,
+    uint32_t chunkSize)
+  : loop{ loopNode },
+    environment{ nullptr },
+    loopDG{ nullptr },
+    loopSCCDAG{ nullptr },
+    inductionVariables{ nullptr },
+    invariantManager{ nullptr },
+    domainSpaceAnalysis{ nullptr },
+    memoryCloningAnalysis{ nullptr },
+    sccdagAttrs{ nullptr },
+    com{ compilationOptionsManager },
+    ldgAnalysis{ ldgAnalysis },
+    functionDG{},
+    loopSubgraph{ nullptr },
+    loopSCCDAGWithoutMemoryDeps{ nullptr },
+    loopDependenceAnalysesEnabled{
+      ldgAnalysis.areLoopDependenceAnalysesEnabled() },
+    optimizations{ optimizations },
+    DS{ DS.get() },
+    sharedDS{ DS },
+    analyses{ analyses },
+    SE{ nullptr },
+    llvmLoop{ nullptr } {
+  assert(this->loop != nullptr);
+  assert(this->DS != nullptr);
+
+  /*
+   * Create the loop transformations manager
+   */
+  this->loopTransformationsManager =
+      new LoopTransformationsManager(maxCores,
+                                     chunkSize,
+                                     optimizations,
+                                     enableLoopAwareDependenceAnalyses);
+
+  /*
+   * Enable all transformations.
+   */
+  this->loopTransformationsManager->enableAllTransformations();
+
+  /*
+   * Compute the trip count of the loop.
+   */
+  this->fetchLoopAndBBInfo(l, SE);
+
+  /*
+   * Keep the function dependence graph until the dependences of the loop are
+   * taken from it.
+   * The other sub-analyses are computed on demand.
+   */
+  assert(fG != nullptr);
+  this->functionDG = fG;
+
+  return;
+}
+
+void LoopContent::computeMissingAnalyses(void) const {
+  this->computeLoopDG();
+  this->computeLoopSCCDAG();
+  this->computeEnvironment();
+  this->computeInvariants();
+  this->computeInductionVariables();
+  this->computeSCCDAGAttributes();
+  this->computeIterationSpace();
+
+  return;
+}
+
+void LoopContent::fetchFunctionAnalyses(void) const {
+
+  /*
+   * Check if the LLVM analyses are available.
+   */
+  if (this->SE != nullptr) {
+    return;
+  }
+
+  /*
+   * Fetch the LLVM analyses.
+   */
+  auto analyses = this->analyses.fetchSEAndLLVMLoop();
+  this->SE = analyses.first;
+  this->llvmLoop = analyses.second;
+  assert(this->SE != nullptr);
+  if (this->llvmLoop == nullptr) {
+    errs() << "LoopContent: Error = the loop "
+           << this->getLoopStructure()->getHeader()->getName()
+           << " does not exist anymore. Sub-analyses of a loop must be "
+              "requested before its loop is transformed\n";
+    abort();
+  }
+
+  return;
+}
+
+void LoopContent::releaseFunctionAnalyses(void) const {
+
+  /*
+   * The LLVM analyses can be freed after the current request.
+   */
+  this->SE = nullptr;
+  this->llvmLoop = nullptr;
+
+  return;
+}
+
+void LoopContent::computeLoopDG(ScalarEvolution &SE, Loop *l) {
+  this->SE = &SE;
+  this->llvmLoop = l;
+  this->computeLoopDG();
+  this->releaseFunctionAnalyses();
+
+  return;
+}
+
+void LoopContent::computeAllAnalyses(ScalarEvolution &SE, Loop *l) {
+  this->SE = &SE;
+  this->llvmLoop = l;
+  this->computeMissingAnalyses();
+  this->releaseFunctionAnalyses();
+
+  return;
+}
+
+void LoopContent::computeAllAnalyses(void) {
+  this->computeMissingAnalyses();
+  this->releaseFunctionAnalyses();
+
+  return;
+}
+
+void LoopContent::computeAnalysesOfLoopDG(void) {
+  assert(this->loopDG != nullptr);
+
+  this->computeLoopSCCDAG();
+  this->computeEnvironment();
+  this->computeInvariants();
+
+  return;
+}
+
+void LoopContent::prepareLoopDG(void) {
+  this->prepareLoopSubgraph();
+
+  return;
+}
+
+void LoopContent::computeLoopSubgraph(void) const {
+  if (this->loopSubgraph != nullptr) {
+    return;
+  }
+
+  /*
+   * Take the dependences of the loop from the function dependence graph,
+   * which is not needed after this point.
+   * The instructions are listed following the basic blocks of the LLVM loop,
+   * so the subgraph is the one PDG::createLoopsSubgraph would build.
+   */
+  assert(this->functionDG != nullptr);
+  std::vector<Value *> loopInstructions;
+  for (auto bb : this->getLoopStructure()->getOrderedBasicBlocks()) {
+    for (auto &inst : *bb) {
+      loopInstructions.push_back(&inst);
+    }
+  }
+  this->loopSubgraph =
+      this->functionDG->createSubgraphFromValues(loopInstructions, true);
+  this->functionDG.reset();
+
+  return;
+}
+
+void LoopContent::prepareLoopSubgraph(void) const {
+  if (this->loopSCCDAGWithoutMemoryDeps != nullptr) {
+    return;
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  /*
+   * Apply the refinements of the loop dependences that do not need the LLVM
+   * analyses.
+   */
+  this->computeLoopSubgraph();
+  assert(this->loopSubgraph != nullptr);
+  this->loopSCCDAGWithoutMemoryDeps =
+      this->ldgAnalysis.prepareLoopDependenceGraph(this->loopSubgraph,
+                                                   *this->DS,
+                                                   this->com,
+                                                   *this->loop);
+
+  LoopContent::addTime(LOOP_DG_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeLoopDG(void) const {
+  if (this->loopDG != nullptr) {
+    return;
+  }
+  this->fetchFunctionAnalyses();
+  auto start = std::chrono::steady_clock::now();
+
+  /*
+   * Refine the dependences of the loop into the loop dependence graph.
+   */
+  this->prepareLoopSubgraph();
+  assert(this->loopSubgraph != nullptr);
+  this->loopDG = this->createLoopDG(this->loopSubgraph,
+                                    this->llvmLoop,
+                                    *this->DS,
+                                    *this->SE);
+  this->loopSubgraph = nullptr;
+  this->loopSCCDAGWithoutMemoryDeps = nullptr;
+
+  LoopContent::recordTime(LOOP_DG_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeLoopSCCDAG(void) const {
+  if (this->loopSCCDAG != nullptr) {
+    return;
+  }
+  this->computeLoopDG();
+  auto start = std::chrono::steady_clock::now();
+
+  /*
+   * Build a SCCDAG of loop-internal instructions
+   */
+  auto loopInternalDG = this->loopDG->clone(false);
+  this->loopSCCDAG = new SCCDAG(loopInternalDG);
+
+  /*
+   * Safety check: check that the SCCDAG includes all instructions of the loop
+   * given as input.
+   */
+#ifdef DEBUG
+
+  /*
+   * Check that all loop instructions belong to LDI-specific containers.
+   */
+  {
+    int64_t numberOfInstructionsInLoop = 0;
+    for (auto bbIter : this->getLoopStructure()->getBasicBlocks()) {
+      for (auto &I : *bbIter) {
+        assert(loopInternalDG->isInternal(&I));
+        assert(this->loopSCCDAG->doesItContain(&I));
+        numberOfInstructionsInLoop++;
+      }
+    }
+
+    /*
+     * Check that all LDI-specific containers include only loop instructions.
+     */
+    assert(loopInternalDG->numNodes() == numberOfInstructionsInLoop);
+  }
+#endif
+
+  LoopContent::recordTime(LOOP_SCCDAG_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeEnvironment(void) const {
+  if (this->environment != nullptr) {
+    return;
+  }
+  this->computeLoopDG();
+  auto start = std::chrono::steady_clock::now();
 
   /*
    * Create the environment for the loop.
@@ -188,6 +496,8 @@ LoopContent::LoopContent(
    * Exclude stack objects that will be cloned. To do so, we need to collect
    * this set of objects.
    */
+  auto ls = this->getLoopStructure();
+  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
   std::set<Value *> stackObjectsThatWillBeCloned;
   if (this->memoryCloningAnalysis != nullptr) {
     for (auto memObject :
@@ -210,8 +520,21 @@ LoopContent::LoopContent(
       stackObjectsThatWillBeCloned.insert(stackObject);
     }
   }
-  this->environment =
-      new LoopEnvironment(loopDG, loopExitBlocks, stackObjectsThatWillBeCloned);
+  this->environment = new LoopEnvironment(this->loopDG,
+                                          loopExitBlocks,
+                                          stackObjectsThatWillBeCloned);
+
+  LoopContent::recordTime(LOOP_ENVIRONMENT_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeInvariants(void) const {
+  if (this->invariantManager != nullptr) {
+    return;
+  }
+  this->computeLoopDG();
+  auto start = std::chrono::steady_clock::now();
 
   /*
    * Create the invariant manager.
@@ -221,6 +544,20 @@ LoopContent::LoopContent(
   auto topLoop = this->loop->getLoop();
   this->invariantManager = new InvariantManager(topLoop, this->loopDG);
 
+  LoopContent::recordTime(LOOP_INVARIANTS_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeInductionVariables(void) const {
+  if (this->inductionVariables != nullptr) {
+    return;
+  }
+  this->computeEnvironment();
+  this->computeInvariants();
+  this->fetchFunctionAnalyses();
+  auto start = std::chrono::steady_clock::now();
+
   /*
    * Create the induction variable manager.
    *
@@ -232,36 +569,97 @@ LoopContent::LoopContent(
    * And then, we can identify IVs from this new SCCDAG.
    */
   auto loopSCCDAGWithoutMemoryDeps =
-      ldgAnalysis.computeSCCDAGWithOnlyVariableAndControlDependences(loopDG);
+      this->ldgAnalysis.computeSCCDAGWithOnlyVariableAndControlDependences(
+          this->loopDG);
   this->inductionVariables =
       new InductionVariableManager(this->loop,
-                                   *invariantManager,
-                                   SE,
+                                   *this->invariantManager,
+                                   *this->SE,
                                    *loopSCCDAGWithoutMemoryDeps,
-                                   *environment,
-                                   *l);
+                                   *this->environment,
+                                   *this->llvmLoop);
 
   /*
-   * Calculate various attributes on SCCs
+   * Collect induction variable information
    */
-  this->sccdagAttrs = new SCCDAGAttrs(
-      compilationOptionsManager->canFloatsBeConsideredRealNumbers(),
-      loopDG,
-      loopSCCDAG,
-      this->loop,
-      *inductionVariables,
-      DS);
-  this->domainSpaceAnalysis =
-      new LoopIterationSpaceAnalysis(this->loop, *this->inductionVariables, SE);
+  auto topLoop = this->loop->getLoop();
+  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+
+  LoopContent::recordTime(LOOP_INDUCTION_VARIABLES_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::computeSCCDAGAttributes(void) const {
+  if (this->sccdagAttrs != nullptr) {
+    return;
+  }
+  this->computeLoopSCCDAG();
+  this->computeInductionVariables();
+  this->fetchFunctionAnalyses();
+  auto start = std::chrono::steady_clock::now();
 
   /*
-   * Collect induction variable information
+   * Calculate various attributes on SCCs
    */
-  this->inductionVariables->getLoopGoverningInductionVariable(*topLoop);
+  this->sccdagAttrs =
+      new SCCDAGAttrs(this->com->canFloatsBeConsideredRealNumbers(),
+                      this->loopDG,
+                      this->loopSCCDAG,
+                      this->loop,
+                      *this->inductionVariables,
+                      *this->DS);
+
+  LoopContent::recordTime(LOOP_SCCDAG_ATTRIBUTES_ANALYSIS, start);
 
   return;
 }
 
+void LoopContent::computeIterationSpace(void) const {
+  if (this->domainSpaceAnalysis != nullptr) {
+    return;
+  }
+  this->computeInductionVariables();
+  this->fetchFunctionAnalyses();
+  auto start = std::chrono::steady_clock::now();
+
+  this->domainSpaceAnalysis =
+      new LoopIterationSpaceAnalysis(this->loop,
+                                     *this->inductionVariables,
+                                     *this->SE);
+
+  LoopContent::recordTime(LOOP_ITERATION_SPACE_ANALYSIS, start);
+
+  return;
+}
+
+void LoopContent::recordTime(LoopContentAnalysis analysis,
+                             std::chrono::steady_clock::time_point start) {
+  LoopContent::addTime(analysis, start);
+  LoopContent::numberOfComputationsOf[analysis]++;
+
+  return;
+}
+
+void LoopContent::addTime(LoopContentAnalysis analysis,
+                          std::chrono::steady_clock::time_point start) {
+  auto end = std::chrono::steady_clock::now();
+  auto elapsed =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+  LoopContent::timeSpentIn[analysis] += elapsed.count();
+
+  return;
+}
+
+uint64_t LoopContent::getTimeSpentIn(LoopContentAnalysis analysis) {
+  return LoopContent::timeSpentIn[analysis];
+}
+
+uint64_t LoopContent::getNumberOfComputationsOf(LoopContentAnalysis analysis) {
+  return LoopContent::numberOfComputationsOf[analysis];
+}
+
 void LoopContent::copyParallelizationOptionsFrom(LoopContent *otherLDI) {
   auto otherLTM = otherLDI->getLoopTransformationsManager();
   assert(otherLTM != nullptr);
@@ -307,32 +705,32 @@ uint64_t LoopContent::computeTripCounts(Loop *l, ScalarEvolution &SE) {
   return tripCount;
 }
 
-std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
-    LDGGenerator &ldgAnalysis,
-    CompilationOptionsManager *com,
-    Loop *l,
-    LoopTree *loopNode,
-    PDG *functionDG,
-    DominatorSummary &DS,
-    ScalarEvolution &SE) {
+PDG *LoopContent::createLoopDG(PDG *loopSubgraph,
+                                Loop *l,
+                                DominatorSummary &DS,
+                                ScalarEvolution &SE) const {
 
   /*
    * Perform loop-aware memory dependence analysis to refine the loop dependence
    * graph.
+   * Whether the loop-centric dependence analyses run has been decided when
+   * "this" was created.
    */
-  auto loopDG = ldgAnalysis.generateLoopDependenceGraph(functionDG,
-                                                        SE,
-                                                        DS,
-                                                        com,
-                                                        l,
-                                                        *loopNode);
+  assert(this->loopSCCDAGWithoutMemoryDeps != nullptr);
+  auto loopDG = this->ldgAnalysis.refineLoopDependenceGraph(
+      loopSubgraph,
+      this->loopSCCDAGWithoutMemoryDeps,
+      SE,
+      l,
+      *this->loop,
+      this->loopDependenceAnalysesEnabled);
 
   /*
    * Analyze the loop to identify opportunities of cloning stack objects.
    */
-  if (this->loopTransformationsManager->isOptimizationEnabled(
-          LoopContentOptimization::MEMORY_CLONING_ID)) {
-    this->removeUnnecessaryDependenciesThatCloningMemoryNegates(loopNode,
+  auto &optimizations = this->optimizations;
+  if (optimizations.count(LoopContentOptimization::MEMORY_CLONING_ID) > 0) {
+    this->removeUnnecessaryDependenciesThatCloningMemoryNegates(this->loop,
                                                                 loopDG,
                                                                 DS);
   }
@@ -340,55 +738,21 @@ std::pair<PDG *, SCCDAG *> LoopContent::createDGsForLoop(
   /*
    * Remove memory dependences with known thread-safe library functions.
    */
-  if (this->loopTransformationsManager->isOptimizationEnabled(
-          LoopContentOptimization::THREAD_SAFE_LIBRARY_ID)) {
-    this->removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(loopNode,
-                                                                      loopDG,
-                                                                      DS);
+  if (optimizations.count(LoopContentOptimization::THREAD_SAFE_LIBRARY_ID)
+      > 0) {
+    this->removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
+        this->loop,
+        loopDG,
+        DS);
   }
 
-  /*
-   * Build a SCCDAG of loop-internal instructions
-   */
-  auto loopInternalDG = loopDG->clone(false);
-  auto loopSCCDAG = new SCCDAG(loopInternalDG);
-
-  /*
-   * Safety check: check that the SCCDAG includes all instructions of the loop
-   * given as input.
-   */
-#ifdef DEBUG
-
-  /*
-   * Check that all loop instructions belong to LDI-specific containers.
-   */
-  {
-    int64_t numberOfInstructionsInLoop = 0;
-    for (auto bbIter : l->blocks()) {
-      for (auto &I : *bbIter) {
-        assert(std::find(loopInternals.begin(), loopInternals.end(), &I)
-               != loopInternals.end());
-        assert(loopInternalDG->isInternal(&I));
-        assert(loopSCCDAG->doesItContain(&I));
-        numberOfInstructionsInLoop++;
-      }
-    }
-
-    /*
-     * Check that all LDI-specific containers include only loop instructions.
-     */
-    assert(loopInternals.size() == numberOfInstructionsInLoop);
-    assert(loopInternalDG->numNodes() == loopInternals.size());
-  }
-#endif
-
-  return std::make_pair(loopDG, loopSCCDAG);
+  return loopDG;
 }
 
 void LoopContent::removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
     LoopTree *loopNode,
     PDG *loopDG,
-    DominatorSummary &DS) {
+    DominatorSummary &DS) const {
 
   /*
    * Fetch the loop sub-tree rooted at @this.
@@ -455,7 +819,7 @@ void LoopContent::removeUnnecessaryDependenciesWithThreadSafeLibraryFunctions(
 void LoopContent::removeUnnecessaryDependenciesThatCloningMemoryNegates(
     LoopTree *loopNode,
     PDG *loopInternalDG,
-    DominatorSummary &DS) {
+    DominatorSummary &DS) const {
 
   /*
    * Fetch the loop sub-tree rooted at @this.
@@ -555,6 +919,9 @@ void LoopContent::removeUnnecessaryDependenciesThatCloningMemoryNegates(
 }
 
 PDG *LoopContent::getLoopDG(void) const {
+  this->computeLoopDG();
+  this->releaseFunctionAnalyses();
+
   return this->loopDG;
 }
 
@@ -582,10 +949,20 @@ LoopStructure *LoopContent::getNestedMostLoopStructure(Instruction *I) const {
 }
 
 InductionVariableManager *LoopContent::getInductionVariableManager(void) const {
-  return inductionVariables;
+  this->computeInductionVariables();
+  this->releaseFunctionAnalyses();
+
+  return this->inductionVariables;
 }
 
 MemoryCloningAnalysis *LoopContent::getMemoryCloningAnalysis(void) const {
+
+  /*
+   * The memory cloning analysis is computed with the loop dependence graph.
+   */
+  this->computeLoopDG();
+  this->releaseFunctionAnalyses();
+
   assert(
       this->memoryCloningAnalysis != nullptr
       && "Requesting memory cloning analysis without having specified LoopContentOptimization::MEMORY_CLONING");
@@ -601,11 +978,17 @@ uint64_t LoopContent::getCompileTimeTripCount(void) const {
 }
 
 InvariantManager *LoopContent::getInvariantManager(void) const {
+  this->computeInvariants();
+  this->releaseFunctionAnalyses();
+
   return this->invariantManager;
 }
 
 LoopIterationSpaceAnalysis *LoopContent::getLoopIterationSpaceAnalysis(
     void) const {
+  this->computeIterationSpace();
+  this->releaseFunctionAnalyses();
+
   return this->domainSpaceAnalysis;
 }
 
@@ -614,10 +997,16 @@ LoopTree *LoopContent::getLoopHierarchyStructures(void) const {
 }
 
 SCCDAGAttrs *LoopContent::getSCCManager(void) const {
+  this->computeSCCDAGAttributes();
+  this->releaseFunctionAnalyses();
+
   return this->sccdagAttrs;
 }
 
 LoopEnvironment *LoopContent::getEnvironment(void) const {
+  this->computeEnvironment();
+  this->releaseFunctionAnalyses();
+
   return this->environment;
 }
 
@@ -634,10 +1023,12 @@ LoopContent::~LoopContent() {
     delete this->inductionVariables;
   }
 
-  assert(this->invariantManager);
-  delete this->invariantManager;
+  if (this->invariantManager) {
+    delete this->invariantManager;
+  }
 
   delete this->domainSpaceAnalysis;
+  delete this->loopSubgraph;
 
   return;
 }
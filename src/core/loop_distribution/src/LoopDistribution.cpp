@@ -67,7 +67,7 @@ bool LoopDistribution::splitLoop(LoopContent const &LDI,
   /*
    * Assert that all instructions in instsToPullOut are actually within the loop
    */
-  auto loopBBs = loopStructure->getBasicBlocks();
+  auto &loopBBs = loopStructure->getBasicBlocks();
   for (auto inst : instsToPullOut) {
     auto parent = inst->getParent();
     // errs() << "LoopDistribution: Asked to pull out " << *inst << "\n";
@@ -229,7 +229,7 @@ void LoopDistribution::recursivelyCollectDependencies(
     std::set<Instruction *> &toPopulate,
     LoopContent const &LDI) {
   std::vector<Instruction *> queue = { inst };
-  auto BBs = LDI.getLoopStructure()->getBasicBlocks();
+  auto &BBs = LDI.getLoopStructure()->getBasicBlocks();
   auto pdg = LDI.getLoopDG();
   auto fn = [&BBs, &queue, &toPopulate](Value *from,
                                         DGEdge<Value, Value> *dep) -> bool {
@@ -301,7 +301,7 @@ bool LoopDistribution::splitWouldRequireForwardingDataDependencies(
     LoopContent const &LDI,
     std::set<Instruction *> const &instsToPullOut,
     std::set<Instruction *> const &instsToClone) {
-  auto BBs = LDI.getLoopStructure()->getBasicBlocks();
+  auto &BBs = LDI.getLoopStructure()->getBasicBlocks();
   auto fromFn = [&BBs, &instsToPullOut, &instsToClone](
                     Value *from,
                     DGEdge<Value, Value> *dependence) -> bool {
@@ -42,6 +42,18 @@ public:
 
   LoopStructure *getInnermostLoopThatContains(BasicBlock *bb);
 
+  /*
+   * Return the node of the innermost loop of the sub-tree rooted at @this that
+   * contains @bb, or nullptr if @bb does not belong to @this.
+   */
+  LoopTree *getInnermostLoopNodeThatContains(BasicBlock *bb);
+
+  /*
+   * Return the node of the innermost loop that contains both @n1 and @n2.
+   * Both nodes must belong to the sub-tree rooted at @this.
+   */
+  LoopTree *getLowestCommonAncestor(LoopTree *n1, LoopTree *n2);
+
   LoopStructure *getOutermostLoopThatContains(Instruction *i);
 
   LoopStructure *getOutermostLoopThatContains(BasicBlock *bb);
@@ -79,6 +91,22 @@ private:
   LoopTree *parent;
   std::unordered_set<LoopTree *> children;
 
+  /*
+   * Lookup table of the tree.
+   * Only the root keeps it: it maps every basic block of the tree to the node
+   * of the innermost loop that contains it. Building it also sets the depth of
+   * every node (the root is at depth 0), which is used together with the
+   * parent pointers to find lowest common ancestors.
+   * The table is built on the first query and dropped when the tree changes.
+   */
+  bool areLookupTablesValid;
+  std::unordered_map<BasicBlock *, LoopTree *> innermostLoopOfBlock;
+  uint32_t depth;
+
+  LoopTree *getRoot(void);
+  void buildLookupTables(void);
+  void invalidateLookupTables(void);
+
   bool visitPreOrder(
       std::function<bool(LoopTree *n, uint32_t treeLevel)> funcToInvoke,
       uint32_t treeLevel);
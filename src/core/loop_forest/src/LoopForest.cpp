@@ -301,20 +301,7 @@ LoopTree *LoopForest::getInnermostLoopThatContains(Instruction *i) const {
      *
      * Fetch the innermost loop that contains it.
      */
-    LoopTree *innermostLoop = nullptr;
-    auto finderFunction = [i, &innermostLoop](LoopTree *n,
-                                              uint32_t treeLevel) -> bool {
-      /*
-       * Fetch the loop
-       */
-      auto loop = n->getLoop();
-      if (loop->isIncluded(i)) {
-        innermostLoop = n;
-        return true;
-      }
-      return false;
-    };
-    tree->visitPostOrder(finderFunction);
+    auto innermostLoop = tree->getInnermostLoopNodeThatContains(i->getParent());
     assert(innermostLoop != nullptr);
     return innermostLoop;
   }
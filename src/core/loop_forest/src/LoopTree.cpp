@@ -30,7 +30,9 @@ LoopTree::LoopTree(LoopForest *f, LoopStructure *l) : LoopTree(f, l, nullptr) {
 LoopTree::LoopTree(LoopForest *f, LoopStructure *l, LoopTree *parent)
   : forest{ f },
     loop{ l },
-    parent{ parent } {
+    parent{ parent },
+    areLookupTablesValid{ false },
+    depth{ 0 } {
 
   return;
 }
@@ -99,6 +101,15 @@ LoopStructure *LoopTree::getInnermostLoopThatContains(Instruction *i) {
 }
 
 LoopStructure *LoopTree::getInnermostLoopThatContains(BasicBlock *bb) {
+  auto n = this->getInnermostLoopNodeThatContains(bb);
+  if (n == nullptr) {
+    return nullptr;
+  }
+
+  return n->getLoop();
+}
+
+LoopTree *LoopTree::getInnermostLoopNodeThatContains(BasicBlock *bb) {
 
   /*
    * Check if the basic block is included in the current loop.
@@ -110,31 +121,85 @@ LoopStructure *LoopTree::getInnermostLoopThatContains(BasicBlock *bb) {
 
   /*
    * The basic block @bb is included.
-   * We now need to find the innermost loop that contains it.
+   * Fetch the innermost loop that contains it from the table of the tree.
+   * Since @bb belongs to @this, that loop is in the sub-tree rooted at @this.
    */
-  LoopStructure *innerLoop = nullptr;
-  uint32_t innerLoopLevel = 0;
-  auto f = [bb, &innerLoop, &innerLoopLevel](LoopTree *n,
-                                             uint32_t treeLevel) -> bool {
-    auto nl = n->getLoop();
-    if (!nl->isIncluded(bb)) {
-      return false;
-    }
-    if (innerLoop == nullptr) {
-      innerLoop = nl;
-      innerLoopLevel = treeLevel;
-      return false;
-    }
-    assert(treeLevel != innerLoopLevel);
-    if (treeLevel > innerLoopLevel) {
-      innerLoop = nl;
-      innerLoopLevel = treeLevel;
+  auto root = this->getRoot();
+  root->buildLookupTables();
+  auto n = root->innermostLoopOfBlock.at(bb);
+
+  return n;
+}
+
+LoopTree *LoopTree::getLowestCommonAncestor(LoopTree *n1, LoopTree *n2) {
+  this->getRoot()->buildLookupTables();
+
+  /*
+   * Bring the deeper node to the depth of the other one.
+   */
+  while (n1->depth > n2->depth) {
+    n1 = n1->parent;
+  }
+  while (n2->depth > n1->depth) {
+    n2 = n2->parent;
+  }
+
+  /*
+   * Walk up the two nodes until they meet.
+   */
+  while (n1 != n2) {
+    n1 = n1->parent;
+    n2 = n2->parent;
+  }
+  assert(n1 != nullptr);
+
+  return n1;
+}
+
+LoopTree *LoopTree::getRoot(void) {
+  auto n = this;
+  while (n->parent != nullptr) {
+    n = n->parent;
+  }
+
+  return n;
+}
+
+void LoopTree::buildLookupTables(void) {
+  assert(this->parent == nullptr);
+  if (this->areLookupTablesValid) {
+    return;
+  }
+  this->innermostLoopOfBlock.clear();
+
+  /*
+   * Visit the tree in pre-order.
+   * Inner loops are visited after the loops that contain them, so they
+   * override the basic blocks they share with them.
+   */
+  auto f = [this](LoopTree *n, uint32_t treeLevel) -> bool {
+    n->depth = treeLevel - 1;
+    for (auto bb : n->getLoop()->getBasicBlocks()) {
+      this->innermostLoopOfBlock[bb] = n;
     }
     return false;
   };
   this->visitPreOrder(f);
+  this->areLookupTablesValid = true;
+
+  return;
+}
 
-  return innerLoop;
+void LoopTree::invalidateLookupTables(void) {
+
+  /*
+   * The tree that includes @this has changed.
+   */
+  auto root = this->getRoot();
+  root->areLookupTablesValid = false;
+  root->innermostLoopOfBlock.clear();
+
+  return;
 }
 
 LoopStructure *LoopTree::getOutermostLoopThatContains(Instruction *i) {
@@ -299,6 +364,7 @@ LoopTree::~LoopTree() {
      */
     assert(this->parent->children.find(this) != this->parent->children.end());
     this->parent->children.erase(this);
+    this->parent->invalidateLookupTables();
 
     /*
      * Add the children of @this as immediate children to the parent.
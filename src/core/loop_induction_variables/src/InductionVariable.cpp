@@ -87,7 +87,7 @@ InductionVariable::InductionVariable(
   /*
    * Fetch initial value of induction variable
    */
-  auto bbs = LS->getBasicBlocks();
+  auto &bbs = LS->getBasicBlocks();
   for (auto i = 0u; i < loopEntryPHI->getNumIncomingValues(); ++i) {
     auto incomingBB = loopEntryPHI->getIncomingBlock(i);
     if (bbs.find(incomingBB) == bbs.end()) {
@@ -300,8 +300,6 @@ void InductionVariable::collectValuesInternalAndExternalToLoopAndSCC(
     LoopStructure *LS,
     LoopEnvironment &loopEnvironment) {
 
-  auto bbs = LS->getBasicBlocks();
-
   /*
    * Values internal to the IV's SCC are in scope but should
    * NOT be referenced when computing the IV's step value
@@ -26,6 +26,42 @@
 
 namespace arcana::noelle {
 
+/*
+ * Iterator over the instructions that currently belong to a list of basic
+ * blocks, basic block by basic block.
+ * The instructions are read from the basic blocks while iterating, so no
+ * memory is allocated. The basic block being visited must not be changed
+ * while iterating over it.
+ */
+class LoopInstructionIterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Instruction *;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Instruction **;
+  using reference = Instruction *;
+
+  LoopInstructionIterator(ArrayRef<BasicBlock *>::iterator bb,
+                          ArrayRef<BasicBlock *>::iterator bbEnd);
+
+  Instruction *operator*(void) const;
+
+  LoopInstructionIterator &operator++(void);
+
+  LoopInstructionIterator operator++(int);
+
+  bool operator==(const LoopInstructionIterator &other) const;
+
+  bool operator!=(const LoopInstructionIterator &other) const;
+
+private:
+  ArrayRef<BasicBlock *>::iterator bb;
+  ArrayRef<BasicBlock *>::iterator bbEnd;
+  BasicBlock::iterator inst;
+
+  void skipEmptyBasicBlocks(void);
+};
+
 class LoopStructure {
 public:
   LoopStructure(Loop *l);
@@ -57,11 +93,20 @@ public:
    */
   uint32_t getNestingLevel(void) const;
 
-  std::unordered_set<BasicBlock *> getLatches(void) const;
+  const std::unordered_set<BasicBlock *> &getLatches(void) const;
 
-  std::unordered_set<BasicBlock *> getBasicBlocks(void) const;
+  const std::unordered_set<BasicBlock *> &getBasicBlocks(void) const;
 
-  std::unordered_set<Instruction *> getInstructions(void) const;
+  /*
+   * Return the basic blocks of the loop starting from the header.
+   */
+  ArrayRef<BasicBlock *> getOrderedBasicBlocks(void) const;
+
+  /*
+   * Return the instructions that currently belong to the basic blocks of the
+   * loop, basic block by basic block following getOrderedBasicBlocks().
+   */
+  iterator_range<LoopInstructionIterator> getInstructions(void) const;
 
   uint64_t getNumberOfInstructions(void) const;
 
@@ -89,6 +134,7 @@ private:
   std::unordered_set<Instruction *> invariants;
   std::unordered_set<BasicBlock *> latchBBs;
   std::unordered_set<BasicBlock *> bbs;
+  std::vector<BasicBlock *> orderedBBs;
 
   /*
    * Certain parallelization schemes rely on indexing exit blocks, so some
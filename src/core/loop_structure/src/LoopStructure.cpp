@@ -49,6 +49,7 @@ LoopStructure::LoopStructure(Loop *l) {
   for (auto bb : l->blocks()) {
     // NOTE: Unsure if this is program forward order
     this->bbs.insert(bb);
+    this->orderedBBs.push_back(bb);
     if (l->isLoopLatch(bb)) {
       latchBBs.insert(bb);
     }
@@ -119,23 +120,27 @@ uint32_t LoopStructure::getNestingLevel(void) const {
   return this->depth;
 }
 
-std::unordered_set<BasicBlock *> LoopStructure::getLatches(void) const {
+const std::unordered_set<BasicBlock *> &LoopStructure::getLatches(
+    void) const {
   return this->latchBBs;
 }
 
-std::unordered_set<BasicBlock *> LoopStructure::getBasicBlocks(void) const {
+const std::unordered_set<BasicBlock *> &LoopStructure::getBasicBlocks(
+    void) const {
   return this->bbs;
 }
 
-std::unordered_set<Instruction *> LoopStructure::getInstructions(void) const {
-  std::unordered_set<Instruction *> insts{};
-  for (auto bb : this->bbs) {
-    for (auto &inst : *bb) {
-      insts.insert(&inst);
-    }
-  }
+ArrayRef<BasicBlock *> LoopStructure::getOrderedBasicBlocks(void) const {
+  return this->orderedBBs;
+}
 
-  return insts;
+iterator_range<LoopInstructionIterator> LoopStructure::getInstructions(
+    void) const {
+  ArrayRef<BasicBlock *> blocks = this->orderedBBs;
+  LoopInstructionIterator begin(blocks.begin(), blocks.end());
+  LoopInstructionIterator end(blocks.end(), blocks.end());
+
+  return make_range(begin, end);
 }
 
 uint64_t LoopStructure::getNumberOfInstructions(void) const {
@@ -277,4 +282,73 @@ uint64_t LoopStructure::numberOfExitBasicBlocks(void) const {
   return this->exitBlocks.size();
 }
 
+LoopInstructionIterator::LoopInstructionIterator(
+    ArrayRef<BasicBlock *>::iterator bb,
+    ArrayRef<BasicBlock *>::iterator bbEnd)
+  : bb{ bb },
+    bbEnd{ bbEnd },
+    inst{} {
+  if (this->bb != this->bbEnd) {
+    this->inst = (*this->bb)->begin();
+    this->skipEmptyBasicBlocks();
+  }
+
+  return;
+}
+
+Instruction *LoopInstructionIterator::operator*(void) const {
+  assert(this->bb != this->bbEnd);
+
+  return &*this->inst;
+}
+
+LoopInstructionIterator &LoopInstructionIterator::operator++(void) {
+  assert(this->bb != this->bbEnd);
+  ++this->inst;
+  this->skipEmptyBasicBlocks();
+
+  return *this;
+}
+
+LoopInstructionIterator LoopInstructionIterator::operator++(int) {
+  auto previous = *this;
+  ++(*this);
+
+  return previous;
+}
+
+bool LoopInstructionIterator::operator==(
+    const LoopInstructionIterator &other) const {
+  if (this->bb != other.bb) {
+    return false;
+  }
+  if (this->bb == this->bbEnd) {
+    return true;
+  }
+
+  return this->inst == other.inst;
+}
+
+bool LoopInstructionIterator::operator!=(
+    const LoopInstructionIterator &other) const {
+  return !(*this == other);
+}
+
+void LoopInstructionIterator::skipEmptyBasicBlocks(void) {
+
+  /*
+   * Move to the first instruction of the next basic block when the end of the
+   * current one has been reached.
+   */
+  while (this->inst == (*this->bb)->end()) {
+    ++this->bb;
+    if (this->bb == this->bbEnd) {
+      return;
+    }
+    this->inst = (*this->bb)->begin();
+  }
+
+  return;
+}
+
 } // namespace arcana::noelle
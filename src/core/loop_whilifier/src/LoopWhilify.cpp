@@ -981,7 +981,7 @@ WhilifierContext::WhilifierContext(LoopStructure *const LS)
   /*
    * Record latch info
    */
-  auto Latches = LS->getLatches();
+  auto &Latches = LS->getLatches();
   OriginalLatch = *(Latches.begin());
   NumLatches = Latches.size();
 
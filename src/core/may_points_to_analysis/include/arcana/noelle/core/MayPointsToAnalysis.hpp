@@ -42,10 +42,14 @@ public:
 
   bool mayBePointedByUnknown(Value *memobj);
   bool mayBePointedByReturnValue(Value *memobj);
+  bool mayBePointedByOtherCandidates(GlobalVariable *globalVar);
   std::unordered_set<Value *> getPointeeMemobjs(Value *ptr);
 
   void doMayPointsToAnalysis(void);
   void doMayPointsToAnalysisFor(GlobalVariable *globalVar);
+  void doMayPointsToAnalysisFor(
+      const std::unordered_set<GlobalVariable *> &globalVars);
+  std::unordered_set<GlobalVariable *> getPrivatizationCandidates(void);
   void clearPointsToSummary(void);
 
 private:
@@ -72,7 +76,7 @@ private:
    *
    * 1. The memory object is represented by (1) the AllocaInst or malloc/calloc
    * instrucions in the current function that allocates it, or (2) the
-   * privatizeCandidate.
+   * privatizeCandidates.
    *
    * 2. Besides, we have a "unknown" memory object, which is a summary of all
    * memory objects not allocated in the current function. The "unknown" memory
@@ -99,6 +103,21 @@ private:
    * pointee memory objects.
    */
   std::unordered_map<NodeID, BitVector> pointsTo;
+  uint32_t ptsBitVectorSize = 0;
+
+  /*
+   * Nodes of a cycle of copy edges have the same points-to set, hence they are
+   * collapsed into a single representative node while solving the worklist.
+   * Only representatives have points-to sets, copy edges, and uses.
+   */
+  std::vector<NodeID> representatives;
+  std::set<std::pair<NodeID, NodeID>> checkedCopyEdges;
+
+  /*
+   * The part of the points-to set of a node that has already been propagated
+   * through its copy edges and uses.
+   */
+  std::unordered_map<NodeID, BitVector> propagatedPts;
 
   /*
    * A copy edge (src => dest) means that dest may point to the same memory
@@ -130,6 +149,13 @@ private:
    */
   std::unordered_set<NodeID> usedAsFuncArg;
 
+  /*
+   * Memory objects pointed directly or indirectly by pointers in usedAsFuncArg,
+   * and the nodes whose pointees escape (see handleFuncUsers()).
+   */
+  BitVector escapedMemobjs;
+  std::unordered_set<NodeID> escapingNodes;
+
   /*
    * privatizeCandidate is a global variable that we want to privatize into the
    * current function. "Privatize" means we want to transform the global
@@ -166,8 +192,24 @@ private:
    * AllocaInst transfromed from privatizeCandidate will not escape. The false
    * reult doesn't mean it's safe to privatize the global variable because we
    * must check more things.
+   *
+   * Several candidates can be analyzed with a single solve. Each of them gets
+   * its own memory object, which also points to everything the "unknown"
+   * memory object points to: when another candidate is analyzed, that memory
+   * object would be the "unknown" one. Hence a candidate is also considered
+   * escaping if its memory object may be pointed directly or indirectly by the
+   * memory object of another candidate (see mayBePointedByOtherCandidates()).
+   * The result is conservative with respect to analyzing the candidates one at
+   * a time.
+   */
+  std::unordered_set<GlobalVariable *> privatizeCandidates;
+
+  /*
+   * For every memory object, the number of memory objects of the candidates
+   * that point to it directly or indirectly.
    */
-  GlobalVariable *privatizeCandidate = nullptr;
+  std::unordered_map<NodeID, uint32_t> numberOfCandidatesReaching;
+  std::unordered_set<NodeID> selfReachingCandidates;
 
   std::queue<NodeID> worklist;
 
@@ -176,17 +218,24 @@ private:
   std::unordered_set<Value *> getAllocations(void);
   NodeID getPtrId(Value *v);
   bool addCopyEdge(NodeID src, NodeID dst);
+  void addCopyEdgeAndPropagate(NodeID src, NodeID dst);
+  NodeID getRep(NodeID nodeId);
+  BitVector &getPts(NodeID repId);
 
   void initPtInfo(void);
   void solveWorklist(void);
 
-  void handleLoadStore(NodeID ptrId);
-  void handleFuncUsers(NodeID ptrId);
-  void handleCopyEdges(NodeID srcId);
+  void handleLoadStore(NodeID ptrId, const BitVector &delta);
+  void handleFuncUsers(NodeID ptrId, const BitVector &delta);
+  void markEscaped(NodeID memobjId);
+  void handleCopyEdges(NodeID srcId, const BitVector &delta);
+  void collapseCyclesFrom(NodeID rootId);
+  void collapse(const std::vector<NodeID> &scc);
 
   BitVector getPointeeBitVector(NodeID nodeId);
   std::unordered_set<NodeID> getreachableMemobjIds(NodeID ptrId);
-  bool unionPts(NodeID srcId, NodeID dstId);
+  void computeReachabilityFromCandidates(void);
+  bool unionPts(const BitVector &srcPts, NodeID dstId);
 };
 
 class MayPointsToAnalysis {
@@ -196,14 +245,53 @@ public:
   bool mayAlias(Value *ptr1, Value *ptr2);
   bool mayEscape(Instruction *inst);
   bool notPrivatizable(GlobalVariable *globalVar, Function *currentF);
+
+  /*
+   * By default, notPrivatizable() answers for all global variables used by a
+   * function with a single solve of the points-to graph of that function.
+   * The answers are conservative: a global variable that is privatizable when
+   * analyzed alone may be reported as not privatizable.
+   * Disabling the joint analysis checks every global variable alone and drops
+   * the answers computed so far.
+   * The analysis is shared, so clients that disable it must enable it again
+   * when they are done.
+   */
+  void enableJointPrivatizationAnalysis(void);
+  void disableJointPrivatizationAnalysis(void);
   std::unordered_set<Value *> getPointees(Value *ptr, Function *currentF);
 
+  /*
+   * Summaries of functions are kept across queries.
+   * Queries compute the summaries they need.
+   * computeSummaries() computes the missing summaries of @functions up front,
+   * using @numberOfWorkers threads.
+   * The summary of a function must be invalidated when its code changes.
+   */
+  void computeSummaries(const std::vector<Function *> &functions,
+                        uint32_t numberOfWorkers);
+  void invalidateSummaryOf(Function *currentF);
+  void invalidateSummaries(void);
+
   ~MayPointsToAnalysis();
 
 private:
   std::unordered_map<Function *, MpaSummary *> functionSummaries;
 
+  /*
+   * Checking a privatization candidate changes the points-to graph of a
+   * summary, so these checks use their own summaries.
+   * Only their points-to graphs are computed again for every check.
+   */
+  std::unordered_map<Function *, MpaSummary *> privatizationSummaries;
+
+  bool jointPrivatizationAnalysis = true;
+  std::unordered_map<Function *, std::unordered_map<GlobalVariable *, bool>>
+      notPrivatizableResults;
+
+  bool notPrivatizableJointly(GlobalVariable *globalVar, Function *currentF);
+
   MpaSummary *getFunctionSummary(Function *currentF);
+  MpaSummary *getPrivatizationSummary(Function *currentF);
 };
 
 } // namespace arcana::noelle
@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
+#include "arcana/noelle/core/WorkStealingPool.hpp"
 #include "MpaUtils.hpp"
 
 namespace arcana::noelle {
@@ -93,7 +94,11 @@ bool MayPointsToAnalysis::mayEscape(Instruction *inst) {
 
 bool MayPointsToAnalysis::notPrivatizable(GlobalVariable *globalVar,
                                           Function *currentF) {
-  auto funcSum = getFunctionSummary(currentF);
+  if (jointPrivatizationAnalysis) {
+    return notPrivatizableJointly(globalVar, currentF);
+  }
+
+  auto funcSum = getPrivatizationSummary(currentF);
   funcSum->doMayPointsToAnalysisFor(globalVar);
 
   auto result = funcSum->mayBePointedByUnknown(globalVar)
@@ -102,6 +107,50 @@ bool MayPointsToAnalysis::notPrivatizable(GlobalVariable *globalVar,
   return result;
 }
 
+void MayPointsToAnalysis::enableJointPrivatizationAnalysis(void) {
+  jointPrivatizationAnalysis = true;
+}
+
+void MayPointsToAnalysis::disableJointPrivatizationAnalysis(void) {
+  jointPrivatizationAnalysis = false;
+  notPrivatizableResults.clear();
+}
+
+bool MayPointsToAnalysis::notPrivatizableJointly(GlobalVariable *globalVar,
+                                                 Function *currentF) {
+  auto &results = notPrivatizableResults[currentF];
+  if (results.find(globalVar) != results.end()) {
+    return results[globalVar];
+  }
+
+  /*
+   * The global variable is not used by pointers of the current function: the
+   * joint solve did not include it.
+   */
+  auto funcSum = getPrivatizationSummary(currentF);
+  auto candidates = funcSum->getPrivatizationCandidates();
+  if (candidates.count(globalVar) == 0) {
+    funcSum->doMayPointsToAnalysisFor(globalVar);
+    results[globalVar] = funcSum->mayBePointedByUnknown(globalVar)
+                         || funcSum->mayBePointedByReturnValue(globalVar);
+    funcSum->clearPointsToSummary();
+    return results[globalVar];
+  }
+
+  /*
+   * Solve the points-to graph once for all candidates of the current function.
+   */
+  funcSum->doMayPointsToAnalysisFor(candidates);
+  for (auto candidate : candidates) {
+    results[candidate] = funcSum->mayBePointedByUnknown(candidate)
+                         || funcSum->mayBePointedByReturnValue(candidate)
+                         || funcSum->mayBePointedByOtherCandidates(candidate);
+  }
+  funcSum->clearPointsToSummary();
+
+  return results[globalVar];
+}
+
 std::unordered_set<Value *> MayPointsToAnalysis::getPointees(
     Value *ptr,
     Function *currentF) {
@@ -111,11 +160,76 @@ std::unordered_set<Value *> MayPointsToAnalysis::getPointees(
   return funcSum->getPointeeMemobjs(ptr);
 }
 
-MayPointsToAnalysis::~MayPointsToAnalysis() {
+void MayPointsToAnalysis::computeSummaries(
+    const std::vector<Function *> &functions,
+    uint32_t numberOfWorkers) {
+
+  /*
+   * Fetch the functions without a summary.
+   */
+  std::vector<Function *> missing;
+  for (auto f : functions) {
+    if (f->empty()) {
+      continue;
+    }
+    if (functionSummaries.find(f) != functionSummaries.end()) {
+      continue;
+    }
+    missing.push_back(f);
+  }
+
+  /*
+   * Summaries of different functions are independent, so they can be computed
+   * in parallel.
+   */
+  std::vector<MpaSummary *> summaries(missing.size(), nullptr);
+  auto computeSummary = [&missing, &summaries](uint64_t taskID, uint32_t) {
+    auto funcSum = new MpaSummary(missing[taskID]);
+    funcSum->doMayPointsToAnalysis();
+    summaries[taskID] = funcSum;
+  };
+  if (numberOfWorkers > 1) {
+    WorkStealingPool pool{ numberOfWorkers };
+    pool.run(missing.size(), computeSummary);
+  } else {
+    for (auto i = 0u; i < missing.size(); i++) {
+      computeSummary(i, 0);
+    }
+  }
+
+  for (auto i = 0u; i < missing.size(); i++) {
+    functionSummaries[missing[i]] = summaries[i];
+  }
+}
+
+void MayPointsToAnalysis::invalidateSummaryOf(Function *currentF) {
+  auto it = functionSummaries.find(currentF);
+  if (it != functionSummaries.end()) {
+    delete it->second;
+    functionSummaries.erase(it);
+  }
+  auto privatizationIt = privatizationSummaries.find(currentF);
+  if (privatizationIt != privatizationSummaries.end()) {
+    delete privatizationIt->second;
+    privatizationSummaries.erase(privatizationIt);
+  }
+  notPrivatizableResults.erase(currentF);
+}
+
+void MayPointsToAnalysis::invalidateSummaries(void) {
   for (auto &[f, funcSum] : functionSummaries) {
     delete funcSum;
   }
   functionSummaries.clear();
+  for (auto &[f, funcSum] : privatizationSummaries) {
+    delete funcSum;
+  }
+  privatizationSummaries.clear();
+  notPrivatizableResults.clear();
+}
+
+MayPointsToAnalysis::~MayPointsToAnalysis() {
+  invalidateSummaries();
 }
 
 MpaSummary *MayPointsToAnalysis::getFunctionSummary(Function *currentF) {
@@ -125,4 +239,11 @@ MpaSummary *MayPointsToAnalysis::getFunctionSummary(Function *currentF) {
   return functionSummaries[currentF];
 }
 
+MpaSummary *MayPointsToAnalysis::getPrivatizationSummary(Function *currentF) {
+  if (privatizationSummaries.find(currentF) == privatizationSummaries.end()) {
+    privatizationSummaries[currentF] = new MpaSummary(currentF);
+  }
+  return privatizationSummaries[currentF];
+}
+
 } // namespace arcana::noelle
@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
+#include "arcana/noelle/core/StronglyConnectedComponents.hpp"
 #include "MpaUtils.hpp"
 
 using namespace std;
@@ -173,14 +174,81 @@ bool MpaSummary::mayBePointedByReturnValue(Value *memobj) {
   return false;
 }
 
+bool MpaSummary::mayBePointedByOtherCandidates(GlobalVariable *globalVar) {
+  assert(mpaFinished);
+  assert(privatizeCandidates.count(globalVar) > 0);
+  auto memobjId = memobj2nodeId.at(globalVar);
+
+  computeReachabilityFromCandidates();
+  auto it = numberOfCandidatesReaching.find(memobjId);
+  if (it == numberOfCandidatesReaching.end()) {
+    return false;
+  }
+
+  /*
+   * Do not count the memory object of @globalVar pointing to itself.
+   */
+  auto reachingCandidates = it->second;
+  if (selfReachingCandidates.count(memobjId) > 0) {
+    reachingCandidates--;
+  }
+  return reachingCandidates > 0;
+}
+
+void MpaSummary::computeReachabilityFromCandidates(void) {
+  if (!numberOfCandidatesReaching.empty()) {
+    return;
+  }
+
+  for (auto candidate : privatizeCandidates) {
+    auto candidateId = memobj2nodeId.at(candidate);
+    for (auto memobjId : getreachableMemobjIds(candidateId)) {
+      numberOfCandidatesReaching[memobjId]++;
+      if (memobjId == candidateId) {
+        selfReachingCandidates.insert(memobjId);
+      }
+    }
+  }
+}
+
 BitVector MpaSummary::getPointeeBitVector(NodeID nodeId) {
-  if (pointsTo.find(nodeId) != pointsTo.end()) {
-    return pointsTo[nodeId];
+  auto repId = getRep(nodeId);
+  if (pointsTo.find(repId) != pointsTo.end()) {
+    return pointsTo[repId];
   } else {
     return getEmptyBitVector();
   }
 }
 
+BitVector &MpaSummary::getPts(NodeID repId) {
+  auto it = pointsTo.find(repId);
+  if (it == pointsTo.end()) {
+    it = pointsTo.emplace(repId, getEmptyBitVector()).first;
+  }
+  return it->second;
+}
+
+NodeID MpaSummary::getRep(NodeID nodeId) {
+  if (nodeId >= representatives.size()) {
+    return nodeId;
+  }
+
+  auto repId = nodeId;
+  while (representatives[repId] != repId) {
+    repId = representatives[repId];
+  }
+
+  /*
+   * Compress the path from @nodeId to its representative.
+   */
+  while (representatives[nodeId] != repId) {
+    auto nextId = representatives[nodeId];
+    representatives[nodeId] = repId;
+    nodeId = nextId;
+  }
+  return repId;
+}
+
 unordered_set<NodeID> MpaSummary::getreachableMemobjIds(NodeID ptrId) {
   unordered_set<NodeID> reachable;
   queue<NodeID> todolist;
@@ -202,8 +270,10 @@ unordered_set<NodeID> MpaSummary::getreachableMemobjIds(NodeID ptrId) {
 }
 
 BitVector MpaSummary::getEmptyBitVector(void) {
-  auto bitVecSize = 1 + getAllocations().size();
-  return BitVector(bitVecSize, false);
+  if (ptsBitVectorSize == 0) {
+    ptsBitVectorSize = 1 + getAllocations().size();
+  }
+  return BitVector(ptsBitVectorSize, false);
 }
 
 BitVector MpaSummary::onlyPointsTo(NodeID memobjId) {
@@ -224,8 +294,8 @@ unordered_set<Value *> MpaSummary::getAllocations(void) {
   for (auto &callocInst : callocInsts) {
     allocations.insert(callocInst);
   }
-  if (privatizeCandidate) {
-    allocations.insert(privatizeCandidate);
+  for (auto candidate : privatizeCandidates) {
+    allocations.insert(candidate);
   }
   return allocations;
 }
@@ -241,9 +311,30 @@ NodeID MpaSummary::getPtrId(Value *v) {
 }
 
 bool MpaSummary::addCopyEdge(NodeID src, NodeID dst) {
+  src = getRep(src);
+  dst = getRep(dst);
+  if (src == dst) {
+    return false;
+  }
   return copyOutEdges[src].insert(dst).second;
 }
 
+void MpaSummary::addCopyEdgeAndPropagate(NodeID src, NodeID dst) {
+  if (!addCopyEdge(src, dst)) {
+    return;
+  }
+
+  /*
+   * The points-to info already propagated out of @src did not go through the
+   * new edge, so the whole points-to set of @src is copied now.
+   */
+  src = getRep(src);
+  dst = getRep(dst);
+  if (unionPts(getPts(src), dst)) {
+    worklist.push(dst);
+  }
+}
+
 void MpaSummary::doMayPointsToAnalysis(void) {
   if (!mpaFinished) {
     initPtInfo();
@@ -254,14 +345,40 @@ void MpaSummary::doMayPointsToAnalysis(void) {
 
 void MpaSummary::doMayPointsToAnalysisFor(GlobalVariable *globalVar) {
   clearPointsToSummary();
-  privatizeCandidate = globalVar;
+  privatizeCandidates.insert(globalVar);
+  doMayPointsToAnalysis();
+}
+
+void MpaSummary::doMayPointsToAnalysisFor(
+    const unordered_set<GlobalVariable *> &globalVars) {
+  clearPointsToSummary();
+  privatizeCandidates = globalVars;
   doMayPointsToAnalysis();
 }
 
+unordered_set<GlobalVariable *> MpaSummary::getPrivatizationCandidates(void) {
+  unordered_set<GlobalVariable *> candidates;
+  for (auto ptr : pointers) {
+    auto globalVar = dyn_cast<GlobalVariable>(ptr);
+    if (globalVar && !globalVar->isConstant()) {
+      candidates.insert(globalVar);
+    }
+  }
+  return candidates;
+}
+
 void MpaSummary::clearPointsToSummary(void) {
-  privatizeCandidate = nullptr;
+  privatizeCandidates.clear();
+  numberOfCandidatesReaching.clear();
+  selfReachingCandidates.clear();
   mpaFinished = false;
   nextNodeId = 1;
+  ptsBitVectorSize = 0;
+  representatives.clear();
+  propagatedPts.clear();
+  checkedCopyEdges.clear();
+  escapedMemobjs.clear();
+  escapingNodes.clear();
   ptr2nodeId.clear();
   memobj2nodeId.clear();
   nodeId2memobj.clear();
@@ -282,8 +399,8 @@ void MpaSummary::initPtInfo(void) {
    * MayPointsToAnalysis.hpp).
    * 2. For each memory object allocated by alloca/malloc/calloc, assign a
    * unique NodeID.
-   * 3. If a global variable is privatizeCandidate, its memory objecg will also
-   * be assigned a unique NodeID.
+   * 3. If a global variable is in privatizeCandidates, its memory objecg will
+   * also be assigned a unique NodeID.
    */
   nodeId2memobj[UnknownMemobjId] = nullptr;
   memobj2nodeId[nullptr] = UnknownMemobjId;
@@ -309,8 +426,10 @@ void MpaSummary::initPtInfo(void) {
    *     in the current function.
    * (4) Similarly, global variables and the callInsts will also point to the
    *     "unknown" memory object.
-   * (5) PrivatizeCandidate will points to its own memory object instead of the
-   *     "unknown" memory object (see MayPointsToAnalysis.hpp).
+   * (5) PrivatizeCandidates will points to their own memory object instead of
+   *     the "unknown" memory object (see MayPointsToAnalysis.hpp).
+   *     When there are several candidates, the "unknown" memory object has a
+   *     copy edge to the memory object of each of them.
    *
    * 3. Add copy edges for pointers and memory objects.
    * (1) Copy edges between pointers can be added through PHINode, SelectInst,
@@ -327,6 +446,12 @@ void MpaSummary::initPtInfo(void) {
    */
   pointsTo[UnknownMemobjId] = onlyPointsTo(UnknownMemobjId);
 
+  if (privatizeCandidates.size() > 1) {
+    for (auto candidate : privatizeCandidates) {
+      addCopyEdge(UnknownMemobjId, memobj2nodeId[candidate]);
+    }
+  }
+
   for (auto &ptr : pointers) {
     auto ptrId = getPtrId(ptr);
 
@@ -402,23 +527,51 @@ void MpaSummary::initPtInfo(void) {
 }
 
 void MpaSummary::solveWorklist(void) {
+
+  /*
+   * Every node starts as its own representative.
+   */
+  representatives.resize(nextNodeId);
+  for (NodeID nodeId = 0; nodeId < nextNodeId; nodeId++) {
+    representatives[nodeId] = nodeId;
+  }
+
+  /*
+   * Memory objects are visited as well because copy edges can leave them
+   * (e.g., the "unknown" memory object).
+   */
   worklist = {};
-  for (auto &[ptr, ptrId] : ptr2nodeId) {
-    worklist.push(ptrId);
+  for (NodeID nodeId = 0; nodeId < nextNodeId; nodeId++) {
+    worklist.push(nodeId);
   }
 
+  escapedMemobjs = getEmptyBitVector();
+  escapingNodes = usedAsFuncArg;
+
   while (!worklist.empty()) {
-    auto nodeID = worklist.front();
+    auto nodeID = getRep(worklist.front());
     worklist.pop();
-    handleLoadStore(nodeID);
-    handleFuncUsers(nodeID);
-    handleCopyEdges(nodeID);
+
+    /*
+     * Difference propagation: only the pointees added since the last visit of
+     * the node need to be propagated.
+     */
+    auto &pts = getPts(nodeID);
+    auto delta = pts;
+    auto propagatedIt = propagatedPts.find(nodeID);
+    if (propagatedIt != propagatedPts.end()) {
+      delta.reset(propagatedIt->second);
+    }
+    propagatedPts[nodeID] = pts;
+
+    handleLoadStore(nodeID, delta);
+    handleFuncUsers(nodeID, delta);
+    handleCopyEdges(nodeID, delta);
   }
 }
 
-void MpaSummary::handleLoadStore(NodeID ptrId) {
-  auto pointees = getPointeeBitVector(ptrId);
-  for (auto memobjId : pointees.set_bits()) {
+void MpaSummary::handleLoadStore(NodeID ptrId, const BitVector &delta) {
+  for (auto memobjId : delta.set_bits()) {
     /*
      * OutgoingLoads help us add new copy edges.
      *
@@ -435,9 +588,7 @@ void MpaSummary::handleLoadStore(NodeID ptrId) {
     if (outgoingLoads.find(ptrId) != outgoingLoads.end()) {
       for (auto loadInst : outgoingLoads[ptrId]) {
         auto destId = getPtrId(loadInst);
-        if (addCopyEdge(memobjId, destId)) {
-          worklist.push(memobjId);
-        }
+        addCopyEdgeAndPropagate(memobjId, destId);
       }
     }
 
@@ -457,16 +608,13 @@ void MpaSummary::handleLoadStore(NodeID ptrId) {
     if (incomingStores.find(ptrId) != incomingStores.end()) {
       for (auto storeInst : incomingStores[ptrId]) {
         auto srcId = getPtrId(storeInst->getValueOperand());
-        if (addCopyEdge(srcId, memobjId)) {
-          worklist.push(srcId);
-        }
+        addCopyEdgeAndPropagate(srcId, memobjId);
       }
     }
   }
 }
-
-void MpaSummary::handleFuncUsers(NodeID ptrId) {
-  if (usedAsFuncArg.find(ptrId) == usedAsFuncArg.end()) {
+void MpaSummary::handleFuncUsers(NodeID ptrId, const BitVector &delta) {
+  if (escapingNodes.find(ptrId) == escapingNodes.end()) {
     return;
   }
   /*
@@ -509,42 +657,169 @@ void MpaSummary::handleFuncUsers(NodeID ptrId) {
    *
    * Here we only handle case 1. Case 2 and 3 are already handled by
    * initPtInfo().
+   *
+   * The escaped memory objects are tracked incrementally: pointers used as
+   * arguments and escaped memory objects are escaping nodes, and every new
+   * pointee of an escaping node escapes.
    */
-  for (auto memobjId : getreachableMemobjIds(ptrId)) {
-    bool changed = false;
-    changed |= addCopyEdge(memobjId, UnknownMemobjId);
-    changed |= addCopyEdge(UnknownMemobjId, memobjId);
-    if (changed) {
-      worklist.push(memobjId);
+  for (auto memobjId : delta.set_bits()) {
+    markEscaped(memobjId);
+  }
+}
+
+void MpaSummary::markEscaped(NodeID memobjId) {
+  vector<NodeID> todolist{ memobjId };
+  while (!todolist.empty()) {
+    auto escapedId = todolist.back();
+    todolist.pop_back();
+    if (escapedMemobjs.test(escapedId)) {
+      continue;
+    }
+    escapedMemobjs.set(escapedId);
+    escapingNodes.insert(getRep(escapedId));
+
+    addCopyEdgeAndPropagate(escapedId, UnknownMemobjId);
+    addCopyEdgeAndPropagate(UnknownMemobjId, escapedId);
+
+    /*
+     * Memory objects already pointed by the escaped one escape too.
+     */
+    for (auto pointeeId : getPts(getRep(escapedId)).set_bits()) {
+      todolist.push_back(pointeeId);
     }
   }
 }
 
-void MpaSummary::handleCopyEdges(NodeID srcId) {
+void MpaSummary::handleCopyEdges(NodeID srcId, const BitVector &delta) {
   if (copyOutEdges.find(srcId) == copyOutEdges.end()) {
     return;
   }
   /*
-   * Propogate the points-to info from srcId to destId through copy edges.
-   * i.e. pts(destId) = pts(destId) U pts(srcId).
+   * Propogate the new points-to info from srcId to destId through copy edges.
+   * i.e. pts(destId) = pts(destId) U delta(srcId).
    * If pts(destId) is changed, add destId to worklist.
+   *
+   * Lazy cycle detection: a copy edge whose source and destination end up
+   * with the same points-to set may close a cycle. Nodes of a cycle always
+   * have the same points-to set, so they are collapsed into one node. Each
+   * edge triggers the detection at most once.
    */
-  for (auto &destId : copyOutEdges[srcId]) {
-    if (unionPts(srcId, destId)) {
+  std::vector<NodeID> destIds(copyOutEdges[srcId].begin(),
+                              copyOutEdges[srcId].end());
+  for (auto destId : destIds) {
+    if (getRep(srcId) != srcId) {
+      /*
+       * srcId has been collapsed and its representative will propagate the
+       * whole points-to set.
+       */
+      return;
+    }
+    destId = getRep(destId);
+    if (destId == srcId) {
+      continue;
+    }
+    if (unionPts(delta, destId)) {
       worklist.push(destId);
     }
+    if (getPts(destId) == getPts(srcId)
+        && checkedCopyEdges.insert({ srcId, destId }).second) {
+      collapseCyclesFrom(destId);
+    }
   }
 }
 
-bool MpaSummary::unionPts(NodeID srcId, NodeID dstId) {
-  BitVector oldPts = pointsTo[dstId];
-  BitVector newPts = unite(oldPts, pointsTo[srcId]);
-  if (oldPts == newPts) {
-    return false;
-  } else {
-    pointsTo[dstId] = newPts;
-    return true;
+bool MpaSummary::unionPts(const BitVector &srcPts, NodeID dstId) {
+  auto &dstPts = getPts(dstId);
+  auto oldCount = dstPts.count();
+  dstPts |= srcPts;
+  return dstPts.count() != oldCount;
+}
+
+void MpaSummary::collapseCyclesFrom(NodeID rootId) {
+
+  /*
+   * Find the strongly connected components of the copy edges reachable from
+   * rootId.
+   */
+  static const unordered_set<NodeID> noSuccessors;
+  auto successorsOf = [this](NodeID nodeId) {
+    auto it = copyOutEdges.find(nodeId);
+    auto &destIds = (it != copyOutEdges.end()) ? it->second : noSuccessors;
+    return map_range(destIds, [this](NodeID destId) { return getRep(destId); });
+  };
+  vector<vector<NodeID>> cycles;
+  forEachSCC<NodeID>(ArrayRef<NodeID>(rootId),
+                     successorsOf,
+                     [&cycles](ArrayRef<NodeID> scc) {
+                       if (scc.size() > 1) {
+                         cycles.push_back(scc.vec());
+                       }
+                     });
+
+  for (auto &scc : cycles) {
+    collapse(scc);
+  }
+}
+
+void MpaSummary::collapse(const vector<NodeID> &scc) {
+  auto repId = *std::min_element(scc.begin(), scc.end());
+
+  /*
+   * Pointers can get their NodeID while the worklist is being solved.
+   */
+  auto maxId = *std::max_element(scc.begin(), scc.end());
+  while (representatives.size() <= maxId) {
+    representatives.push_back(representatives.size());
+  }
+
+  /*
+   * Move the points-to info, the copy edges, and the uses of every node of
+   * the cycle to the representative.
+   */
+  for (auto nodeId : scc) {
+    if (nodeId == repId) {
+      continue;
+    }
+    representatives[nodeId] = repId;
+
+    if (pointsTo.find(nodeId) != pointsTo.end()) {
+      auto pts = std::move(pointsTo[nodeId]);
+      pointsTo.erase(nodeId);
+      getPts(repId) |= pts;
+    }
+    auto edgesIt = copyOutEdges.find(nodeId);
+    if (edgesIt != copyOutEdges.end()) {
+      auto destIds = std::move(edgesIt->second);
+      copyOutEdges.erase(edgesIt);
+      auto &repEdges = copyOutEdges[repId];
+      for (auto destId : destIds) {
+        repEdges.insert(destId);
+      }
+    }
+    auto storesIt = incomingStores.find(nodeId);
+    if (storesIt != incomingStores.end()) {
+      auto stores = std::move(storesIt->second);
+      incomingStores.erase(storesIt);
+      incomingStores[repId].insert(stores.begin(), stores.end());
+    }
+    auto loadsIt = outgoingLoads.find(nodeId);
+    if (loadsIt != outgoingLoads.end()) {
+      auto loads = std::move(loadsIt->second);
+      outgoingLoads.erase(loadsIt);
+      outgoingLoads[repId].insert(loads.begin(), loads.end());
+    }
+    if (escapingNodes.count(nodeId) > 0) {
+      escapingNodes.insert(repId);
+    }
+    propagatedPts.erase(nodeId);
   }
+
+  /*
+   * The representative inherits copy edges and uses whose sources have not
+   * seen its whole points-to set yet.
+   */
+  propagatedPts.erase(repId);
+  worklist.push(repId);
 }
 
 } // namespace arcana::noelle
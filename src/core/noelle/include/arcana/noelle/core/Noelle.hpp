@@ -63,8 +63,28 @@ public:
 
   void getAnalysisUsage(AnalysisUsage &AU) const override;
 
+  void releaseMemory() override;
+
   bool runOnModule(Module &M) override;
 
+  /*
+   * Keep the dependences and the other analyses of the code when the pass
+   * manager releases this pass, so they are reused when that pass manager
+   * runs again.
+   * The functions changed in between must be reported with
+   * invalidateAnalysesOf, or all analyses must be dropped with
+   * invalidateAnalyses.
+   */
+  void keepAnalysesAcrossRuns(void);
+
+  /*
+   * Report @modifiedFunctions changed while this pass was not running.
+   * Their analyses are updated when the pass manager runs this pass again.
+   */
+  void invalidateAnalysesOf(const std::set<Function *> &modifiedFunctions);
+
+  void invalidateAnalyses(void);
+
   FunctionsManager *getFunctionsManager(void);
 
   GlobalsManager *getGlobalsManager(void);
@@ -190,9 +210,24 @@ public:
 
   PDG *getProgramDependenceGraph(void);
 
+  /*
+   * Recompute the dependences of the program dependence graph that belong to
+   * @modifiedFunctions.
+   * This must be invoked after changing the code of these functions.
+   */
+  void updateProgramDependenceGraph(
+      const std::set<Function *> &modifiedFunctions);
+
+  /*
+   * Drop the function dependence graphs computed so far.
+   * This must be invoked after changing the dependences of the program
+   * dependence graph directly.
+   */
+  void invalidateFunctionDependenceGraphs(void);
+
   DataFlowAnalysis getDataFlowAnalyses(void) const;
 
-  CFGAnalysis getCFGAnalysis(void) const;
+  CFGAnalysis &getCFGAnalysis(void);
 
   CFGTransformer getCFGTransformer(void) const;
 
@@ -200,7 +235,11 @@ public:
 
   Scheduler getScheduler(void) const;
 
-  MayPointsToAnalysis getMayPointsToAnalysis(void) const;
+  /*
+   * The analysis keeps the summaries of functions across passes until the PDG
+   * is invalidated.
+   */
+  MayPointsToAnalysis &getMayPointsToAnalysis(void);
 
   LoopTransformer &getLoopTransformer(void);
 
@@ -242,8 +281,13 @@ private:
   std::unordered_set<Transformation> enabledTransformations;
   bool hoistLoopsToMain;
   bool loopAwareDependenceAnalysis;
+  bool parallelizeLoopContents;
+  bool lazyLoopContents;
+  bool keepAnalyses;
+  std::set<Function *> functionsModifiedAcrossRuns;
   PDGGenerator *pdgAnalysis;
   LDGGenerator ldgAnalysis;
+  CFGAnalysis cfgAnalysis;
   char *filterFileName;
   bool hasReadFilterFile;
   std::map<uint32_t, uint32_t> loopThreads;
@@ -257,8 +301,13 @@ private:
   MetadataManager *mm;
   Linker *linker;
   std::set<AliasAnalysisEngine *> aaEngines;
+  std::unordered_map<Function *, std::shared_ptr<PDG>> functionDependenceGraphs;
+
+  std::shared_ptr<PDG> getFunctionDependenceGraph(Function *f);
+
+  void invalidateFunctionDependenceGraph(Function *f);
 
-  PDG *getFunctionDependenceGraph(Function *f);
+  void releaseAnalysesOfCode(void);
 
   uint32_t fetchTheNextValue(std::stringstream &stream);
 
@@ -266,24 +315,37 @@ private:
 
   LoopContent *getLoopContentForLoop(
       BasicBlock *header,
-      PDG *functionPDG,
-      DominatorSummary *DS,
+      std::shared_ptr<PDG> functionPDG,
       uint32_t techniquesToDisable,
       uint32_t DOALLChunkSize,
       uint32_t maxCores,
-      std::unordered_set<LoopContentOptimization> optimizations);
+      std::unordered_set<LoopContentOptimization> optimizations,
+      bool computeAllAnalyses);
 
   LoopContent *getLoopContentForLoop(
       LoopTree *loopNode,
       Loop *loop,
-      PDG *functionPDG,
-      DominatorSummary *DS,
+      std::shared_ptr<PDG> functionPDG,
       ScalarEvolution *SE,
+      std::shared_ptr<DominatorSummary> DS,
       uint32_t techniquesToDisable,
       uint32_t DOALLChunkSize,
       uint32_t maxCores,
       std::unordered_set<LoopContentOptimization> optimizations);
 
+  LoopContentFunctionAnalyses getFunctionAnalysesOfLoop(LoopStructure *loop);
+
+  void computeLoopContents(std::vector<LoopContent *> &loops);
+
+  void computeLoopContentsInParallel(std::vector<LoopContent *> &loops);
+
+  void computeLoopContentsWithFunctionAnalyses(
+      std::vector<LoopContent *> &loops,
+      std::function<void(LoopContent *, ScalarEvolution &, Loop *)> compute);
+
+  std::vector<std::pair<Function *, std::vector<LoopContent *>>>
+  groupLoopContentsByFunction(std::vector<LoopContent *> &loops);
+
   bool isLoopHot(LoopStructure *loopStructure, double minimumHotness);
   bool isFunctionHot(Function *function, double minimumHotness);
 
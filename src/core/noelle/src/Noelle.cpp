@@ -32,9 +32,14 @@ Noelle::Noelle()
     program{ nullptr },
     profiles{ nullptr },
     programDependenceGraph{ nullptr },
+    parallelizeLoopContents{ false },
+    lazyLoopContents{ false },
+    keepAnalyses{ false },
     pdgAnalysis{ nullptr },
     ldgAnalysis{},
+    cfgAnalysis{},
     fm{ nullptr },
+    gm{ nullptr },
     tm{ nullptr },
     cm{ nullptr },
     om{ nullptr },
@@ -111,8 +116,8 @@ DataFlowAnalysis Noelle::getDataFlowAnalyses(void) const {
   return DataFlowAnalysis{};
 }
 
-CFGAnalysis Noelle::getCFGAnalysis(void) const {
-  return CFGAnalysis{};
+CFGAnalysis &Noelle::getCFGAnalysis(void) {
+  return this->cfgAnalysis;
 }
 
 CFGTransformer Noelle::getCFGTransformer(void) const {
@@ -127,8 +132,8 @@ Scheduler Noelle::getScheduler(void) const {
   return Scheduler{};
 }
 
-MayPointsToAnalysis Noelle::getMayPointsToAnalysis(void) const {
-  return MayPointsToAnalysis{};
+MayPointsToAnalysis &Noelle::getMayPointsToAnalysis(void) {
+  return this->pdgAnalysis->getMayPointsToAnalysis();
 }
 
 LoopTransformer &Noelle::getLoopTransformer(void) {
@@ -152,7 +157,98 @@ uint64_t Noelle::numberOfProgramInstructions(void) const {
   return t;
 }
 
+void Noelle::releaseMemory() {
+
+  /*
+   * Check if the analyses of the code should be kept for the next run of the
+   * pass manager.
+   */
+  if (!this->keepAnalyses) {
+    this->releaseAnalysesOfCode();
+  }
+
+  /*
+   * The profiles are owned by another pass, which might free them as well.
+   */
+  this->profiles = nullptr;
+
+  /*
+   * The code might change after this pass is invalidated.
+   * Free the managers, which cache information about the code.
+   * They are allocated again on demand.
+   */
+  delete this->fm;
+  this->fm = nullptr;
+  delete this->gm;
+  this->gm = nullptr;
+  delete this->linker;
+  this->linker = nullptr;
+  delete this->cm;
+  this->cm = nullptr;
+  delete this->tm;
+  this->tm = nullptr;
+  delete this->mm;
+  this->mm = nullptr;
+
+  return;
+}
+
+void Noelle::keepAnalysesAcrossRuns(void) {
+  this->keepAnalyses = true;
+
+  return;
+}
+
+void Noelle::invalidateAnalysesOf(
+    const std::set<Function *> &modifiedFunctions) {
+  this->functionsModifiedAcrossRuns.insert(modifiedFunctions.begin(),
+                                           modifiedFunctions.end());
+
+  return;
+}
+
+void Noelle::invalidateAnalyses(void) {
+  this->releaseAnalysesOfCode();
+  this->functionsModifiedAcrossRuns.clear();
+
+  /*
+   * Drop the dependences kept by the PDG generator as well.
+   */
+  if (this->pdgAnalysis != nullptr) {
+    this->pdgAnalysis->invalidatePDG();
+  }
+
+  return;
+}
+
+void Noelle::releaseAnalysesOfCode(void) {
+
+  /*
+   * Free the function dependence graphs.
+   * Lazy loop contents keep the ones they still need.
+   */
+  this->functionDependenceGraphs.clear();
+
+  /*
+   * The PDG is owned by another pass, which might free it as well.
+   */
+  this->programDependenceGraph = nullptr;
+
+  /*
+   * Forget the cycles of the CFGs.
+   */
+  this->cfgAnalysis.invalidateCycles();
+
+  return;
+}
+
 Noelle::~Noelle() {
+  this->releaseMemory();
+
+  /*
+   * The compilation options are created once by doInitialization.
+   */
+  delete this->om;
 
   return;
 }
@@ -31,7 +31,84 @@ PDG *Noelle::getProgramDependenceGraph(void) {
   return this->programDependenceGraph;
 }
 
-PDG *Noelle::getFunctionDependenceGraph(Function *f) {
+void Noelle::updateProgramDependenceGraph(
+    const std::set<Function *> &modifiedFunctions) {
+
+  /*
+   * The calls of the modified functions may have changed, so the snapshot of
+   * the call graph is not valid anymore.
+   */
+  if (this->fm != nullptr) {
+    this->fm->invalidateProgramCallGraphSnapshot();
+  }
+
+  /*
+   * The cycles of the CFGs of the modified functions are not valid anymore.
+   */
+  for (auto function : modifiedFunctions) {
+    this->cfgAnalysis.invalidateCycles(function);
+  }
+
+  /*
+   * Update the dependences of the modified functions and of their callers.
+   * This also drops the may-points-to summaries of the modified functions,
+   * which exist even if the PDG has not been computed.
+   */
+  auto updatedFunctions = this->pdgAnalysis->updatePDG(modifiedFunctions);
+
+  /*
+   * Check if the PDG has been computed.
+   * If it hasn't, it will be computed from the current code when requested.
+   */
+  if (this->programDependenceGraph == nullptr) {
+    return;
+  }
+
+  /*
+   * The function dependence graphs of the updated functions are not valid
+   * anymore.
+   */
+  for (auto function : updatedFunctions) {
+    this->invalidateFunctionDependenceGraph(function);
+  }
+
+  return;
+}
+
+void Noelle::invalidateFunctionDependenceGraphs(void) {
+  this->functionDependenceGraphs.clear();
+
+  return;
+}
+
+void Noelle::invalidateFunctionDependenceGraph(Function *f) {
+
+  /*
+   * Check if the FDG of @f has been computed.
+   */
+  auto it = this->functionDependenceGraphs.find(f);
+  if (it == this->functionDependenceGraphs.end()) {
+    return;
+  }
+
+  /*
+   * Lazy loop contents that have not taken their dependences from the FDG yet
+   * keep it alive, so it is only dropped from the cache here.
+   */
+  this->functionDependenceGraphs.erase(it);
+
+  return;
+}
+
+std::shared_ptr<PDG> Noelle::getFunctionDependenceGraph(Function *f) {
+
+  /*
+   * Check if the function dependence graph (FDG) has already been computed.
+   */
+  auto it = this->functionDependenceGraphs.find(f);
+  if (it != this->functionDependenceGraphs.end()) {
+    return it->second;
+  }
 
   /*
    * Get the PDG
@@ -40,9 +117,10 @@ PDG *Noelle::getFunctionDependenceGraph(Function *f) {
   auto pdg = this->getProgramDependenceGraph();
 
   /*
-   * Create the function dependence graph (FDG).
+   * Create the FDG.
    */
-  auto fdg = pdg->createFunctionSubgraph(*f);
+  std::shared_ptr<PDG> fdg(pdg->createFunctionSubgraph(*f));
+  this->functionDependenceGraphs[f] = fdg;
 
   return fdg;
 }
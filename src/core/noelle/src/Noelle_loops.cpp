@@ -26,6 +26,7 @@
 #include "arcana/noelle/core/Noelle.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
 #include "arcana/noelle/core/Architecture.hpp"
+#include "arcana/noelle/core/WorkStealingPool.hpp"
 #include "arcana/noelle/core/LoopForest.hpp"
 #include "arcana/noelle/core/HotProfiler.hpp"
 
@@ -364,13 +365,11 @@ LoopContent *Noelle::getLoopContent(
     std::unordered_set<LoopContentOptimization> optimizations) {
 
   /*
-   * Fetch the the function dependence graph, post dominators, and scalar
-   * evolution
+   * Fetch the the function dependence graph.
    */
   auto header = loop->getHeader();
   auto function = header->getParent();
   auto funcPDG = this->getFunctionDependenceGraph(function);
-  auto DS = this->getDominators(function);
 
   /*
    * No filter file was provided. Construct LDI without profiler configurables
@@ -378,13 +377,12 @@ LoopContent *Noelle::getLoopContent(
   if (!this->hasReadFilterFile) {
     auto ldi = this->getLoopContentForLoop(header,
                                            funcPDG,
-                                           DS,
                                            0,
                                            8,
                                            this->om->getMaximumNumberOfCores(),
-                                           optimizations);
+                                           optimizations,
+                                           !this->lazyLoopContents);
 
-    delete DS;
     return ldi;
   }
 
@@ -399,13 +397,12 @@ LoopContent *Noelle::getLoopContent(
   auto ldi =
       this->getLoopContentForLoop(header,
                                   funcPDG,
-                                  DS,
                                   this->techniquesToDisable[loopIndex],
                                   this->DOALLChunkSize[loopIndex],
                                   maximumNumberOfCoresForTheParallelization,
-                                  optimizations);
+                                  optimizations,
+                                  !this->lazyLoopContents);
 
-  delete DS;
   return ldi;
 }
 
@@ -414,12 +411,6 @@ LoopContent *Noelle::getLoopContent(BasicBlock *header,
                                     LoopTransformationsManager *ltm,
                                     bool enableLoopAwareDependenceAnalysis) {
 
-  /*
-   * Get the dominators.
-   */
-  auto function = header->getParent();
-  auto DS = this->getDominators(function);
-
   /*
    * Set the parallelizations that are enabled.
    */
@@ -458,14 +449,17 @@ LoopContent *Noelle::getLoopContent(BasicBlock *header,
 
   /*
    * Fetch the loop content.
+   * @functionPDG is owned by the caller, so all sub-analyses are computed
+   * before returning.
    */
+  std::shared_ptr<PDG> callerPDG(functionPDG, [](PDG *) {});
   auto ldi = this->getLoopContentForLoop(header,
-                                         functionPDG,
-                                         DS,
+                                         callerPDG,
                                          techniquesToDisable,
                                          ltm->getChunkSize(),
                                          ltm->getMaximumNumberOfCores(),
-                                         ltm->getOptimizationsEnabled());
+                                         ltm->getOptimizationsEnabled(),
+                                         true);
 
   /*
    * Check if we need to re-enable the loop-centric dependence analysis.
@@ -518,11 +512,6 @@ std::vector<LoopContent *> *Noelle::getLoopContents(Function *function,
    */
   auto funcPDG = this->getFunctionDependenceGraph(function);
 
-  /*
-   * Fetch the post dominators
-   */
-  auto DS = this->getDominators(function);
-
   /*
    * Fetch all loops of the current function.
    */
@@ -561,6 +550,12 @@ std::vector<LoopContent *> *Noelle::getLoopContents(Function *function,
    */
   auto forest = this->organizeLoopsInTheirNestingForest(loopStructures);
 
+  /*
+   * Compute the dominators of the function.
+   * They are shared by the loops of the function.
+   */
+  std::shared_ptr<DominatorSummary> DS(this->getDominators(function));
+
   /*
    * Allocate the loop wrapper.
    */
@@ -582,17 +577,21 @@ std::vector<LoopContent *> *Noelle::getLoopContents(Function *function,
                                  funcPDG,
                                  loopNode,
                                  llvmLoop,
-                                 *DS,
                                  SE,
-                                 this->om->getMaximumNumberOfCores());
+                                 DS,
+                                 this->getFunctionAnalysesOfLoop(ls),
+                                 this->om->getMaximumNumberOfCores(),
+                                 {},
+                                 true,
+                                 8);
       allLoops->push_back(ldi);
     }
   }
 
   /*
-   * Free the memory.
+   * Compute the sub-analyses of the loops.
    */
-  delete DS;
+  this->computeLoopContents(*allLoops);
 
   return allLoops;
 }
@@ -667,9 +666,14 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
     auto funcPDG = this->getFunctionDependenceGraph(function);
 
     /*
-     * Fetch the post dominators and scalar evolutions
+     * Compute the dominators of the function.
+     * They are shared by the loops of the function.
+     */
+    std::shared_ptr<DominatorSummary> DS(this->getDominators(function));
+
+    /*
+     * Fetch the scalar evolutions
      */
-    auto DS = this->getDominators(function);
     auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
 
     /*
@@ -787,9 +791,13 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
                                 funcPDG,
                                 loopNode,
                                 LLVMLoop,
-                                *DS,
                                 SE,
-                                this->om->getMaximumNumberOfCores());
+                                DS,
+                                this->getFunctionAnalysesOfLoop(ls),
+                                this->om->getMaximumNumberOfCores(),
+                                {},
+                                true,
+                                8);
 
         } else {
           auto maximumNumberOfCoresForTheParallelization =
@@ -799,8 +807,8 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
               loopNode,
               LLVMLoop,
               funcPDG,
-              DS,
               &SE,
+              DS,
               this->techniquesToDisable[currentLoopIndex],
               this->DOALLChunkSize[currentLoopIndex],
               maximumNumberOfCoresForTheParallelization,
@@ -809,13 +817,13 @@ std::vector<LoopContent *> *Noelle::getLoopContents(double minimumHotness) {
         allLoops->push_back(ldi);
       }
     }
-
-    /*
-     * Free the memory.
-     */
-    delete DS;
   }
 
+  /*
+   * Compute the sub-analyses of the loops.
+   */
+  this->computeLoopContents(*allLoops);
+
   return allLoops;
 }
 
@@ -1185,12 +1193,12 @@ void Noelle::sortByStaticNumberOfInstructions(
 
 LoopContent *Noelle::getLoopContentForLoop(
     BasicBlock *header,
-    PDG *functionPDG,
-    DominatorSummary *DS,
+    std::shared_ptr<PDG> functionPDG,
     uint32_t techniquesToDisable,
     uint32_t DOALLChunkSize,
     uint32_t maxCores,
-    std::unordered_set<LoopContentOptimization> optimizations) {
+    std::unordered_set<LoopContentOptimization> optimizations,
+    bool computeAllAnalyses) {
 
   /*
    * Fetch the function
@@ -1204,6 +1212,13 @@ LoopContent *Noelle::getLoopContentForLoop(
   auto forest = this->organizeLoopsInTheirNestingForest(*allLoopsOfFunction);
   auto newLoopNode = forest->getInnermostLoopThatContains(&*header->begin());
 
+  /*
+   * Compute the dominators of the function.
+   * This is done before fetching the LLVM analyses because it can invalidate
+   * them.
+   */
+  std::shared_ptr<DominatorSummary> DS(this->getDominators(function));
+
   /*
    * Fetch the llvm loop corresponding to the loop structure
    */
@@ -1217,13 +1232,21 @@ LoopContent *Noelle::getLoopContentForLoop(
   auto ldi = this->getLoopContentForLoop(newLoopNode,
                                          llvmLoop,
                                          functionPDG,
-                                         DS,
                                          &SE,
+                                         DS,
                                          techniquesToDisable,
                                          DOALLChunkSize,
                                          maxCores,
                                          optimizations);
 
+  /*
+   * Compute the sub-analyses of the loop while the LLVM analyses fetched
+   * above are still valid.
+   */
+  if (computeAllAnalyses) {
+    ldi->computeAllAnalyses(SE, llvmLoop);
+  }
+
   return ldi;
 }
 
@@ -1331,9 +1354,9 @@ LoopNestingGraph *Noelle::getLoopNestingGraphForProgram() {
 LoopContent *Noelle::getLoopContentForLoop(
     LoopTree *loopNode,
     Loop *loop,
-    PDG *functionPDG,
-    DominatorSummary *DS,
+    std::shared_ptr<PDG> functionPDG,
     ScalarEvolution *SE,
+    std::shared_ptr<DominatorSummary> DS,
     uint32_t techniquesToDisableForLoop,
     uint32_t DOALLChunkSizeForLoop,
     uint32_t maxCores,
@@ -1341,16 +1364,20 @@ LoopContent *Noelle::getLoopContentForLoop(
 
   /*
    * Allocate the LDI.
+   * Its sub-analyses are computed by the caller, or on demand.
    */
+  auto analyses = this->getFunctionAnalysesOfLoop(loopNode->getLoop());
   auto ldi = new LoopContent(this->ldgAnalysis,
                              this->getCompilationOptionsManager(),
                              functionPDG,
                              loopNode,
                              loop,
-                             *DS,
                              *SE,
+                             DS,
+                             analyses,
                              maxCores,
                              optimizations,
+                             true,
                              DOALLChunkSizeForLoop);
 
   /*
@@ -1398,6 +1425,155 @@ LoopContent *Noelle::getLoopContentForLoop(
   return ldi;
 }
 
+void Noelle::computeLoopContents(std::vector<LoopContent *> &loops) {
+
+  /*
+   * Check if the sub-analyses are computed on demand.
+   */
+  if (this->lazyLoopContents) {
+    return;
+  }
+
+  /*
+   * Check if the sub-analyses should be computed in parallel.
+   */
+  if (this->parallelizeLoopContents) {
+    this->computeLoopContentsInParallel(loops);
+    return;
+  }
+
+  /*
+   * Compute all sub-analyses of the loops.
+   */
+  this->computeLoopContentsWithFunctionAnalyses(
+      loops,
+      [](LoopContent *loop, ScalarEvolution &SE, Loop *l) {
+        loop->computeAllAnalyses(SE, l);
+      });
+
+  return;
+}
+
+void Noelle::computeLoopContentsWithFunctionAnalyses(
+    std::vector<LoopContent *> &loops,
+    std::function<void(LoopContent *, ScalarEvolution &, Loop *)> compute) {
+
+  /*
+   * The LLVM analyses are not thread-safe and fetching them for a function
+   * frees the ones of the previous function, so this is done one function at a
+   * time.
+   */
+  for (auto &pair : this->groupLoopContentsByFunction(loops)) {
+    auto function = pair.first;
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
+    auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
+    for (auto loop : pair.second) {
+      auto header = loop->getLoopStructure()->getHeader();
+      auto llvmLoop = LI.getLoopFor(header);
+      compute(loop, SE, llvmLoop);
+    }
+  }
+
+  return;
+}
+
+std::vector<std::pair<Function *, std::vector<LoopContent *>>> Noelle::
+    groupLoopContentsByFunction(std::vector<LoopContent *> &loops) {
+
+  /*
+   * Functions are kept in the order their loops appear in @loops.
+   */
+  std::vector<std::pair<Function *, std::vector<LoopContent *>>> groups;
+  std::unordered_map<Function *, uint64_t> groupOfFunction;
+  for (auto loop : loops) {
+    auto function = loop->getLoopStructure()->getFunction();
+    if (groupOfFunction.find(function) == groupOfFunction.end()) {
+      groupOfFunction[function] = groups.size();
+      groups.push_back({ function, {} });
+    }
+    groups[groupOfFunction[function]].second.push_back(loop);
+  }
+
+  return groups;
+}
+
+void Noelle::computeLoopContentsInParallel(std::vector<LoopContent *> &loops) {
+  WorkStealingPool pool;
+  if (this->verbose >= Verbosity::Maximal) {
+    errs() << "Noelle: Compute " << loops.size() << " loop contents with "
+           << pool.getNumberOfWorkers() << " threads\n";
+  }
+
+  /*
+   * Take the dependences of the loops from their function dependence graphs
+   * and refine them as far as possible without the LLVM analyses.
+   * The loops of a function share their dominators and their loop tree, which
+   * cache the results of queries; hence, each task handles all the loops of a
+   * function.
+   */
+  auto loopsOfFunctions = this->groupLoopContentsByFunction(loops);
+  pool.run(loopsOfFunctions.size(),
+           [&loopsOfFunctions](uint64_t taskID, uint32_t workerID) {
+             for (auto loop : loopsOfFunctions[taskID].second) {
+               loop->prepareLoopDG();
+             }
+           });
+
+  /*
+   * Complete the dependence graphs of the loops with the analyses that need
+   * the LLVM ones.
+   */
+  this->computeLoopContentsWithFunctionAnalyses(
+      loops,
+      [](LoopContent *loop, ScalarEvolution &SE, Loop *l) {
+        loop->computeLoopDG(SE, l);
+      });
+
+  /*
+   * Compute the sub-analyses that only need the loop dependence graphs in
+   * parallel.
+   */
+  pool.run(loops.size(), [&loops](uint64_t taskID, uint32_t workerID) {
+    loops[taskID]->computeAnalysesOfLoopDG();
+  });
+
+  /*
+   * Compute the remaining sub-analyses.
+   */
+  this->computeLoopContentsWithFunctionAnalyses(
+      loops,
+      [](LoopContent *loop, ScalarEvolution &SE, Loop *l) {
+        loop->computeAllAnalyses(SE, l);
+      });
+
+  return;
+}
+
+LoopContentFunctionAnalyses Noelle::getFunctionAnalysesOfLoop(
+    LoopStructure *loop) {
+  auto header = loop->getHeader();
+  auto function = header->getParent();
+
+  /*
+   * Requesting an LLVM analysis recomputes all of them. Hence, the loop
+   * information is fetched first and the loop is looked up only after the
+   * scalar evolution has been fetched.
+   */
+  LoopContentFunctionAnalyses analyses;
+  analyses.fetchSEAndLLVMLoop =
+      [this, function, header]() -> std::pair<ScalarEvolution *, Loop *> {
+    auto &LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
+    auto &SE = getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
+    auto llvmLoop = LI.getLoopFor(header);
+    if ((llvmLoop != nullptr) && (llvmLoop->getHeader() != header)) {
+      llvmLoop = nullptr;
+    }
+    return { &SE, llvmLoop };
+  };
+
+  return analyses;
+}
+
 bool Noelle::isLoopHot(LoopStructure *loopStructure, double minimumHotness) {
 
   /*
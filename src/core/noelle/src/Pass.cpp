@@ -86,6 +86,16 @@ static cl::opt<bool> DisableLoopAwareDependenceAnalyses(
     cl::ZeroOrMore,
     cl::Hidden,
     cl::desc("Disable loop aware dependence analyses"));
+static cl::opt<bool> ParallelLoopContents(
+    "noelle-parallel-loop-contents",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Compute the loop contents of functions in parallel"));
+static cl::opt<bool> LazyLoopContents(
+    "noelle-lazy-loop-contents",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Compute the sub-analyses of loops when they are requested"));
 static cl::opt<bool> DisableInliner("noelle-disable-inliner",
                                     cl::ZeroOrMore,
                                     cl::Hidden,
@@ -148,10 +158,15 @@ bool Noelle::doInitialization(Module &M) {
   } else {
     this->ldgAnalysis.enableLoopDependenceAnalyses(false);
   }
+  this->parallelizeLoopContents =
+      (ParallelLoopContents.getNumOccurrences() > 0) ? true : false;
+  this->lazyLoopContents =
+      (LazyLoopContents.getNumOccurrences() > 0) ? true : false;
 
   /*
    * Allocate the managers.
    */
+  delete this->om;
   this->om = new CompilationOptionsManager(
       M,
       optMaxCores,
@@ -183,6 +198,17 @@ void Noelle::getAnalysisUsage(AnalysisUsage &AU) const {
 
 bool Noelle::runOnModule(Module &M) {
   this->pdgAnalysis = &getAnalysis<PDGGenerator>();
+  if (this->keepAnalyses) {
+    this->pdgAnalysis->keepPDGAcrossRuns();
+  }
+
+  /*
+   * Update the analyses kept from the previous run.
+   */
+  if (!this->functionsModifiedAcrossRuns.empty()) {
+    this->updateProgramDependenceGraph(this->functionsModifiedAcrossRuns);
+    this->functionsModifiedAcrossRuns.clear();
+  }
 
   return false;
 }
@@ -133,6 +133,20 @@ public:
 
   std::vector<DGEdge<Value, Value> *> getSortedDependences(void);
 
+  /*
+   * Replace the nodes of the instructions and arguments of @functions with new
+   * ones that match the current code of these functions.
+   * The dependences of the old nodes are removed and no dependence is added.
+   * This is meant to be used after @functions have been modified: the
+   * instructions erased since the nodes have been created are never
+   * dereferenced.
+   * Functions of @functions that are not in @M anymore (i.e., they have been
+   * erased) are never dereferenced either: only their old nodes are removed.
+   * Only nodes added by the constructors that take a module or a function are
+   * replaced.
+   */
+  void updateNodesOf(Module &M, const std::set<Function *> &functions);
+
   /*
    * Destructor
    */
@@ -149,6 +163,9 @@ protected:
       PDG *newPDG,
       bool linkToExternal,
       std::unordered_set<DGEdge<Value, Value> *> const &edgesToIgnore);
+
+private:
+  std::unordered_map<Function *, std::vector<DGNode<Value> *>> nodesOfFunction;
 };
 
 } // namespace arcana::noelle
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_CACHE_H_
+#define NOELLE_SRC_CORE_PDG_CACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/PDG.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Binary file that stores the PDG of a module next to its bitcode.
+ *
+ * Nodes are the arguments and instructions of the functions with a body, in
+ * the order of the module; hence, they are not stored. The file includes
+ *   - a header with a version number, a hash of the module, and the options
+ *     used to compute the PDG,
+ *   - the offsets of the outgoing dependences of each node (CSR layout), and
+ *   - the dependences sorted by source node.
+ *
+ * The file is memory-mapped when loaded and the PDG is rebuilt by walking its
+ * arrays; this avoids recomputing the dependences, but it still costs one
+ * insertion per dependence.
+ * A file is loaded only if its version, its module hash, and its options
+ * match; the hash covers the bitcode of the module.
+ */
+class PDGCache {
+public:
+  /*
+   * @analysisOptions identifies the options used to compute the PDGs stored
+   * and loaded (e.g., the dependence analyses enabled). A file stored with
+   * different options is not loaded.
+   */
+  PDGCache(Module &M,
+           const std::string &fileName,
+           uint32_t analysisOptions = 0);
+
+  PDGCache() = delete;
+
+  /*
+   * Return the PDG stored in the file, or nullptr if the file does not exist
+   * or it does not belong to the current code of the module.
+   */
+  PDG *load(void);
+
+  /*
+   * Store @pdg in the file.
+   * Return false if @pdg cannot be stored (e.g., it has dependences with
+   * values that are not arguments or instructions of the module).
+   */
+  bool store(PDG *pdg);
+
+  static constexpr uint32_t version = 3;
+
+private:
+  Module &M;
+  std::string fileName;
+  uint32_t analysisOptions;
+  std::vector<Value *> values;
+  std::unordered_map<Value *, uint32_t> valueIDs;
+
+  void numberValues(void);
+
+  uint64_t computeModuleHash(void) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_CACHE_H_
@@ -99,15 +99,64 @@ PDG::PDG(std::vector<Value *> &values) {
 }
 
 void PDG::addNodesOf(Function &F) {
+  auto &nodes = this->nodesOfFunction[&F];
+
   for (auto &arg : F.args()) {
-    addNode(cast<Value>(&arg), /*inclusion=*/true);
+    auto node = addNode(cast<Value>(&arg), /*inclusion=*/true);
+    nodes.push_back(node);
   }
 
   for (auto &B : F) {
     for (auto &I : B) {
-      addNode(cast<Value>(&I), /*inclusion=*/true);
+      auto node = addNode(cast<Value>(&I), /*inclusion=*/true);
+      nodes.push_back(node);
+    }
+  }
+}
+
+void PDG::updateNodesOf(Module &M, const std::set<Function *> &functions) {
+
+  /*
+   * Remove the old nodes of the functions and their dependences.
+   * Removing a node only uses the address of its value, so it is safe even if
+   * the value does not exist anymore.
+   *
+   * All old nodes are removed before adding the new ones because instructions
+   * can be moved between the functions given as input.
+   */
+  Function *functionOfEntry = nullptr;
+  for (auto F : functions) {
+    auto nodesIt = this->nodesOfFunction.find(F);
+    if (nodesIt == this->nodesOfFunction.end()) {
+      continue;
     }
+    for (auto node : nodesIt->second) {
+      if (node == this->entryNode) {
+        functionOfEntry = F;
+        this->entryNode = nullptr;
+      }
+      this->removeNode(node);
+    }
+    this->nodesOfFunction.erase(nodesIt);
   }
+
+  /*
+   * Add the nodes of the current code of the functions that are still in @M.
+   */
+  for (auto &F : M) {
+    if (functions.find(&F) == functions.end()) {
+      continue;
+    }
+    if (F.empty()) {
+      continue;
+    }
+    this->addNodesOf(F);
+    if (&F == functionOfEntry) {
+      this->setEntryPointAt(F);
+    }
+  }
+
+  return;
 }
 
 void PDG::setEntryPointAt(Function &F) {
@@ -0,0 +1,336 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/PDGCache.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Layout of the file.
+ * Every array starts at an offset that is a multiple of 8 bytes, so it can be
+ * read in place from the memory-mapped file.
+ */
+struct PDGCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t analysisOptions;
+  uint64_t moduleHash;
+  uint64_t numberOfNodes;
+  uint64_t numberOfEdges;
+};
+
+enum PDGCacheEdgeKind : uint8_t {
+  PDG_CACHE_VARIABLE,
+  PDG_CACHE_MAY_MEMORY,
+  PDG_CACHE_MUST_MEMORY,
+  PDG_CACHE_CONTROL,
+  PDG_CACHE_UNDEFINED
+};
+
+struct PDGCacheEdge {
+  uint32_t dst;
+  uint8_t kind;
+  uint8_t dataDependenceType;
+  uint8_t isLoopCarried;
+  uint8_t reserved;
+};
+
+static const char pdgCacheMagic[8] = { 'N', 'O', 'E', 'L', 'L', 'E', 'P', 'G' };
+
+PDGCache::PDGCache(Module &M,
+                   const std::string &fileName,
+                   uint32_t analysisOptions)
+  : M{ M },
+    fileName{ fileName },
+    analysisOptions{ analysisOptions } {
+  this->numberValues();
+
+  return;
+}
+
+PDG *PDGCache::load(void) {
+
+  /*
+   * Map the file in memory.
+   */
+  auto bufferOrError = MemoryBuffer::getFile(this->fileName,
+                                             /*FileSize=*/-1,
+                                             /*RequiresNullTerminator=*/false);
+  if (!bufferOrError) {
+    return nullptr;
+  }
+  auto &buffer = *bufferOrError;
+  auto start = buffer->getBufferStart();
+  auto size = buffer->getBufferSize();
+
+  /*
+   * Check the header.
+   */
+  if (size < sizeof(PDGCacheHeader)) {
+    return nullptr;
+  }
+  auto header = reinterpret_cast<const PDGCacheHeader *>(start);
+  if (std::memcmp(header->magic, pdgCacheMagic, sizeof(pdgCacheMagic)) != 0) {
+    return nullptr;
+  }
+  if (header->version != PDGCache::version) {
+    return nullptr;
+  }
+  if (header->analysisOptions != this->analysisOptions) {
+    return nullptr;
+  }
+  if (header->numberOfNodes != this->values.size()) {
+    return nullptr;
+  }
+  if (header->moduleHash != this->computeModuleHash()) {
+    return nullptr;
+  }
+  auto numberOfNodes = header->numberOfNodes;
+  auto numberOfEdges = header->numberOfEdges;
+  auto expectedSize = sizeof(PDGCacheHeader)
+                      + (numberOfNodes + 1) * sizeof(uint64_t)
+                      + numberOfEdges * sizeof(PDGCacheEdge);
+  if (size != expectedSize) {
+    return nullptr;
+  }
+
+  /*
+   * Fetch the arrays.
+   */
+  auto offsets =
+      reinterpret_cast<const uint64_t *>(start + sizeof(PDGCacheHeader));
+  auto edges =
+      reinterpret_cast<const PDGCacheEdge *>(offsets + numberOfNodes + 1);
+  if (offsets[numberOfNodes] != numberOfEdges) {
+    return nullptr;
+  }
+
+  /*
+   * Create the PDG.
+   * Its nodes are the values of the module in the same order used to number
+   * them.
+   */
+  auto pdg = new PDG(this->M);
+
+  /*
+   * Add the dependences.
+   */
+  for (uint64_t srcID = 0; srcID < numberOfNodes; srcID++) {
+    auto src = this->values[srcID];
+    for (auto i = offsets[srcID]; i < offsets[srcID + 1]; i++) {
+      auto &edgeInFile = edges[i];
+      if (edgeInFile.dst >= numberOfNodes) {
+        delete pdg;
+        return nullptr;
+      }
+      auto dst = this->values[edgeInFile.dst];
+      auto dataDepType =
+          static_cast<DataDependenceType>(edgeInFile.dataDependenceType);
+
+      DGEdge<Value, Value> *edge = nullptr;
+      switch (edgeInFile.kind) {
+        case PDG_CACHE_VARIABLE:
+          edge = pdg->addVariableDataDependenceEdge(src, dst, dataDepType);
+          break;
+        case PDG_CACHE_MAY_MEMORY:
+          edge =
+              pdg->addMemoryDataDependenceEdge(src, dst, dataDepType, false);
+          break;
+        case PDG_CACHE_MUST_MEMORY:
+          edge = pdg->addMemoryDataDependenceEdge(src, dst, dataDepType, true);
+          break;
+        case PDG_CACHE_CONTROL:
+          edge = pdg->addControlDependenceEdge(src, dst);
+          break;
+        case PDG_CACHE_UNDEFINED:
+          edge = pdg->addUndefinedDependenceEdge(src, dst);
+          break;
+        default:
+          delete pdg;
+          return nullptr;
+      }
+      edge->setLoopCarried(edgeInFile.isLoopCarried != 0);
+    }
+  }
+
+  return pdg;
+}
+
+bool PDGCache::store(PDG *pdg) {
+  assert(pdg != nullptr);
+
+  /*
+   * Encode the dependences sorted by their source node.
+   */
+  auto numberOfNodes = this->values.size();
+  std::vector<uint64_t> offsets(numberOfNodes + 1, 0);
+  std::vector<PDGCacheEdge> edges;
+  edges.reserve(pdg->numEdges());
+  for (uint64_t srcID = 0; srcID < numberOfNodes; srcID++) {
+    offsets[srcID] = edges.size();
+
+    /*
+     * Fetch the node of the current value.
+     */
+    auto src = this->values[srcID];
+    auto node = pdg->fetchNode(src);
+    if (node == nullptr) {
+      return false;
+    }
+
+    /*
+     * Encode the outgoing dependences of the node.
+     */
+    for (auto edge : node->getOutgoingEdges()) {
+      auto dstIt = this->valueIDs.find(edge->getDst());
+      if (dstIt == this->valueIDs.end()) {
+        return false;
+      }
+      if (edge->getNumberOfSubEdges() > 0) {
+        return false;
+      }
+
+      PDGCacheEdge edgeInFile{};
+      edgeInFile.dst = dstIt->second;
+      edgeInFile.isLoopCarried = edge->isLoopCarriedDependence() ? 1 : 0;
+      if (isa<ControlDependence<Value, Value>>(edge)) {
+        edgeInFile.kind = PDG_CACHE_CONTROL;
+      } else if (isa<UndefinedDependence<Value, Value>>(edge)) {
+        edgeInFile.kind = PDG_CACHE_UNDEFINED;
+      } else {
+        auto dataDep = cast<DataDependence<Value, Value>>(edge);
+        edgeInFile.dataDependenceType = dataDep->getDataDependenceType();
+        if (isa<MustMemoryDependence<Value, Value>>(edge)) {
+          edgeInFile.kind = PDG_CACHE_MUST_MEMORY;
+        } else if (isa<MayMemoryDependence<Value, Value>>(edge)) {
+          edgeInFile.kind = PDG_CACHE_MAY_MEMORY;
+        } else {
+          edgeInFile.kind = PDG_CACHE_VARIABLE;
+        }
+      }
+      edges.push_back(edgeInFile);
+    }
+  }
+  offsets[numberOfNodes] = edges.size();
+
+  /*
+   * Prepare the header.
+   */
+  PDGCacheHeader header{};
+  std::memcpy(header.magic, pdgCacheMagic, sizeof(pdgCacheMagic));
+  header.version = PDGCache::version;
+  header.analysisOptions = this->analysisOptions;
+  header.moduleHash = this->computeModuleHash();
+  header.numberOfNodes = numberOfNodes;
+  header.numberOfEdges = edges.size();
+
+  /*
+   * Write the file.
+   */
+  std::error_code EC;
+  raw_fd_ostream file(this->fileName, EC, sys::fs::OF_None);
+  if (EC) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(offsets.data()),
+             offsets.size() * sizeof(uint64_t));
+  file.write(reinterpret_cast<const char *>(edges.data()),
+             edges.size() * sizeof(PDGCacheEdge));
+  file.close();
+  if (file.has_error()) {
+    file.clear_error();
+    return false;
+  }
+
+  return true;
+}
+
+void PDGCache::numberValues(void) {
+
+  /*
+   * Number the values following the order used by the constructor of PDG.
+   */
+  for (auto &F : this->M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    for (auto &arg : F.args()) {
+      this->valueIDs[&arg] = this->values.size();
+      this->values.push_back(&arg);
+    }
+    for (auto &I : instructions(F)) {
+      this->valueIDs[&I] = this->values.size();
+      this->values.push_back(&I);
+    }
+  }
+
+  return;
+}
+
+/*
+ * Stream that feeds everything written to it into an MD5 hash, so the module
+ * can be hashed through its bitcode writer without keeping a copy of the
+ * bitcode.
+ */
+class MD5Stream : public raw_ostream {
+public:
+  MD5Stream(MD5 &hash) : hash{ hash } {
+    this->SetUnbuffered();
+  }
+
+private:
+  MD5 &hash;
+  uint64_t position = 0;
+
+  void write_impl(const char *ptr, size_t size) override {
+    this->position += size;
+    this->hash.update(StringRef(ptr, size));
+
+    return;
+  }
+
+  uint64_t current_pos(void) const override {
+    return this->position;
+  }
+};
+
+uint64_t PDGCache::computeModuleHash(void) const {
+  MD5 hash;
+
+  /*
+   * Hash the bitcode of the module.
+   * This covers everything the PDG depends on (types, predicates, flags,
+   * constants, attributes, metadata, and initializers of globals), and it is
+   * cheaper to produce than the textual IR.
+   */
+  {
+    MD5Stream stream{ hash };
+    WriteBitcodeToFile(this->M, stream);
+  }
+
+  MD5::MD5Result result;
+  hash.final(result);
+
+  return result.low();
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_CORE_PDG_GENERATOR_ALIASQUERYCACHE_H_
+#define NOELLE_SRC_CORE_PDG_GENERATOR_ALIASQUERYCACHE_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Cache of the results of alias queries.
+ *
+ * A query is either between two memory locations or between two values.
+ * Memory locations and values are numbered the first time they are seen, so
+ * different instructions that access the same memory location share the same
+ * queries. A query is then the pair of these IDs, and the results are stored
+ * in an open-addressing hash table with linear probing.
+ *
+ * The order of the two operands of a query is preserved.
+ */
+class AliasQueryCache {
+public:
+  AliasQueryCache();
+
+  std::optional<AliasResult> lookup(const MemoryLocation &locI,
+                                    const MemoryLocation &locJ);
+
+  std::optional<AliasResult> lookup(const Value *valueI, const Value *valueJ);
+
+  void insert(const MemoryLocation &locI,
+              const MemoryLocation &locJ,
+              AliasResult result);
+
+  void insert(const Value *valueI, const Value *valueJ, AliasResult result);
+
+  /*
+   * Forget all the results cached.
+   * The counters are not reset.
+   */
+  void clear(void);
+
+  uint64_t getNumberOfHits(void) const;
+
+  uint64_t getNumberOfMisses(void) const;
+
+private:
+  DenseMap<MemoryLocation, uint32_t> memoryLocationIDs;
+  DenseMap<const Value *, uint32_t> valueIDs;
+  uint32_t numberOfIDs;
+  std::vector<uint64_t> keys;
+  std::vector<uint8_t> results;
+  uint64_t numberOfEntries;
+  uint64_t hits;
+  uint64_t misses;
+
+  uint32_t getID(const MemoryLocation &loc);
+
+  uint32_t getID(const Value *value);
+
+  std::optional<AliasResult> lookup(uint64_t key);
+
+  void insert(uint64_t key, AliasResult result);
+
+  uint64_t findSlot(uint64_t key) const;
+
+  void grow(void);
+
+  static uint64_t getKey(uint32_t idI, uint32_t idJ);
+
+  static uint64_t hash(uint64_t key);
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_CORE_PDG_GENERATOR_ALIASQUERYCACHE_H_
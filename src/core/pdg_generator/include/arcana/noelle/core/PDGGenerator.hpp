@@ -26,6 +26,7 @@
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/AllocAA.hpp"
 #include "arcana/noelle/core/PDG.hpp"
+#include "arcana/noelle/core/PDGCache.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/DataFlow.hpp"
 #include "arcana/noelle/core/CallGraph.hpp"
@@ -33,11 +34,27 @@
 #include "arcana/noelle/core/MayPointsToAnalysis.hpp"
 #include "arcana/noelle/core/DependenceAnalysis.hpp"
 #include "arcana/noelle/core/CallGraphAnalysis.hpp"
+#include "arcana/noelle/core/AliasQueryCache.hpp"
 
 namespace arcana::noelle {
 
 enum class PDGVerbosity { Disabled, Minimal, Maximal, MaximalAndPDG };
 
+/*
+ * Pair of instructions of a function that might have a memory dependence from
+ * @fromInst to @toInst.
+ */
+struct MemoryDependenceCandidate {
+  Instruction *fromInst;
+  Instruction *toInst;
+
+  /*
+   * Whether @fromInst can be reached from @toInst.
+   * This is computed only for dependences between calls.
+   */
+  bool isFromReachableFromTo;
+};
+
 class PDGGenerator : public ModulePass {
 public:
   static char ID;
@@ -58,8 +75,52 @@ public:
 
   PDG *getPDG(void);
 
+  /*
+   * Update the PDG returned by getPDG after the code of @modifiedFunctions has
+   * been changed.
+   * Only the dependences of the modified functions and of the functions that
+   * can invoke them (directly or not) are recomputed, as the memory
+   * dependences of calls depend on the code of their callees. The other
+   * functions keep their dependences. Hence, every function whose code
+   * changed (including functions that lost or gained instructions moved from
+   * other functions) must be included.
+   * Functions that have been erased from the module can be included as well:
+   * their dependences are removed and they are never dereferenced.
+   * The program call graph is computed again, as calls might have changed.
+   * The functions whose dependences have been recomputed are returned.
+   */
+  std::set<Function *> updatePDG(
+      const std::set<Function *> &modifiedFunctions);
+
+  /*
+   * Update the PDG returned by getPDG after @modifiedInstructions have been
+   * changed.
+   * The dependences of the functions that include these instructions are
+   * recomputed, so the instructions must still belong to a function.
+   */
+  void updatePDG(const std::set<Instruction *> &modifiedInstructions);
+
+  /*
+   * Keep the PDG when the pass manager releases this pass, so it is reused
+   * when that pass manager runs again.
+   * The code changed in between must be reported with updatePDG, or the PDG
+   * must be dropped with invalidatePDG.
+   */
+  void keepPDGAcrossRuns(void);
+
+  void invalidatePDG(void);
+
   noelle::CallGraph *getProgramCallGraph(void);
 
+  /*
+   * Compute the call graph again the next time it is requested.
+   * The call graph returned before stays allocated until this pass is
+   * released, so pointers to it do not dangle.
+   */
+  void invalidateProgramCallGraph(void);
+
+  MayPointsToAnalysis &getMayPointsToAnalysis(void);
+
   virtual ~PDGGenerator();
 
   static bool isTheLibraryFunctionPure(Function *libraryFunction);
@@ -95,8 +156,14 @@ private:
   bool disableSVFCallGraph;
   bool disableAllocAA;
   bool disableRA;
+  bool parallelizeMemoryDependences;
+  std::string cacheFileName;
+  bool embedPDGInCache;
+  bool keepPDG;
+  AliasQueryCache aliasQueryCache;
   PDGPrinter printer;
   noelle::CallGraph *noelleCG;
+  std::vector<noelle::CallGraph *> invalidatedCallGraphs;
   std::set<DependenceAnalysis *> ddAnalyses;
   std::set<CallGraphAnalysis *> cgAnalyses;
   std::unordered_set<const Function *> internalFuncs;
@@ -112,6 +179,8 @@ private:
   bool isInternalFunctionThatReachUnhandledExternalFunction(const Function *F);
   bool cannotReachUnhandledExternalFunction(CallBase *call);
   bool hasNoMemoryOperations(CallBase *call);
+  std::set<Function *> fetchFunctionsThatCanInvoke(
+      const std::set<Function *> &functions);
 
   bool comparePDGs(PDG *pdg1, PDG *pdg2);
   bool compareNodes(PDG *pdg1, PDG *pdg2);
@@ -123,6 +192,8 @@ private:
 
   bool hasPDGAsMetadata(Module &);
 
+  uint32_t getAnalysisOptionsOfCache(void) const;
+
   void cleanPDGMetadata();
 
   PDG *constructPDGFromMetadata(Module &);
@@ -153,29 +224,59 @@ private:
                               std::unordered_map<Value *, MDNode *> &);
 
   void trimDGUsingCustomAliasAnalysis(PDG *pdg);
+  void trimDGUsingCustomAliasAnalysis(
+      PDG *pdg,
+      const std::vector<DGEdge<Value, Value> *> &edges);
 
   PDG *constructPDGFromAnalysis(Module &M);
   void constructEdgesFromUseDefs(PDG *pdg);
+  void constructEdgesFromUseDefsForFunction(PDG *pdg, Function &F);
+  void constructEdgesFromUsesOf(PDG *pdg, Value *pdgValue);
   void constructEdgesFromAliases(PDG *pdg, Module &M);
+  void constructEdgesFromAliases(PDG *pdg,
+                                 const std::vector<Function *> &functions);
   void constructEdgesFromControl(PDG *pdg, Module &M);
-  void constructEdgesFromAliasesForFunction(PDG *pdg, Function &F);
+  void constructEdgesFromAliasesForFunction(PDG *pdg,
+                                            Function &F,
+                                            DataFlowBitVectorResult *dfr);
   void constructEdgesFromControlForFunction(PDG *pdg, Function &F);
 
-  void iterateInstForStore(PDG *,
-                           Function &,
-                           AAResults &,
-                           DataFlowResult *,
-                           StoreInst *);
-  void iterateInstForLoad(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          LoadInst *);
-  void iterateInstForCall(PDG *,
-                          Function &,
-                          AAResults &,
-                          DataFlowResult *,
-                          CallBase *);
+  void constructEdgesFromAliasesInParallel(
+      PDG *pdg,
+      const std::vector<Function *> &functions);
+
+  /*
+   * Memory dependences are computed in two steps.
+   * First, the pairs of instructions that might depend on each other are
+   * collected using only the reachability of instructions: this step does not
+   * query any analysis and it can run on several functions in parallel.
+   * Then, the alias analyses are queried on these candidates in the order
+   * they have been collected and the dependences are added to the PDG.
+   * When functions are processed sequentially, the two steps are done one
+   * instruction at a time to avoid keeping all candidates of a function.
+   */
+  void collectMemoryDependenceCandidates(
+      Function &F,
+      DataFlowBitVectorResult *dfr,
+      std::vector<MemoryDependenceCandidate> &candidates);
+  void collectMemoryDependenceCandidates(
+      Instruction &I,
+      DataFlowBitVectorResult *dfr,
+      std::vector<MemoryDependenceCandidate> &candidates);
+  void iterateInstForStore(DataFlowBitVectorResult *,
+                           StoreInst *,
+                           std::vector<MemoryDependenceCandidate> &);
+  void iterateInstForLoad(DataFlowBitVectorResult *,
+                          LoadInst *,
+                          std::vector<MemoryDependenceCandidate> &);
+  void iterateInstForCall(DataFlowBitVectorResult *,
+                          CallBase *,
+                          std::vector<MemoryDependenceCandidate> &);
+  void addEdgesFromMemoryDependenceCandidates(
+      PDG *pdg,
+      Function &F,
+      AAResults &AA,
+      const std::vector<MemoryDependenceCandidate> &candidates);
 
   void addEdgeFromMemoryAlias(PDG *,
                               Function &,
@@ -202,13 +303,20 @@ private:
                                  CallBase *,
                                  bool);
 
-  void removeEdgesNotUsedByParSchemes(PDG *pdg);
+  void removeEdgesNotUsedByParSchemes(
+      PDG *pdg,
+      const std::vector<DGEdge<Value, Value> *> &edges);
 
   AliasResult doTheyAlias(PDG *pdg,
                           Function &F,
                           AAResults &AA,
                           Value *instI,
                           Value *instJ);
+  AliasResult doTheyAliasWithoutCache(PDG *pdg,
+                                      Function &F,
+                                      AAResults &AA,
+                                      Value *instI,
+                                      Value *instJ);
 
   bool edgeIsNotLoopCarriedMemoryDependency(DGEdge<Value, Value> *edge);
   bool isBackedgeIntoSameGlobal(DGEdge<Value, Value> *edge);
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/core/AliasQueryCache.hpp"
+
+namespace arcana::noelle {
+
+/*
+ * Key of the slots of the hash table that are not used.
+ * IDs are 32-bit values smaller than UINT32_MAX, so no query has this key.
+ */
+static constexpr uint64_t emptyKey = UINT64_MAX;
+
+static constexpr uint64_t initialNumberOfSlots = 1024;
+
+AliasQueryCache::AliasQueryCache()
+  : numberOfIDs{ 0 },
+    keys(initialNumberOfSlots, emptyKey),
+    results(initialNumberOfSlots, 0),
+    numberOfEntries{ 0 },
+    hits{ 0 },
+    misses{ 0 } {
+  return;
+}
+
+std::optional<AliasResult> AliasQueryCache::lookup(
+    const MemoryLocation &locI,
+    const MemoryLocation &locJ) {
+  auto key = getKey(this->getID(locI), this->getID(locJ));
+
+  return this->lookup(key);
+}
+
+std::optional<AliasResult> AliasQueryCache::lookup(const Value *valueI,
+                                                   const Value *valueJ) {
+  auto key = getKey(this->getID(valueI), this->getID(valueJ));
+
+  return this->lookup(key);
+}
+
+void AliasQueryCache::insert(const MemoryLocation &locI,
+                             const MemoryLocation &locJ,
+                             AliasResult result) {
+  auto key = getKey(this->getID(locI), this->getID(locJ));
+  this->insert(key, result);
+
+  return;
+}
+
+void AliasQueryCache::insert(const Value *valueI,
+                             const Value *valueJ,
+                             AliasResult result) {
+  auto key = getKey(this->getID(valueI), this->getID(valueJ));
+  this->insert(key, result);
+
+  return;
+}
+
+void AliasQueryCache::clear(void) {
+  this->memoryLocationIDs.clear();
+  this->valueIDs.clear();
+  this->numberOfIDs = 0;
+  std::fill(this->keys.begin(), this->keys.end(), emptyKey);
+  this->numberOfEntries = 0;
+
+  return;
+}
+
+uint64_t AliasQueryCache::getNumberOfHits(void) const {
+  return this->hits;
+}
+
+uint64_t AliasQueryCache::getNumberOfMisses(void) const {
+  return this->misses;
+}
+
+uint32_t AliasQueryCache::getID(const MemoryLocation &loc) {
+  auto result = this->memoryLocationIDs.try_emplace(loc, this->numberOfIDs);
+  if (result.second) {
+    this->numberOfIDs++;
+  }
+
+  return result.first->second;
+}
+
+uint32_t AliasQueryCache::getID(const Value *value) {
+  auto result = this->valueIDs.try_emplace(value, this->numberOfIDs);
+  if (result.second) {
+    this->numberOfIDs++;
+  }
+
+  return result.first->second;
+}
+
+std::optional<AliasResult> AliasQueryCache::lookup(uint64_t key) {
+  auto slot = this->findSlot(key);
+  if (this->keys[slot] == emptyKey) {
+    this->misses++;
+    return std::nullopt;
+  }
+  this->hits++;
+
+  return static_cast<AliasResult>(this->results[slot]);
+}
+
+void AliasQueryCache::insert(uint64_t key, AliasResult result) {
+
+  /*
+   * Keep the load factor of the table below 50%, so probe sequences stay
+   * short.
+   */
+  if ((2 * (this->numberOfEntries + 1)) > this->keys.size()) {
+    this->grow();
+  }
+
+  /*
+   * Store the result.
+   */
+  auto slot = this->findSlot(key);
+  if (this->keys[slot] == emptyKey) {
+    this->keys[slot] = key;
+    this->numberOfEntries++;
+  }
+  this->results[slot] = static_cast<uint8_t>(result);
+
+  return;
+}
+
+uint64_t AliasQueryCache::findSlot(uint64_t key) const {
+
+  /*
+   * The number of slots is a power of two.
+   */
+  auto mask = this->keys.size() - 1;
+  auto slot = hash(key) & mask;
+  while ((this->keys[slot] != emptyKey) && (this->keys[slot] != key)) {
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+void AliasQueryCache::grow(void) {
+
+  /*
+   * Allocate a table with twice the slots.
+   */
+  auto oldKeys = std::move(this->keys);
+  auto oldResults = std::move(this->results);
+  this->keys.assign(oldKeys.size() * 2, emptyKey);
+  this->results.assign(oldResults.size() * 2, 0);
+
+  /*
+   * Move the entries to the new table.
+   */
+  for (auto i = 0u; i < oldKeys.size(); i++) {
+    if (oldKeys[i] == emptyKey) {
+      continue;
+    }
+    auto slot = this->findSlot(oldKeys[i]);
+    this->keys[slot] = oldKeys[i];
+    this->results[slot] = oldResults[i];
+  }
+
+  return;
+}
+
+uint64_t AliasQueryCache::getKey(uint32_t idI, uint32_t idJ) {
+  return (static_cast<uint64_t>(idI) << 32) | idJ;
+}
+
+uint64_t AliasQueryCache::hash(uint64_t key) {
+
+  /*
+   * Mix the bits of the two IDs (finalizer of splitmix64).
+   */
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+
+  return key;
+}
+
+} // namespace arcana::noelle
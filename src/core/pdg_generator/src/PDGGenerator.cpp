@@ -20,6 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Architecture.hpp"
 #include "arcana/noelle/core/TalkDown.hpp"
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
@@ -40,6 +41,11 @@ PDGGenerator::PDGGenerator()
     disableSVFCallGraph{ false },
     disableAllocAA{ false },
     disableRA{ false },
+    parallelizeMemoryDependences{ false },
+    cacheFileName{},
+    embedPDGInCache{ false },
+    keepPDG{ false },
+    aliasQueryCache{},
     printer{},
     noelleCG{ nullptr } {
 
@@ -47,13 +53,54 @@ PDGGenerator::PDGGenerator()
 }
 
 void PDGGenerator::releaseMemory() {
+
+  /*
+   * The calls might change after this pass is invalidated.
+   * The next run recomputes the call graph and the functions that reach
+   * unhandled library functions.
+   */
+  delete this->noelleCG;
+  this->noelleCG = nullptr;
+  for (auto callGraph : this->invalidatedCallGraphs) {
+    delete callGraph;
+  }
+  this->invalidatedCallGraphs.clear();
+  this->M = nullptr;
+
+  /*
+   * Check if the PDG should be kept for the next run of the pass manager.
+   */
+  if (this->keepPDG) {
+    return;
+  }
+  this->invalidatePDG();
+
+  return;
+}
+
+void PDGGenerator::keepPDGAcrossRuns(void) {
+  this->keepPDG = true;
+
+  return;
+}
+
+void PDGGenerator::invalidatePDG(void) {
   if (this->programDependenceGraph)
     delete this->programDependenceGraph;
   this->programDependenceGraph = nullptr;
 
+  /*
+   * The code might change after this pass is invalidated.
+   */
+  this->mpa.invalidateSummaries();
+
   return;
 }
 
+MayPointsToAnalysis &PDGGenerator::getMayPointsToAnalysis(void) {
+  return this->mpa;
+}
+
 void PDGGenerator::printFunctionReachabilityResult() {
 
   /*
@@ -82,6 +129,28 @@ void PDGGenerator::printFunctionReachabilityResult() {
   return;
 }
 
+uint32_t PDGGenerator::getAnalysisOptionsOfCache(void) const {
+
+  /*
+   * Encode the options that change the dependences of the PDG.
+   */
+  uint32_t options = 0;
+  if (this->disableSVF) {
+    options |= 1 << 0;
+  }
+  if (this->disableSVFCallGraph) {
+    options |= 1 << 1;
+  }
+  if (this->disableAllocAA) {
+    options |= 1 << 2;
+  }
+  if (this->disableRA) {
+    options |= 1 << 3;
+  }
+
+  return options;
+}
+
 PDG *PDGGenerator::getPDG(void) {
 
   /*
@@ -94,9 +163,32 @@ PDG *PDGGenerator::getPDG(void) {
   /*
    * Construct the PDG
    *
-   * Check if we have already done it and the PDG has been embedded in the IR.
+   * Check if we have already done it and the PDG has been stored in the
+   * sidecar cache file.
    */
-  if (this->hasPDGAsMetadata(*this->M)) {
+  if ((this->cacheFileName != "") && (!this->embedPDGInCache)) {
+    PDGCache cache(*this->M,
+                   this->cacheFileName,
+                   this->getAnalysisOptionsOfCache());
+    this->programDependenceGraph = cache.load();
+  }
+  if (this->programDependenceGraph != nullptr) {
+    if (verbose >= PDGVerbosity::Maximal) {
+      errs() << "PDGGenerator: Load the PDG from " << this->cacheFileName
+             << "\n";
+    }
+    if (this->performThePDGComparison) {
+      auto PDGFromAnalysis = this->constructPDGFromAnalysis(*this->M);
+      auto arePDGsEquivalent =
+          this->comparePDGs(PDGFromAnalysis, this->programDependenceGraph);
+      if (!arePDGsEquivalent) {
+        errs() << "PDGGenerator: Error = PDGs constructed are not the same\n";
+        abort();
+      }
+      delete PDGFromAnalysis;
+    }
+
+  } else if (this->hasPDGAsMetadata(*this->M)) {
 
     /*
      * The PDG has been embedded in the IR.
@@ -140,6 +232,20 @@ PDG *PDGGenerator::getPDG(void) {
         delete PDGFromMetadata;
       }
     }
+
+    /*
+     * Check if we should store the PDG in the sidecar cache file.
+     */
+    if (this->cacheFileName != "") {
+      PDGCache cache(*this->M,
+                     this->cacheFileName,
+                     this->getAnalysisOptionsOfCache());
+      auto stored = cache.store(this->programDependenceGraph);
+      if ((!stored) && (verbose >= PDGVerbosity::Minimal)) {
+        errs() << "PDGGenerator: Warning = the PDG could not be stored in "
+               << this->cacheFileName << "\n";
+      }
+    }
   }
 
   /*
@@ -178,12 +284,134 @@ PDG *PDGGenerator::constructPDGFromAnalysis(Module &M) {
   constructEdgesFromAliases(pdg, M);
   constructEdgesFromControl(pdg, M);
 
+  if (verbose >= PDGVerbosity::Minimal) {
+    errs() << "PDGGenerator: Alias queries answered by the cache: "
+           << this->aliasQueryCache.getNumberOfHits() << " hits, "
+           << this->aliasQueryCache.getNumberOfMisses() << " misses\n";
+  }
+
   trimDGUsingCustomAliasAnalysis(pdg);
 
   return pdg;
 }
 
+std::set<Function *> PDGGenerator::updatePDG(
+    const std::set<Function *> &modifiedFunctions) {
+
+  /*
+   * The may-points-to summaries of the modified functions are not valid
+   * anymore.
+   */
+  for (auto F : modifiedFunctions) {
+    this->mpa.invalidateSummaryOf(F);
+  }
+
+  /*
+   * Check if the PDG has been computed.
+   * If it hasn't, it will be computed from the current code when requested.
+   */
+  auto pdg = this->programDependenceGraph;
+  if (pdg == nullptr) {
+    return modifiedFunctions;
+  }
+
+  /*
+   * The calls of the modified functions might have changed.
+   * Also, the memory dependences of a call depend on the code of its callee.
+   * Hence, the dependences of the functions that can invoke the modified ones
+   * are recomputed as well.
+   */
+  this->invalidateProgramCallGraph();
+  auto functionsToUpdate = this->fetchFunctionsThatCanInvoke(modifiedFunctions);
+  if (verbose >= PDGVerbosity::Maximal) {
+    errs() << "PDGGenerator: Update the PDG of " << functionsToUpdate.size()
+           << " functions (" << modifiedFunctions.size() << " modified)\n";
+  }
+
+  /*
+   * Replace the nodes of the functions to update.
+   * This removes all their dependences, while the dependences of the other
+   * functions are kept.
+   */
+  pdg->updateNodesOf(*this->M, functionsToUpdate);
+
+  /*
+   * Fetch the functions to update that still have a body.
+   * Functions that have been erased from the module are skipped without
+   * dereferencing them.
+   */
+  std::vector<Function *> functions;
+  for (auto &F : *this->M) {
+    if (functionsToUpdate.find(&F) == functionsToUpdate.end()) {
+      continue;
+    }
+    if (F.empty()) {
+      continue;
+    }
+    functions.push_back(&F);
+  }
+
+  /*
+   * Compute the dependences of the modified functions.
+   */
+  for (auto F : functions) {
+    this->constructEdgesFromUseDefsForFunction(pdg, *F);
+  }
+  this->constructEdgesFromAliases(pdg, functions);
+  for (auto F : functions) {
+    this->constructEdgesFromControlForFunction(pdg, *F);
+  }
+
+  /*
+   * Trim the new dependences.
+   */
+  std::vector<DGEdge<Value, Value> *> newEdges;
+  for (auto F : functions) {
+    auto addOutgoingEdges = [pdg, &newEdges](Value *v) {
+      auto node = pdg->fetchNode(v);
+      for (auto edge : node->getOutgoingEdges()) {
+        newEdges.push_back(edge);
+      }
+    };
+    for (auto &arg : F->args()) {
+      addOutgoingEdges(&arg);
+    }
+    for (auto &I : instructions(*F)) {
+      addOutgoingEdges(&I);
+    }
+  }
+  this->trimDGUsingCustomAliasAnalysis(pdg, newEdges);
+
+  return functionsToUpdate;
+}
+
+void PDGGenerator::updatePDG(
+    const std::set<Instruction *> &modifiedInstructions) {
+
+  /*
+   * Dependences are recomputed at the granularity of functions.
+   */
+  std::set<Function *> modifiedFunctions;
+  for (auto inst : modifiedInstructions) {
+    modifiedFunctions.insert(inst->getFunction());
+  }
+  this->updatePDG(modifiedFunctions);
+
+  return;
+}
+
 void PDGGenerator::trimDGUsingCustomAliasAnalysis(PDG *pdg) {
+  std::vector<DGEdge<Value, Value> *> edges(pdg->begin_edges(),
+                                            pdg->end_edges());
+
+  this->trimDGUsingCustomAliasAnalysis(pdg, edges);
+
+  return;
+}
+
+void PDGGenerator::trimDGUsingCustomAliasAnalysis(
+    PDG *pdg,
+    const std::vector<DGEdge<Value, Value> *> &edges) {
 
   /*
    * Fetch AllocAA
@@ -195,10 +423,27 @@ void PDGGenerator::trimDGUsingCustomAliasAnalysis(PDG *pdg) {
 
   /*
    * Invoke AllocAA
-   * Fetch and invoke MayPointsToAnalysis
+   * Fetch and invoke MayPointsToAnalysis.
+   * Its summaries are computed when queried, unless the memory dependences are
+   * computed in parallel: then, the summaries of the functions with memory
+   * dependences are computed up front in parallel.
    */
-  this->mpa = MayPointsToAnalysis{};
-  removeEdgesNotUsedByParSchemes(pdg);
+  if (this->parallelizeMemoryDependences) {
+    std::set<Function *> functionsWithMemoryDependences;
+    for (auto edge : edges) {
+      if (!isa<MemoryDependence<Value, Value>>(edge)) {
+        continue;
+      }
+      if (auto inst = dyn_cast<Instruction>(edge->getSrc())) {
+        functionsWithMemoryDependences.insert(inst->getFunction());
+      }
+    }
+    this->mpa.computeSummaries(
+        std::vector<Function *>(functionsWithMemoryDependences.begin(),
+                                functionsWithMemoryDependences.end()),
+        Architecture::getNumberOfLogicalCores());
+  }
+  removeEdgesNotUsedByParSchemes(pdg, edges);
 
   /*
    * Invoke the TalkDown
@@ -215,56 +460,191 @@ void PDGGenerator::constructEdgesFromUseDefs(PDG *pdg) {
    * Add the dependences due to variables.
    */
   for (auto node : make_range(pdg->begin_nodes(), pdg->end_nodes())) {
-
-    /*
-     * Check the current definition has uses.
-     * If it doesn't, then there is no variable dependence.
-     */
     auto pdgValue = node->getT();
-    if (pdgValue->getNumUses() == 0) {
+    this->constructEdgesFromUsesOf(pdg, pdgValue);
+  }
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromUseDefsForFunction(PDG *pdg,
+                                                        Function &F) {
+
+  /*
+   * Add the dependences due to variables defined in @F.
+   * Uses of arguments and instructions are all within @F.
+   */
+  for (auto &arg : F.args()) {
+    this->constructEdgesFromUsesOf(pdg, &arg);
+  }
+  for (auto &I : instructions(F)) {
+    this->constructEdgesFromUsesOf(pdg, &I);
+  }
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromUsesOf(PDG *pdg, Value *pdgValue) {
+
+  /*
+   * Check the current definition has uses.
+   * If it doesn't, then there is no variable dependence.
+   */
+  if (pdgValue->getNumUses() == 0) {
+    return;
+  }
+
+  /*
+   * The current definition has uses.
+   * Add the uses.
+   */
+  for (auto &U : pdgValue->uses()) {
+    auto user = U.getUser();
+
+    if (isa<Instruction>(user) || isa<Argument>(user)) {
+      pdg->addVariableDataDependenceEdge(pdgValue, user, DG_DATA_RAW);
+    }
+  }
+
+  return;
+}
+
+static bool isMemoryInstruction(Instruction *i) {
+  if (isa<LoadInst>(i)) {
+    return true;
+  }
+  if (isa<StoreInst>(i)) {
+    return true;
+  }
+  if (isa<CallBase>(i)) {
+    return true;
+  }
+  return false;
+}
+
+void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
+
+  /*
+   * Fetch the functions with a body.
+   */
+  std::vector<Function *> functions;
+  for (auto &F : M) {
+    if (F.empty()) {
       continue;
     }
+    functions.push_back(&F);
+  }
+
+  /*
+   * Add the memory dependences.
+   */
+  this->constructEdgesFromAliases(pdg, functions);
+
+  return;
+}
+
+void PDGGenerator::constructEdgesFromAliases(
+    PDG *pdg,
+    const std::vector<Function *> &functions) {
+
+  /*
+   * Check if the memory dependences of different functions should be
+   * collected in parallel.
+   */
+  if (this->parallelizeMemoryDependences) {
+    this->constructEdgesFromAliasesInParallel(pdg, functions);
+    return;
+  }
+
+  /*
+   * Use alias analysis on stores, loads, and function calls to construct PDG
+   * edges.
+   * Functions are processed one at a time on the current thread; the
+   * reachable analyses run in parallel only when requested (see
+   * constructEdgesFromAliasesInParallel).
+   */
+  for (auto F : functions) {
 
     /*
-     * The current definition has uses.
-     * Add the uses.
+     * Run the reachable analysis.
      */
-    for (auto &U : pdgValue->uses()) {
-      auto user = U.getUser();
+    auto dfr = this->disableRA
+                   ? this->dfa.getFullSets(F)
+                   : this->dfa.runReachableAnalysis(F, isMemoryInstruction);
 
-      if (isa<Instruction>(user) || isa<Argument>(user)) {
-        pdg->addVariableDataDependenceEdge(pdgValue, user, DG_DATA_RAW);
-      }
-    }
+    /*
+     * Add the edges to the PDG.
+     */
+    constructEdgesFromAliasesForFunction(pdg, *F, dfr);
+
+    /*
+     * Free the memory.
+     */
+    delete dfr;
   }
 
   return;
 }
 
-void PDGGenerator::constructEdgesFromAliases(PDG *pdg, Module &M) {
+void PDGGenerator::constructEdgesFromAliasesInParallel(
+    PDG *pdg,
+    const std::vector<Function *> &functions) {
 
   /*
-   * Use alias analysis on stores, loads, and function calls to construct PDG
-   * edges
+   * Functions are processed in windows to bound the memory used to keep the
+   * candidates of the functions that have not been added to the PDG yet.
    */
-  for (auto &F : M) {
+  WorkStealingPool pool{};
+  uint64_t windowSize = pool.getNumberOfWorkers() * 4;
+  for (uint64_t windowBegin = 0; windowBegin < functions.size();
+       windowBegin += windowSize) {
+    auto windowEnd =
+        std::min<uint64_t>(windowBegin + windowSize, functions.size());
 
     /*
-     * Check if the function has a body.
+     * Collect the candidates of the functions of the window in parallel.
+     * Each function has its own buffer.
      */
-    if (F.empty())
-      continue;
+    std::vector<std::vector<MemoryDependenceCandidate>> buffers(
+        windowEnd - windowBegin);
+    pool.run(windowEnd - windowBegin,
+             [this, &functions, &buffers, windowBegin](uint64_t taskID,
+                                                       uint32_t) {
+               auto F = functions[windowBegin + taskID];
+               auto dfr =
+                   this->disableRA
+                       ? this->dfa.getFullSets(F)
+                       : this->dfa.runReachableAnalysis(F, isMemoryInstruction);
+               this->collectMemoryDependenceCandidates(*F,
+                                                       dfr,
+                                                       buffers[taskID]);
+               delete dfr;
+             });
 
     /*
      * Add the edges to the PDG.
+     * Alias analyses are not thread safe, so they are queried here, one
+     * function at a time, following the order of the functions in the module.
+     * Hence, the PDG is the same as the one computed sequentially.
      */
-    constructEdgesFromAliasesForFunction(pdg, F);
+    for (auto i = windowBegin; i < windowEnd; i++) {
+      auto F = functions[i];
+      auto &AA = getAnalysis<AAResultsWrapperPass>(*F).getAAResults();
+      this->aliasQueryCache.clear();
+      this->addEdgesFromMemoryDependenceCandidates(pdg,
+                                                   *F,
+                                                   AA,
+                                                   buffers[i - windowBegin]);
+    }
   }
 
   return;
 }
 
-void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
+void PDGGenerator::constructEdgesFromAliasesForFunction(
+    PDG *pdg,
+    Function &F,
+    DataFlowBitVectorResult *dfr) {
 
   /*
    * Fetch the alias analysis.
@@ -272,61 +652,35 @@ void PDGGenerator::constructEdgesFromAliasesForFunction(PDG *pdg, Function &F) {
   auto &AA = getAnalysis<AAResultsWrapperPass>(F).getAAResults();
 
   /*
-   * Run the reachable analysis.
+   * Alias analyses are specific to @F, so their results cannot be reused
+   * across functions.
    */
-  auto onlyMemoryInstructionFilter = [](Instruction *i) -> bool {
-    if (isa<LoadInst>(i)) {
-      return true;
-    }
-    if (isa<StoreInst>(i)) {
-      return true;
-    }
-    if (isa<CallBase>(i)) {
-      return true;
-    }
-    return false;
-  };
-  auto dfr =
-      this->disableRA
-          ? this->dfa.getFullSets(&F)
-          : this->dfa.runReachableAnalysis(&F, onlyMemoryInstructionFilter);
-
-  for (auto &B : F) {
-    for (auto &I : B) {
-
-      /*
-       * Check if the instruction can access memory.
-       */
-      if (!PDGGenerator::canAccessMemory(&I)) {
-        continue;
-      }
-
-      /*
-       * Check the memory dependences that start from @I
-       */
-      if (auto store = dyn_cast<StoreInst>(&I)) {
-        iterateInstForStore(pdg, F, AA, dfr, store);
-      } else if (auto load = dyn_cast<LoadInst>(&I)) {
-        iterateInstForLoad(pdg, F, AA, dfr, load);
-      } else if (auto call = dyn_cast<CallBase>(&I)) {
-        iterateInstForCall(pdg, F, AA, dfr, call);
-      }
-    }
-  }
+  this->aliasQueryCache.clear();
 
   /*
-   * Free the memory.
+   * Add the memory dependences that might start from each instruction.
+   * The candidates of an instruction are queried right after they have been
+   * collected, so only the candidates of one instruction are kept at a time.
    */
-  delete dfr;
+  std::vector<MemoryDependenceCandidate> candidates;
+  for (auto &I : instructions(F)) {
+    candidates.clear();
+    this->collectMemoryDependenceCandidates(I, dfr, candidates);
+    this->addEdgesFromMemoryDependenceCandidates(pdg, F, AA, candidates);
+  }
+
+  return;
 }
 
-void PDGGenerator::removeEdgesNotUsedByParSchemes(PDG *pdg) {
+void PDGGenerator::removeEdgesNotUsedByParSchemes(
+    PDG *pdg,
+    const std::vector<DGEdge<Value, Value> *> &edges) {
   std::set<DGEdge<Value, Value> *> removeEdges;
 
   /*
-   * Collect the edges in the PDG that can be safely removed.
+   * Collect the edges given as input that can be safely removed.
    */
-  for (auto edge : pdg->getEdges()) {
+  for (auto edge : edges) {
 
     /*
      * Fetch the source of the dependence.
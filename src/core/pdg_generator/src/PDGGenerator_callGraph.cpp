@@ -145,8 +145,67 @@ noelle::CallGraph *PDGGenerator::getProgramCallGraph(void) {
   return this->noelleCG;
 }
 
+void PDGGenerator::invalidateProgramCallGraph(void) {
+  if (this->noelleCG == nullptr) {
+    return;
+  }
+
+  /*
+   * Users of the call graph might still hold it.
+   * Hence, it is freed when this pass is released.
+   */
+  this->invalidatedCallGraphs.push_back(this->noelleCG);
+  this->noelleCG = nullptr;
+
+  return;
+}
+
+std::set<Function *> PDGGenerator::fetchFunctionsThatCanInvoke(
+    const std::set<Function *> &functions) {
+
+  /*
+   * Fetch the nodes of the functions that are still in the program.
+   * Functions that have been erased are not dereferenced.
+   */
+  auto callGraph = this->getProgramCallGraph();
+  std::set<Function *> callers{ functions };
+  std::queue<CallGraphFunctionNode *> nodesToVisit;
+  for (auto &F : *this->M) {
+    if (functions.find(&F) == functions.end()) {
+      continue;
+    }
+    auto node = callGraph->getFunctionNode(&F);
+    if (node != nullptr) {
+      nodesToVisit.push(node);
+    }
+  }
+
+  /*
+   * Walk the call graph backward.
+   */
+  while (!nodesToVisit.empty()) {
+    auto node = nodesToVisit.front();
+    nodesToVisit.pop();
+    for (auto edge : callGraph->getIncomingEdges(node)) {
+      auto callerNode = edge->getCaller();
+      if (callers.insert(callerNode->getFunction()).second) {
+        nodesToVisit.push(callerNode);
+      }
+    }
+  }
+
+  return callers;
+}
+
 void PDGGenerator::identifyFunctionsThatInvokeUnhandledLibrary(Module &M) {
 
+  /*
+   * Forget the functions of the previous run, which might have been erased.
+   */
+  this->internalFuncs.clear();
+  this->unhandledExternalFuncs.clear();
+  this->reachableUnhandledExternalFuncs.clear();
+
   /*
    * Collect internal and unhandled external functions.
    */
@@ -77,48 +77,56 @@ std::pair<bool, bool> PDGGenerator::isThereThisMemoryDataDependenceType(
   return std::make_pair(noDep, mustExist);
 }
 
-void PDGGenerator::iterateInstForStore(PDG *pdg,
-                                       Function &F,
-                                       AAResults &AA,
-                                       DataFlowResult *dfr,
-                                       StoreInst *store) {
+void PDGGenerator::collectMemoryDependenceCandidates(
+    Function &F,
+    DataFlowBitVectorResult *dfr,
+    std::vector<MemoryDependenceCandidate> &candidates) {
 
-  for (auto I : dfr->OUT(store)) {
+  for (auto &I : instructions(F)) {
+    this->collectMemoryDependenceCandidates(I, dfr, candidates);
+  }
 
-    /*
-     * Check if the instruction can access memory.
-     */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
-    if (!PDGGenerator::canAccessMemory(inst)) {
-      continue;
-    }
+  return;
+}
 
-    /*
-     * The instruction can access memory.
-     *
-     * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @store to @I.
-     */
-    if (!this->canThereBeAMemoryDataDependence(store, inst, F)) {
-      continue;
-    }
+void PDGGenerator::collectMemoryDependenceCandidates(
+    Instruction &I,
+    DataFlowBitVectorResult *dfr,
+    std::vector<MemoryDependenceCandidate> &candidates) {
 
-    /*
-     * Check stores.
-     */
-    if (auto otherStore = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, otherStore, DG_DATA_WAW);
-      continue;
-    }
+  /*
+   * Check if the instruction can access memory.
+   */
+  if (!PDGGenerator::canAccessMemory(&I)) {
+    return;
+  }
+
+  /*
+   * Collect the memory dependences that might start from @I
+   */
+  if (auto store = dyn_cast<StoreInst>(&I)) {
+    iterateInstForStore(dfr, store, candidates);
+  } else if (auto load = dyn_cast<LoadInst>(&I)) {
+    iterateInstForLoad(dfr, load, candidates);
+  } else if (auto call = dyn_cast<CallBase>(&I)) {
+    iterateInstForCall(dfr, call, candidates);
+  }
+
+  return;
+}
+
+void PDGGenerator::iterateInstForStore(
+    DataFlowBitVectorResult *dfr,
+    StoreInst *store,
+    std::vector<MemoryDependenceCandidate> &candidates) {
+
+  for (auto id : dfr->OUT(store).set_bits()) {
 
     /*
-     * Check loads.
+     * Check if the instruction can access memory.
      */
-    if (auto load = dyn_cast<LoadInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, store, load, DG_DATA_RAW);
+    auto inst = dfr->getInstruction(id);
+    if (!PDGGenerator::canAccessMemory(inst)) {
       continue;
     }
 
@@ -129,68 +137,52 @@ void PDGGenerator::iterateInstForStore(PDG *pdg,
       if (!Utils::isActualCode(call)) {
         continue;
       }
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, false);
-      continue;
     }
+
+    /*
+     * There can be a dependence from @store to @inst.
+     */
+    candidates.push_back({ store, inst, false });
   }
 
   return;
 }
 
-void PDGGenerator::iterateInstForLoad(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      LoadInst *load) {
+void PDGGenerator::iterateInstForLoad(
+    DataFlowBitVectorResult *dfr,
+    LoadInst *load,
+    std::vector<MemoryDependenceCandidate> &candidates) {
 
-  for (auto I : dfr->OUT(load)) {
+  for (auto id : dfr->OUT(load).set_bits()) {
 
     /*
      * Check if the instruction can access memory.
      */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
+    auto inst = dfr->getInstruction(id);
     if (!PDGGenerator::canAccessMemory(inst)) {
       continue;
     }
 
     /*
-     * The instruction can access memory.
-     *
-     * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @load to @I.
+     * There are no dependences between loads.
      */
-    if (!this->canThereBeAMemoryDataDependence(load, inst, F)) {
+    if (isa<LoadInst>(inst)) {
       continue;
     }
 
     /*
-     * Check stores.
-     */
-    if (auto store = dyn_cast<StoreInst>(inst)) {
-      this->addEdgeFromMemoryAlias(pdg, F, AA, load, store, DG_DATA_WAR);
-      continue;
-    }
-
-    /*
-     * Check calls.
+     * There can be a dependence from @load to @inst.
      */
-    if (auto call = dyn_cast<CallBase>(inst)) {
-      this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, false);
-      continue;
-    }
+    candidates.push_back({ load, inst, false });
   }
 
   return;
 }
 
-void PDGGenerator::iterateInstForCall(PDG *pdg,
-                                      Function &F,
-                                      AAResults &AA,
-                                      DataFlowResult *dfr,
-                                      CallBase *call) {
+void PDGGenerator::iterateInstForCall(
+    DataFlowBitVectorResult *dfr,
+    CallBase *call,
+    std::vector<MemoryDependenceCandidate> &candidates) {
 
   /*
    * Check if the call instruction is not actual code.
@@ -200,83 +192,128 @@ void PDGGenerator::iterateInstForCall(PDG *pdg,
   }
 
   /*
-   * Check if the call instruction is pure.
+   * Identify all dependences that might start from @call.
    */
-  if (this->hasNoMemoryOperations(call)) {
-    return;
-  }
+  for (auto id : dfr->OUT(call).set_bits()) {
 
-  /*
-   * Check if the instruction can access memory.
-   */
-  if (!PDGGenerator::canAccessMemory(call)) {
-    return;
+    /*
+     * Check if the instruction can access memory.
+     */
+    auto inst = dfr->getInstruction(id);
+    if (!PDGGenerator::canAccessMemory(inst)) {
+      continue;
+    }
+
+    /*
+     * Check calls.
+     */
+    auto isCallReachableFromInst = false;
+    if (auto baseOtherCall = dyn_cast<CallBase>(inst)) {
+
+      /*
+       * Check direct calls
+       */
+      if (auto otherCall = dyn_cast<CallInst>(baseOtherCall)) {
+        if (!Utils::isActualCode(otherCall)) {
+          continue;
+        }
+      }
+      auto &outOfOtherCall = dfr->OUT(baseOtherCall);
+      isCallReachableFromInst = dfr->contains(outOfOtherCall, call);
+    }
+
+    /*
+     * There can be a dependence from @call to @inst.
+     */
+    candidates.push_back({ call, inst, isCallReachableFromInst });
   }
 
+  return;
+}
+
+void PDGGenerator::addEdgesFromMemoryDependenceCandidates(
+    PDG *pdg,
+    Function &F,
+    AAResults &AA,
+    const std::vector<MemoryDependenceCandidate> &candidates) {
+
   /*
-   * Identify all dependences from @call.
+   * Candidates that start from the same instruction are contiguous.
+   * Hence, we check whether a call is pure only once per call.
    */
-  for (auto I : dfr->OUT(call)) {
+  CallBase *lastCall = nullptr;
+  auto isLastCallPure = false;
+  for (auto &candidate : candidates) {
+    auto fromInst = candidate.fromInst;
+    auto toInst = candidate.toInst;
 
     /*
-     * Check if the instruction can access memory.
+     * Check if the call instruction is pure.
      */
-    auto inst = dyn_cast<Instruction>(I);
-    if (inst == nullptr) {
-      continue;
-    }
-    if (!PDGGenerator::canAccessMemory(inst)) {
-      continue;
+    if (auto call = dyn_cast<CallBase>(fromInst)) {
+      if (call != lastCall) {
+        lastCall = call;
+        isLastCallPure = this->hasNoMemoryOperations(call);
+      }
+      if (isLastCallPure) {
+        continue;
+      }
     }
 
     /*
-     * The instruction can access memory.
-     *
      * Check if any of the data dependence analyses can assert the lack of
-     * dependence from @call to @I.
+     * dependence from @fromInst to @toInst.
      */
-    if (!this->canThereBeAMemoryDataDependence(call, inst, F)) {
+    if (!this->canThereBeAMemoryDataDependence(fromInst, toInst, F)) {
       continue;
     }
 
     /*
-     * Check stores.
+     * Dependences from stores.
      */
-    if (auto store = dyn_cast<StoreInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, store, true);
+    if (auto store = dyn_cast<StoreInst>(fromInst)) {
+      if (auto otherStore = dyn_cast<StoreInst>(toInst)) {
+        this->addEdgeFromMemoryAlias(pdg,
+                                     F,
+                                     AA,
+                                     store,
+                                     otherStore,
+                                     DG_DATA_WAW);
+      } else if (auto load = dyn_cast<LoadInst>(toInst)) {
+        this->addEdgeFromMemoryAlias(pdg, F, AA, store, load, DG_DATA_RAW);
+      } else if (auto call = dyn_cast<CallBase>(toInst)) {
+        this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, false);
+      }
       continue;
     }
 
     /*
-     * Check loads.
+     * Dependences from loads.
      */
-    if (auto load = dyn_cast<LoadInst>(inst)) {
-      addEdgeFromFunctionModRef(pdg, F, AA, call, load, true);
+    if (auto load = dyn_cast<LoadInst>(fromInst)) {
+      if (auto store = dyn_cast<StoreInst>(toInst)) {
+        this->addEdgeFromMemoryAlias(pdg, F, AA, load, store, DG_DATA_WAR);
+      } else if (auto call = dyn_cast<CallBase>(toInst)) {
+        this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, false);
+      }
       continue;
     }
 
     /*
-     * Check calls.
+     * Dependences from calls.
      */
-    if (auto baseOtherCall = dyn_cast<CallBase>(inst)) {
-
-      /*
-       * Check direct calls
-       */
-      if (auto otherCall = dyn_cast<CallInst>(baseOtherCall)) {
-        if (!Utils::isActualCode(otherCall)) {
-          continue;
-        }
-      }
-      bool isCallReachableFromOtherCall =
-          dfr->OUT(baseOtherCall).count(call) > 0 ? true : false;
+    auto call = cast<CallBase>(fromInst);
+    if (auto store = dyn_cast<StoreInst>(toInst)) {
+      this->addEdgeFromFunctionModRef(pdg, F, AA, call, store, true);
+    } else if (auto load = dyn_cast<LoadInst>(toInst)) {
+      this->addEdgeFromFunctionModRef(pdg, F, AA, call, load, true);
+    } else if (auto otherCall = dyn_cast<CallBase>(toInst)) {
       this->addEdgeFromFunctionModRef(pdg,
                                       F,
                                       AA,
                                       call,
-                                      baseOtherCall,
-                                      isCallReachableFromOtherCall);
-      continue;
+                                      otherCall,
+                                      candidate.isFromReachableFromTo);
     }
   }
 
@@ -1296,6 +1333,50 @@ AliasResult PDGGenerator::doTheyAlias(PDG *pdg,
                                       Value *instI,
                                       Value *instJ) {
 
+  /*
+   * Check if the parameters have memory locations.
+   */
+  auto instIAsInst = dyn_cast<Instruction>(instI);
+  auto instJAsInst = dyn_cast<Instruction>(instJ);
+  std::optional<MemoryLocation> memI;
+  std::optional<MemoryLocation> memJ;
+  if ((instIAsInst != nullptr) && (instJAsInst != nullptr)) {
+    auto locI = MemoryLocation::getOrNone(instIAsInst);
+    auto locJ = MemoryLocation::getOrNone(instJAsInst);
+    if (locI && locJ) {
+      memI = *locI;
+      memJ = *locJ;
+    }
+  }
+
+  /*
+   * Check if the query has been already answered.
+   */
+  auto cachedResult = memI ? this->aliasQueryCache.lookup(*memI, *memJ)
+                           : this->aliasQueryCache.lookup(instI, instJ);
+  if (cachedResult) {
+    return *cachedResult;
+  }
+
+  /*
+   * Query the alias analyses and remember the result.
+   */
+  auto aaResult = this->doTheyAliasWithoutCache(pdg, F, AA, instI, instJ);
+  if (memI) {
+    this->aliasQueryCache.insert(*memI, *memJ, aaResult);
+  } else {
+    this->aliasQueryCache.insert(instI, instJ, aaResult);
+  }
+
+  return aaResult;
+}
+
+AliasResult PDGGenerator::doTheyAliasWithoutCache(PDG *pdg,
+                                                  Function &F,
+                                                  AAResults &AA,
+                                                  Value *instI,
+                                                  Value *instJ) {
+
   /*
    * Check if the parameters have memory locations.
    */
@@ -77,6 +77,25 @@ static cl::opt<bool> PDGRADisable(
     cl::Hidden,
     cl::desc("Disable the use of reaching analysis to compute the PDG"));
 
+static cl::opt<bool> PDGParallel(
+    "noelle-pdg-parallel",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Collect the memory dependences of functions in parallel"));
+
+static cl::opt<std::string> PDGCacheFile(
+    "noelle-pdg-cache",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::init(""),
+    cl::desc("Load the PDG from (or store it to) the given sidecar file"));
+
+static cl::opt<bool> PDGCacheEmbed(
+    "noelle-pdg-cache-embed",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc("Compute the PDG and store it to the sidecar file"));
+
 bool PDGGenerator::doInitialization(Module &M) {
   this->verbose = static_cast<PDGVerbosity>(PDGVerbose.getValue());
   this->embedPDG = (PDGEmbed.getNumOccurrences() > 0) ? true : false;
@@ -90,6 +109,11 @@ bool PDGGenerator::doInitialization(Module &M) {
   this->disableAllocAA =
       (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   this->disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  this->parallelizeMemoryDependences =
+      (PDGParallel.getNumOccurrences() > 0) ? true : false;
+  this->cacheFileName = PDGCacheFile.getValue();
+  this->embedPDGInCache =
+      (PDGCacheEmbed.getNumOccurrences() > 0) ? true : false;
 
   return false;
 }
@@ -112,7 +136,7 @@ bool PDGGenerator::runOnModule(Module &M) {
   /*
    * Check if the pass has already run.
    */
-  if ((this->M != nullptr) || (this->programDependenceGraph != nullptr)) {
+  if (this->M != nullptr) {
     return false;
   }
 
@@ -131,10 +155,18 @@ bool PDGGenerator::runOnModule(Module &M) {
    */
   identifyFunctionsThatInvokeUnhandledLibrary(M);
 
+  /*
+   * Check if the PDG has been kept from the previous run of the pass manager.
+   */
+  if (this->programDependenceGraph != nullptr) {
+    return false;
+  }
+
   /*
    * Check if we should compute the PDG.
    */
-  if ((this->dumpPDG) || (this->embedPDG) || (this->embedSCC)) {
+  if ((this->dumpPDG) || (this->embedPDG) || (this->embedSCC)
+      || (this->embedPDGInCache)) {
 
     /*
      * Construct PDG because this will trigger code that is needed by the
@@ -144,6 +144,14 @@ private:
    * Compute transitive dependences between nodes of the SCCDAG.
    */
   void computeReachabilityAmongSCCs(void);
+
+  /*
+   * Arena of the SCCs of the SCCDAG.
+   * SCCs are destroyed with the SCCDAG, including those merged away.
+   */
+  SpecificBumpPtrAllocator<SCC> sccAllocator;
+
+  SCC *allocateSCC(std::set<DGNode<Value> *> &nodes);
 };
 
 } // namespace arcana::noelle
@@ -20,8 +20,7 @@
  OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "arcana/noelle/core/SystemHeaders.hpp"
-#include "arcana/noelle/core/DGGraphTraits.hpp"
-#include "arcana/noelle/core/PDGTraits.hpp"
+#include "arcana/noelle/core/FrozenDG.hpp"
 #include "arcana/noelle/core/SCCDAG.hpp"
 #include "llvm/InitializePasses.h"
 
@@ -32,54 +31,45 @@ SCCDAG::SCCDAG(PDG *pdg) {
   /*
    * Create nodes of the SCCDAG.
    *
-   * Iterate over all nodes in the PDG to calculate strongly connected
-   * components (see Tarjan's DFS algo).
+   * Compute the strongly connected components of the PDG (see Tarjan's DFS
+   * algo) on a snapshot of the PDG where nodes are identified by indices.
    */
-  std::set<DGNode<Value> *> visited;
-  DGNode<Value> *originalEntryNode = pdg->getEntryNode();
+  FrozenDG<Value> frozenPDG(*pdg);
+  std::vector<uint32_t> sccOfNode;
+  auto numberOfSCCs = frozenPDG.computeSCCs(sccOfNode);
 
-  for (auto nodeToVisit : pdg->getNodes()) {
-    if (visited.find(nodeToVisit) != visited.end())
-      continue;
-
-    pdg->setEntryNode(nodeToVisit);
-
-    DGGraphWrapper<PDG, Value> pdgWrapper(pdg);
-
-    for (auto pdgI = scc_begin(&pdgWrapper); pdgI != scc_end(&pdgWrapper);
-         ++pdgI) {
-
-      /*
-       * Identify a new SCC.
-       */
-      const std::vector<DGNodeWrapper<Value> *> &sccNodes = *pdgI;
-      auto firstNodeWrapper = *sccNodes.begin();
-      auto firstNode = firstNodeWrapper->wrappedNode;
-      if (visited.find(firstNode) != visited.end()) {
-        continue;
-      }
-
-      std::set<DGNode<Value> *> unwrappedNodes{};
-      for (auto sccNode : sccNodes) {
-        unwrappedNodes.insert(sccNode->wrappedNode);
-      }
-
-      /*
-       * Add a new SCC to the SCCDAG.
-       */
-      visited.insert(unwrappedNodes.begin(), unwrappedNodes.end());
-      auto scc = new SCC(unwrappedNodes);
-      auto isInternal = false;
-      for (auto node : unwrappedNodes) {
-        isInternal |= pdg->isInternal(node->getT());
-      }
+  /*
+   * Group the nodes of the PDG by SCC.
+   */
+  auto numberOfNodes = frozenPDG.getNumberOfNodes();
+  std::vector<uint32_t> sccOffsets(numberOfSCCs + 1, 0);
+  for (uint32_t nodeID = 0; nodeID < numberOfNodes; nodeID++) {
+    sccOffsets[sccOfNode[nodeID] + 1]++;
+  }
+  for (uint32_t sccID = 0; sccID < numberOfSCCs; sccID++) {
+    sccOffsets[sccID + 1] += sccOffsets[sccID];
+  }
+  std::vector<uint32_t> nodesOfSCCs(numberOfNodes);
+  auto nextSlots = sccOffsets;
+  for (uint32_t nodeID = 0; nodeID < numberOfNodes; nodeID++) {
+    nodesOfSCCs[nextSlots[sccOfNode[nodeID]]++] = nodeID;
+  }
 
-      this->addNode(scc, /*inclusion=*/isInternal);
+  /*
+   * Add the SCCs to the SCCDAG.
+   */
+  for (uint32_t sccID = 0; sccID < numberOfSCCs; sccID++) {
+    std::set<DGNode<Value> *> sccNodes{};
+    auto isInternal = false;
+    for (auto i = sccOffsets[sccID]; i < sccOffsets[sccID + 1]; i++) {
+      auto nodeID = nodesOfSCCs[i];
+      sccNodes.insert(frozenPDG.getNode(nodeID));
+      isInternal |= frozenPDG.isInternal(nodeID);
     }
+    auto scc = this->allocateSCC(sccNodes);
+    this->addNode(scc, /*inclusion=*/isInternal);
   }
 
-  pdg->setEntryNode(originalEntryNode);
-
   /*
    * Create the map from a Value to an SCC included in the SCCDAG.
    */
@@ -200,7 +190,26 @@ void SCCDAG::mergeSCCs(std::set<DGNode<SCC> *> &sccSet) {
    * for that context mismatch and properly copies edges WITHOUT duplicating any
    * nodes or edges.
    */
-  auto mergeSCC = new SCC(mergeNodes);
+  auto mergeSCC = this->allocateSCC(mergeNodes);
+
+  /*
+   * Update the reachability among SCCs.
+   * The merged SCC takes the smallest index of the SCCs it replaces, so the
+   * indexes of all other SCCs are unchanged.
+   */
+  if (!orderedDirty) {
+    BitVector merged(this->ordered.size());
+    auto mergeSCCid = UINT32_MAX;
+    for (auto sccNode : sccSet) {
+      auto sccF = sccIndexes.find(sccNode->getT());
+      assert(sccF != sccIndexes.end());
+      merged.set(sccF->second);
+      mergeSCCid = std::min(mergeSCCid, sccF->second);
+      sccIndexes.erase(sccF);
+    }
+    this->ordered.mergeInto(mergeSCCid, merged);
+    sccIndexes[mergeSCC] = mergeSCCid;
+  }
 
   /*
    * Add the new SCC and remove the old ones
@@ -374,8 +383,11 @@ void SCCDAG::computeReachabilityAmongSCCs(void) {
    * Compute indices for all SCC nodes.
    */
   uint32_t index = 0;
-  for (const auto *SCCNode : this->getNodes()) {
+  std::vector<DGNode<SCC> *> sccNodes;
+  sccNodes.reserve(Nscc);
+  for (auto *SCCNode : this->getNodes()) {
     sccIndexes[SCCNode->getT()] = index;
+    sccNodes.push_back(SCCNode);
     index++;
   }
 
@@ -393,10 +405,48 @@ void SCCDAG::computeReachabilityAmongSCCs(void) {
     ordered.set(sccIndexes[srcSCC], sccIndexes[dstSCC]);
   }
 
+  /*
+   * Sort the SCC nodes in reverse topological order (a post-order visit).
+   */
+  std::vector<uint32_t> postOrder;
+  postOrder.reserve(Nscc);
+  BitVector visited(Nscc);
+  std::vector<std::pair<uint32_t, int>> stack;
+  for (uint32_t root = 0; root < Nscc; root++) {
+    if (visited.test(root)) {
+      continue;
+    }
+    visited.set(root);
+    stack.push_back({ root, -1 });
+    while (!stack.empty()) {
+      auto &top = stack.back();
+      auto &successors = ordered.getRow(top.first);
+      auto next = (top.second == -1) ? successors.find_first()
+                                      : successors.find_next(top.second);
+      while ((next != -1) && visited.test(next)) {
+        next = successors.find_next(next);
+      }
+      if (next == -1) {
+        postOrder.push_back(top.first);
+        stack.pop_back();
+        continue;
+      }
+      top.second = next;
+      visited.set(next);
+      stack.push_back({ (uint32_t)next, -1 });
+    }
+  }
+
   /*
    * Compute transitive closure of the bitMatrix.
    */
-  ordered.transitiveClosure();
+  ordered.transitiveClosureOfDAG(postOrder);
+}
+
+SCC *SCCDAG::allocateSCC(std::set<DGNode<Value> *> &nodes) {
+  auto scc = new (this->sccAllocator.Allocate()) SCC(nodes);
+
+  return scc;
 }
 
 uint32_t SCCDAG::getSCCIndex(const SCC *scc) const {
@@ -845,7 +845,7 @@ void LoopScheduler::gatherNecessaryLoopState(void) {
   /*
    * Acquire latch
    */
-  auto Latches = this->TheLoop->getLatches();
+  auto &Latches = this->TheLoop->getLatches();
 
   assert(Latches.size() == 1
          && "Scheduler can't handle loops with multiple latches!");
@@ -855,8 +855,8 @@ void LoopScheduler::gatherNecessaryLoopState(void) {
   /*
    * Acquire loop blocks
    */
-  this->Blocks = std::set<BasicBlock *>(this->TheLoop->getBasicBlocks().begin(),
-                                        this->TheLoop->getBasicBlocks().end());
+  auto &loopBlocks = this->TheLoop->getBasicBlocks();
+  this->Blocks = std::set<BasicBlock *>(loopBlocks.begin(), loopBlocks.end());
 
   /*
    * Acquire exit edges
@@ -1120,7 +1120,10 @@ bool LoopScheduler::moveInstIntoSuccessor(Instruction *I,
    * Move the instruction to the correct insertion point
    */
   Instruction *InsertionPoint = Successor->getFirstNonPHI();
+  auto OriginalBlock = I->getParent();
   I->moveBefore(InsertionPoint);
+  this->DS->invalidateInstructionOrdinals(OriginalBlock);
+  this->DS->invalidateInstructionOrdinals(Successor);
 
   /*
    * Resolve any successor PHINodes
@@ -1146,6 +1149,7 @@ bool LoopScheduler::cloneInstIntoSuccessor(Instruction *I,
               *Clone = I->clone();
 
   Clone->insertBefore(InsertionPoint);
+  this->DS->invalidateInstructionOrdinals(Successor);
 
   /*
    * Resolve any successor PHINodes
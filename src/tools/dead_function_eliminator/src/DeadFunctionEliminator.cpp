@@ -40,6 +40,7 @@ bool DeadFunctionEliminator::runOnModule(Module &M) {
     return false;
   }
   auto modified = false;
+  std::set<Function *> modifiedFunctions;
   errs() << this->prefix << "Start\n";
 
   /*
@@ -147,10 +148,15 @@ bool DeadFunctionEliminator::runOnModule(Module &M) {
     assert(callInst->getCalledFunction() == nodeFunction);
     errs() << this->prefix << "    Inline " << *callInst << " into "
            << callInst->getFunction()->getName() << "\n";
+    auto callerFunction = callInst->getFunction();
     InlineFunctionInfo IFI;
-    modified |= InlineFunction(callInst, IFI);
+    if (InlineFunction(callInst, IFI)) {
+      modifiedFunctions.insert(callerFunction);
+      modified = true;
+    }
   }
   if (modified) {
+    noelle.updateProgramDependenceGraph(modifiedFunctions);
     errs() << this->prefix << "Exit\n";
     return true;
   }
@@ -230,9 +236,18 @@ bool DeadFunctionEliminator::runOnModule(Module &M) {
   }
   for (auto f : toDelete) {
     f->eraseFromParent();
+    modifiedFunctions.insert(f);
     modified = true;
   }
 
+  /*
+   * Drop what NOELLE knows about the deleted functions.
+   * They are not dereferenced anymore.
+   */
+  if (modified) {
+    noelle.updateProgramDependenceGraph(modifiedFunctions);
+  }
+
   errs() << this->prefix << "Exit\n";
   return modified;
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
+#define NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
+
+#include "arcana/noelle/core/SystemHeaders.hpp"
+#include "arcana/noelle/core/Noelle.hpp"
+#include "llvm/IR/ModuleSlotTracker.h"
+#include "llvm/Support/MD5.h"
+
+namespace arcana::noelle {
+
+/*
+ * Run a pipeline of passes on the module until the module does not change
+ * anymore.
+ *
+ * The module is kept in memory across rounds and so is the pipeline: every
+ * pass runs in its own pass manager, which is created once.
+ * The NOELLE analyses required by a pass are kept across rounds as well, and
+ * only the analyses of the functions that changed are computed again.
+ * After every round that changes the module, only the functions that changed
+ * are normalized again.
+ * Changes are detected by comparing hashes of the textual IR of the functions
+ * and of the globals.
+ * The module is hashed again only after the passes that report a change.
+ * After the normalization, only the functions normalized are hashed again,
+ * unless a normalization pass works on the whole module.
+ */
+class FixedPoint : public ModulePass {
+public:
+  /*
+   * Class fields
+   */
+  static char ID;
+
+  /*
+   * Methods
+   */
+  FixedPoint();
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  /*
+   * A pass to run until the fixed point, together with the analyses it needs.
+   */
+  struct Stage {
+    std::unique_ptr<legacy::PassManager> passes;
+    Noelle *noelle;
+  };
+
+  /*
+   * Consecutive normalization passes that work on either single functions or
+   * the whole module.
+   */
+  struct NormalizationStep {
+    std::unique_ptr<legacy::FunctionPassManager> functionPasses;
+    std::unique_ptr<legacy::PassManager> modulePasses;
+  };
+
+  std::vector<std::string> passNames;
+  std::vector<std::string> normalizationPassNames;
+  std::string prefix;
+
+  bool buildStages(Module &M, std::vector<Stage> &stages) const;
+
+  bool buildNormalization(Module &M,
+                          std::vector<NormalizationStep> &steps) const;
+
+  Pass *createPass(const std::string &name) const;
+
+  bool reportChanges(Module &M,
+                     std::unordered_map<Function *, uint64_t> &functionHashes,
+                     uint64_t &globalsHash,
+                     std::vector<Stage> &stages,
+                     std::set<Function *> &changedFunctions) const;
+
+  bool reportChangesOf(Module &M,
+                       const std::set<Function *> &functions,
+                       std::unordered_map<Function *, uint64_t> &functionHashes,
+                       std::vector<Stage> &stages,
+                       std::set<Function *> &changedFunctions) const;
+
+  void invalidateAnalyses(std::vector<Stage> &stages,
+                          const std::set<Function *> &changed,
+                          bool globalsChanged) const;
+
+  std::unordered_map<Function *, uint64_t> hashFunctions(Module &M) const;
+
+  std::unordered_map<Function *, uint64_t> hashFunctions(
+      Module &M,
+      const std::set<Function *> &functions) const;
+
+  uint64_t hashGlobals(Module &M) const;
+
+  uint64_t hashText(StringRef text) const;
+};
+
+} // namespace arcana::noelle
+
+#endif // NOELLE_SRC_TOOLS_FIXED_POINT_FIXEDPOINT_H_
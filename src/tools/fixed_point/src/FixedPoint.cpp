@@ -0,0 +1,434 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "llvm/PassInfo.h"
+#include "llvm/PassRegistry.h"
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+FixedPoint::FixedPoint() : ModulePass{ ID }, prefix{ "FixedPoint: " } {
+  return;
+}
+
+bool FixedPoint::runOnModule(Module &M) {
+
+  /*
+   * Check if there is something to run.
+   */
+  if (this->passNames.empty()) {
+    return false;
+  }
+  errs() << this->prefix << "Start\n";
+
+  /*
+   * Create the pipeline.
+   * It is kept across rounds, so the analyses it includes (e.g., NOELLE) are
+   * computed again only for the code that changed.
+   */
+  std::vector<Stage> stages;
+  std::vector<NormalizationStep> normalization;
+  if (!this->buildStages(M, stages)
+      || !this->buildNormalization(M, normalization)) {
+    errs() << this->prefix << "Exit\n";
+    return false;
+  }
+
+  /*
+   * Hash the module given as input.
+   */
+  auto functionHashes = this->hashFunctions(M);
+  auto globalsHash = this->hashGlobals(M);
+
+  /*
+   * Run the passes until the module does not change anymore.
+   */
+  auto modified = false;
+  uint32_t rounds = 0;
+  while (true) {
+    errs() << this->prefix << "  Round " << rounds << "\n";
+
+    /*
+     * Run the passes.
+     * The changes of every pass are reported to the analyses kept by all
+     * passes.
+     */
+    auto start = std::chrono::steady_clock::now();
+    auto changed = false;
+    std::set<Function *> changedFunctions;
+    for (auto &stage : stages) {
+      if (!stage.passes->run(M)) {
+        continue;
+      }
+      if (this->reportChanges(M,
+                              functionHashes,
+                              globalsHash,
+                              stages,
+                              changedFunctions)) {
+        changed = true;
+      }
+    }
+    auto passesEnd = std::chrono::steady_clock::now();
+    auto passesTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        passesEnd - start);
+    errs() << this->prefix << "    Passes: " << passesTime.count() << " ms\n";
+
+    /*
+     * Check if the module has changed.
+     */
+    if (!changed) {
+      break;
+    }
+    modified = true;
+    errs() << this->prefix << "    " << changedFunctions.size()
+           << " functions have changed\n";
+
+    /*
+     * Normalize the functions that have changed.
+     * Functions are visited in the order they appear in the module to keep
+     * the output deterministic.
+     */
+    std::set<Function *> normalizedFunctions;
+    auto moduleNormalized = false;
+    for (auto &step : normalization) {
+      if (step.modulePasses != nullptr) {
+        moduleNormalized |= step.modulePasses->run(M);
+        continue;
+      }
+      step.functionPasses->doInitialization();
+      for (auto &F : M) {
+        if (F.empty() || (changedFunctions.count(&F) == 0)) {
+          continue;
+        }
+        step.functionPasses->run(F);
+        normalizedFunctions.insert(&F);
+      }
+      step.functionPasses->doFinalization();
+    }
+
+    /*
+     * Only the functions normalized can have changed, unless a normalization
+     * pass changed the whole module.
+     */
+    std::set<Function *> changedByNormalization;
+    if (moduleNormalized) {
+      this->reportChanges(M,
+                          functionHashes,
+                          globalsHash,
+                          stages,
+                          changedByNormalization);
+    } else {
+      this->reportChangesOf(M,
+                            normalizedFunctions,
+                            functionHashes,
+                            stages,
+                            changedByNormalization);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto normalizationTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end - passesEnd);
+    errs() << this->prefix << "    Normalization: " << normalizationTime.count()
+           << " ms\n";
+
+    /*
+     * Be ready for another round.
+     */
+    rounds++;
+  }
+  errs() << this->prefix << "  Iteration count = " << rounds << "\n";
+
+  errs() << this->prefix << "Exit\n";
+  return modified;
+}
+
+bool FixedPoint::buildStages(Module &M, std::vector<Stage> &stages) const {
+
+  /*
+   * Split the analyses (e.g., alias analyses) from the passes that transform
+   * the code.
+   */
+  auto registry = PassRegistry::getPassRegistry();
+  std::vector<std::string> analyses;
+  std::vector<std::string> transformations;
+  for (auto &name : this->passNames) {
+    auto passInfo = registry->getPassInfo(name);
+    if ((passInfo == nullptr) || (passInfo->getNormalCtor() == nullptr)) {
+      errs() << this->prefix << "ERROR: the pass " << name
+             << " is not available\n";
+      return false;
+    }
+    if (passInfo->isAnalysis()) {
+      analyses.push_back(name);
+    } else {
+      transformations.push_back(name);
+    }
+  }
+
+  /*
+   * Every transformation runs in its own pass manager, together with the
+   * analyses given.
+   */
+  for (auto &name : transformations) {
+    Stage stage;
+    stage.passes = std::make_unique<legacy::PassManager>();
+    stage.noelle = nullptr;
+    for (auto &analysis : analyses) {
+      stage.passes->add(this->createPass(analysis));
+    }
+
+    /*
+     * Check if the transformation requires NOELLE.
+     * In this case, NOELLE is added explicitly to keep its analyses across
+     * rounds.
+     */
+    auto pass = this->createPass(name);
+    AnalysisUsage AU;
+    pass->getAnalysisUsage(AU);
+    if (is_contained(AU.getRequiredSet(), &Noelle::ID)) {
+      stage.noelle = new Noelle();
+      stage.noelle->keepAnalysesAcrossRuns();
+      stage.passes->add(stage.noelle);
+    }
+    stage.passes->add(pass);
+
+    stages.push_back(std::move(stage));
+  }
+
+  return true;
+}
+
+bool FixedPoint::buildNormalization(
+    Module &M,
+    std::vector<NormalizationStep> &steps) const {
+  for (auto &name : this->normalizationPassNames) {
+    auto pass = this->createPass(name);
+    if (pass == nullptr) {
+      return false;
+    }
+
+    /*
+     * Immutable passes can be added to any pass manager.
+     */
+    if ((pass->getAsImmutablePass() != nullptr) && (!steps.empty())) {
+      auto &step = steps.back();
+      if (step.modulePasses != nullptr) {
+        step.modulePasses->add(pass);
+      } else {
+        step.functionPasses->add(pass);
+      }
+      continue;
+    }
+
+    /*
+     * Check if the pass can run on a single function.
+     */
+    auto kind = pass->getPassKind();
+    auto isFunctionPass = (pass->getAsImmutablePass() != nullptr)
+                          || (kind == PT_Function) || (kind == PT_Loop)
+                          || (kind == PT_Region);
+
+    /*
+     * Consecutive passes of the same kind share their pass manager.
+     */
+    if (steps.empty()
+        || (isFunctionPass != (steps.back().functionPasses != nullptr))) {
+      NormalizationStep step;
+      if (isFunctionPass) {
+        step.functionPasses = std::make_unique<legacy::FunctionPassManager>(&M);
+      } else {
+        step.modulePasses = std::make_unique<legacy::PassManager>();
+      }
+      steps.push_back(std::move(step));
+    }
+    auto &step = steps.back();
+    if (isFunctionPass) {
+      step.functionPasses->add(pass);
+    } else {
+      step.modulePasses->add(pass);
+    }
+  }
+
+  return true;
+}
+
+Pass *FixedPoint::createPass(const std::string &name) const {
+  auto registry = PassRegistry::getPassRegistry();
+  auto passInfo = registry->getPassInfo(name);
+  if ((passInfo == nullptr) || (passInfo->getNormalCtor() == nullptr)) {
+    errs() << this->prefix << "ERROR: the pass " << name
+           << " is not available\n";
+    return nullptr;
+  }
+
+  return passInfo->createPass();
+}
+
+bool FixedPoint::reportChanges(
+    Module &M,
+    std::unordered_map<Function *, uint64_t> &functionHashes,
+    uint64_t &globalsHash,
+    std::vector<Stage> &stages,
+    std::set<Function *> &changedFunctions) const {
+
+  /*
+   * Identify the functions that have been added, changed, or removed.
+   */
+  auto newFunctionHashes = this->hashFunctions(M);
+  auto newGlobalsHash = this->hashGlobals(M);
+  std::set<Function *> changed;
+  for (auto &pair : newFunctionHashes) {
+    auto oldHash = functionHashes.find(pair.first);
+    if ((oldHash == functionHashes.end()) || (oldHash->second != pair.second)) {
+      changed.insert(pair.first);
+    }
+  }
+  for (auto &pair : functionHashes) {
+    if (newFunctionHashes.count(pair.first) == 0) {
+      changed.insert(pair.first);
+    }
+  }
+  auto globalsChanged = (newGlobalsHash != globalsHash);
+  if (changed.empty() && !globalsChanged) {
+    return false;
+  }
+
+  /*
+   * Report the changes to the analyses kept across rounds.
+   */
+  this->invalidateAnalyses(stages, changed, globalsChanged);
+
+  /*
+   * Remember the new state of the module.
+   */
+  changedFunctions.insert(changed.begin(), changed.end());
+  functionHashes = std::move(newFunctionHashes);
+  globalsHash = newGlobalsHash;
+
+  return true;
+}
+
+bool FixedPoint::reportChangesOf(
+    Module &M,
+    const std::set<Function *> &functions,
+    std::unordered_map<Function *, uint64_t> &functionHashes,
+    std::vector<Stage> &stages,
+    std::set<Function *> &changedFunctions) const {
+
+  /*
+   * Identify the functions given that have changed.
+   */
+  auto newFunctionHashes = this->hashFunctions(M, functions);
+  std::set<Function *> changed;
+  for (auto &pair : newFunctionHashes) {
+    auto &hash = functionHashes[pair.first];
+    if (hash != pair.second) {
+      changed.insert(pair.first);
+      hash = pair.second;
+    }
+  }
+  if (changed.empty()) {
+    return false;
+  }
+
+  /*
+   * Report the changes to the analyses kept across rounds.
+   */
+  this->invalidateAnalyses(stages, changed, false);
+  changedFunctions.insert(changed.begin(), changed.end());
+
+  return true;
+}
+
+void FixedPoint::invalidateAnalyses(std::vector<Stage> &stages,
+                                    const std::set<Function *> &changed,
+                                    bool globalsChanged) const {
+
+  /*
+   * Changes to the globals can affect the dependences of every function.
+   */
+  for (auto &stage : stages) {
+    if (stage.noelle == nullptr) {
+      continue;
+    }
+    if (globalsChanged) {
+      stage.noelle->invalidateAnalyses();
+    } else {
+      stage.noelle->invalidateAnalysesOf(changed);
+    }
+  }
+
+  return;
+}
+
+std::unordered_map<Function *, uint64_t> FixedPoint::hashFunctions(
+    Module &M) const {
+  std::set<Function *> functions;
+  for (auto &F : M) {
+    functions.insert(&F);
+  }
+
+  return this->hashFunctions(M, functions);
+}
+
+std::unordered_map<Function *, uint64_t> FixedPoint::hashFunctions(
+    Module &M,
+    const std::set<Function *> &functions) const {
+  std::unordered_map<Function *, uint64_t> hashes;
+
+  /*
+   * The slots of the module are computed once and shared by all functions.
+   */
+  ModuleSlotTracker slots{ &M };
+  for (auto F : functions) {
+    std::string text;
+    raw_string_ostream stream{ text };
+    Value &function = *F;
+    function.print(stream, slots);
+    stream.flush();
+    hashes[F] = this->hashText(text);
+  }
+
+  return hashes;
+}
+
+uint64_t FixedPoint::hashGlobals(Module &M) const {
+  std::string text;
+  raw_string_ostream stream{ text };
+  ModuleSlotTracker slots{ &M };
+  for (auto &g : M.globals()) {
+    g.print(stream, slots);
+    stream << "\n";
+  }
+  stream.flush();
+
+  return this->hashText(text);
+}
+
+uint64_t FixedPoint::hashText(StringRef text) const {
+  MD5 hash;
+  hash.update(text);
+  MD5::MD5Result result;
+  hash.final(result);
+
+  return result.low();
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "arcana/noelle/tools/FixedPoint.hpp"
+
+namespace arcana::noelle {
+
+static cl::list<std::string> FixedPointPasses(
+    "noelle-fixedpoint-passes",
+    cl::ZeroOrMore,
+    cl::CommaSeparated,
+    cl::desc("Passes to run until the module does not change anymore"));
+static cl::list<std::string> FixedPointNormalization(
+    "noelle-fixedpoint-normalization",
+    cl::ZeroOrMore,
+    cl::CommaSeparated,
+    cl::desc("Passes that normalize the functions changed by every round"));
+
+bool FixedPoint::doInitialization(Module &M) {
+  this->passNames.assign(FixedPointPasses.begin(), FixedPointPasses.end());
+  this->normalizationPassNames.assign(FixedPointNormalization.begin(),
+                                      FixedPointNormalization.end());
+
+  return false;
+}
+
+void FixedPoint::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+// Next there is code to register your pass to "opt"
+char FixedPoint::ID = 0;
+static RegisterPass<FixedPoint> X(
+    "FixedPoint",
+    "Run passes until the module does not change anymore");
+
+// Next there is code to register your pass to "clang"
+static FixedPoint *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+                                        [](const PassManagerBuilder &,
+                                           legacy::PassManagerBase &PM) {
+                                          if (!_PassMaker) {
+                                            PM.add(_PassMaker =
+                                                       new FixedPoint());
+                                          }
+                                        }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FixedPoint());
+      }
+    }); // ** for -O0
+
+} // namespace arcana::noelle
@@ -145,7 +145,7 @@ bool LoopInvariantCodeMotion::hoistStoreOfLastValueLiveOut(
     /*
      * Create PHI to track last value in loop entry
      */
-    auto latches = loopSummary->getLatches();
+    auto &latches = loopSummary->getLatches();
     auto numPredecessors = latches.size() + 1;
     PHINode *phi = headerBuilder.CreatePHI(initialValue->getType(),
                                            numPredecessors,
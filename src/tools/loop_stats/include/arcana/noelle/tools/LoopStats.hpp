@@ -123,6 +123,7 @@ private:
 
   void printPerLoopStats(Hot *profiles, Stats *stats);
   void printStatsHumanReadable(Hot *profiles);
+  void printTimeSpentInLoopContents(void);
 };
 
 } // namespace arcana::noelle
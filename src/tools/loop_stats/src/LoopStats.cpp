@@ -78,6 +78,7 @@ void LoopStats::collectStatsForLoops(Noelle &noelle,
    * Print the statistics.
    */
   printStatsHumanReadable(profiles);
+  printTimeSpentInLoopContents();
 
   return;
 }
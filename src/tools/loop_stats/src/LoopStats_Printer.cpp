@@ -139,3 +139,28 @@ void LoopStats::printStatsHumanReadable(Hot *profiles) {
 
   return;
 }
+
+void LoopStats::printTimeSpentInLoopContents(void) {
+  std::vector<std::pair<LoopContentAnalysis, std::string>> analyses = {
+    { LOOP_DG_ANALYSIS, "Loop dependence graph" },
+    { LOOP_SCCDAG_ANALYSIS, "SCCDAG" },
+    { LOOP_ENVIRONMENT_ANALYSIS, "Environment" },
+    { LOOP_INVARIANTS_ANALYSIS, "Invariants" },
+    { LOOP_INDUCTION_VARIABLES_ANALYSIS, "Induction variables" },
+    { LOOP_SCCDAG_ATTRIBUTES_ANALYSIS, "SCCDAG attributes" },
+    { LOOP_ITERATION_SPACE_ANALYSIS, "Iteration space" }
+  };
+
+  /*
+   * Print the time spent computing the sub-analyses of the loops.
+   */
+  errs() << "Time spent computing loop contents\n";
+  for (auto &pair : analyses) {
+    errs() << "  " << pair.second << ": "
+           << LoopContent::getTimeSpentIn(pair.first) << " us in "
+           << LoopContent::getNumberOfComputationsOf(pair.first)
+           << " computations\n";
+  }
+
+  return;
+}
@@ -84,7 +84,7 @@ std::unordered_set<Function *> Privatizer::getPrivatizableFunctions(
       return {};
     } else if (!initializedBeforeAllUse(noelle, globalVar, currentF)) {
       return {};
-    } else if (mpa.notPrivatizable(globalVar, currentF)
+    } else if (mpa->notPrivatizable(globalVar, currentF)
                || funcSum->isDestOfMemcpy(globalVar)) {
       return {};
     }
@@ -106,7 +106,7 @@ std::unordered_set<Function *> Privatizer::getPrivatizableFunctions(
 
     for (auto currentF : privatizable) {
       auto funcSum = getFunctionSummary(currentF);
-      if (mpa.notPrivatizable(globalVar, currentF)
+      if (mpa->notPrivatizable(globalVar, currentF)
           || funcSum->isDestOfMemcpy(globalVar)) {
         return {};
       }
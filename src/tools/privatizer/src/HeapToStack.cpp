@@ -41,7 +41,7 @@ bool Privatizer::applyH2S(Noelle &noelle) {
 LiveMemorySummary Privatizer::getLiveMemorySummary(Noelle &noelle,
                                                    Function *f) {
 
-  auto cfgAnalysis = noelle.getCFGAnalysis();
+  auto &cfgAnalysis = noelle.getCFGAnalysis();
   auto funcSum = getFunctionSummary(f);
 
   auto heapAllocInsts = funcSum->mallocInsts;
@@ -66,7 +66,7 @@ LiveMemorySummary Privatizer::getLiveMemorySummary(Noelle &noelle,
     if (cfgAnalysis.isIncludedInACycle(*heapAllocInst)) {
       continue;
     }
-    if (mpa.mayEscape(heapAllocInst)
+    if (mpa->mayEscape(heapAllocInst)
         || funcSum->isDestOfMemcpy(heapAllocInst)) {
       continue;
     }
@@ -116,7 +116,7 @@ LiveMemorySummary Privatizer::getLiveMemorySummary(Noelle &noelle,
   while (!fixedPoint) {
     fixedPoint = true;
     for (auto freeInst : funcSum->freeInsts) {
-      auto mayBeFreed = mpa.getPointees(freeInst->getArgOperand(0), f);
+      auto mayBeFreed = mpa->getPointees(freeInst->getArgOperand(0), f);
       if (mayFreeNonAllocable(mayBeFreed)) {
         for (auto allocation : mayBeFreed) {
           if (allocation && isa<CallBase>(allocation)) {
@@ -137,7 +137,7 @@ LiveMemorySummary Privatizer::getLiveMemorySummary(Noelle &noelle,
    */
   std::unordered_set<CallBase *> removable;
   for (auto freeInst : funcSum->freeInsts) {
-    auto mayBeFreed = mpa.getPointees(freeInst->getArgOperand(0), f);
+    auto mayBeFreed = mpa->getPointees(freeInst->getArgOperand(0), f);
     if (!mayFreeNonAllocable(mayBeFreed)) {
       removable.insert(freeInst);
     }
@@ -27,12 +27,20 @@ static cl::opt<bool> DisablePrivatizer("noelle-disable-privatizer",
                                        cl::ZeroOrMore,
                                        cl::Hidden,
                                        cl::desc("Disable all privatizers"));
+static cl::opt<bool> DisableJointAnalysis(
+    "noelle-privatizer-disable-joint-analysis",
+    cl::ZeroOrMore,
+    cl::Hidden,
+    cl::desc(
+        "Check every global variable with its own may-points-to solve"));
 
 bool Privatizer::doInitialization(Module &M) {
   this->M = &M;
 
   this->enablePrivatizer =
       (DisablePrivatizer.getNumOccurrences() == 0) ? true : false;
+  this->disableJointAnalysis =
+      (DisableJointAnalysis.getNumOccurrences() > 0) ? true : false;
 
   return false;
 }
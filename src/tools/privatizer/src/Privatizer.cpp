@@ -64,7 +64,7 @@ bool FunctionSummary::isDestOfMemcpy(Value *ptr) {
   return destsOfMemcpy.find(ptr) != destsOfMemcpy.end();
 }
 
-Privatizer::Privatizer() : ModulePass{ ID } {
+Privatizer::Privatizer() : ModulePass{ ID }, mpa{ nullptr } {
   return;
 }
 
@@ -81,18 +81,57 @@ bool Privatizer::runOnModule(Module &M) {
    * Fetch NOELLE.
    */
   auto &noelle = getAnalysis<Noelle>();
-  mpa = noelle.getMayPointsToAnalysis();
+  mpa = &noelle.getMayPointsToAnalysis();
 
+  /*
+   * Check if every global variable should be analyzed alone, rather than
+   * solving the may-points-to graph of a function once for all the global
+   * variables it uses.
+   * This is slower, but it may privatize more global variables.
+   */
+  if (this->disableJointAnalysis) {
+    mpa->disableJointPrivatizationAnalysis();
+  }
+
+  /*
+   * Privatize heap allocations and global variables.
+   * Both are identified before the code changes.
+   */
   auto modified = false;
+  std::set<Function *> modifiedFunctions;
 
   auto h2s = collectH2S(noelle);
   auto g2s = collectG2S(noelle);
 
   for (auto &[f, liveMemSum] : h2s) {
-    modified |= transformH2S(noelle, liveMemSum);
+    if (transformH2S(noelle, liveMemSum)) {
+      mpa->invalidateSummaryOf(f);
+      modifiedFunctions.insert(f);
+      modified = true;
+    }
   }
   for (auto &[globalVar, privariableFunctions] : g2s) {
-    modified |= transformG2S(noelle, globalVar, privariableFunctions);
+    if (transformG2S(noelle, globalVar, privariableFunctions)) {
+      for (auto f : privariableFunctions) {
+        mpa->invalidateSummaryOf(f);
+        modifiedFunctions.insert(f);
+      }
+      modified = true;
+    }
+  }
+
+  /*
+   * The may-points-to analysis is shared with other passes.
+   */
+  if (this->disableJointAnalysis) {
+    mpa->enableJointPrivatizationAnalysis();
+  }
+
+  /*
+   * Keep the abstractions of NOELLE consistent with the new code.
+   */
+  if (modified) {
+    noelle.updateProgramDependenceGraph(modifiedFunctions);
   }
 
   return modified;
@@ -73,11 +73,13 @@ private:
 
   bool enablePrivatizer;
 
+  bool disableJointAnalysis;
+
   const std::string prefix = "Privatizer: ";
 
   const std::string emptyPrefix = "            ";
 
-  MayPointsToAnalysis mpa;
+  MayPointsToAnalysis *mpa;
 
   std::unordered_map<Function *, FunctionSummary *> functionSummaries;
 
@@ -24,6 +24,7 @@ function loadAndRunNoellePasses {
     -load ${LIB_DIR}/LoopInvariantCodeMotion.so \
     -load ${LIB_DIR}/SCEVSimplification.so \
     -load ${LIB_DIR}/Parallelizer.so \
+    -load ${LIB_DIR}/FixedPoint.so \
   "
 
   local CMD_TO_EXECUTE="noelle-load $EXTRA_UNIT_TEST_PASSES $PASSES $INPUT -o $OUTPUT -noelle-verbose=3"
@@ -57,6 +58,9 @@ function runTest {
   llvm-dis test.bc -o test.ll
 
   local UNIT_TEST_PASS="-load $TEST_LIB_DIR/UnitTestHelpers.so -load $TEST_LIB_DIR/$TEST_SO -UnitTester"
+  if test -f noelle_options.txt ; then
+    UNIT_TEST_PASS="$UNIT_TEST_PASS `cat noelle_options.txt`"
+  fi
   loadAndRunNoellePasses "$UNIT_TEST_PASS" test.bc tested.bc &> compiler_output.txt
   llvm-dis tested.bc -o tested.ll
 
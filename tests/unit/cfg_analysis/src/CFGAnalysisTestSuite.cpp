@@ -0,0 +1,251 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "CFGAnalysisTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char CFGAnalysisTestSuite::ID = 0;
+static RegisterPass<CFGAnalysisTestSuite> X("UnitTester",
+                                            "CFG Analysis Unit Tester");
+
+// Register pass to "clang"
+static CFGAnalysisTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new CFGAnalysisTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new CFGAnalysisTestSuite());
+      }
+    }); // ** for -O0
+
+const char *CFGAnalysisTestSuite::tests[] = {
+  "cycles match a walk of the cfg",
+  "cycles follow code changes",
+};
+TestFunction CFGAnalysisTestSuite::testFns[] = {
+  CFGAnalysisTestSuite::cyclesMatchAWalkOfTheCFG,
+  CFGAnalysisTestSuite::cyclesFollowCodeChanges,
+};
+
+bool CFGAnalysisTestSuite::doInitialization(Module &M) {
+  errs() << "CFGAnalysisTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("CFGAnalysisTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void CFGAnalysisTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+}
+
+bool CFGAnalysisTestSuite::runOnModule(Module &M) {
+  errs() << "CFGAnalysisTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values CFGAnalysisTestSuite::cyclesMatchAWalkOfTheCFG(ModulePass &pass,
+                                                      TestSuite &suite) {
+  CFGAnalysisTestSuite &cfgPass = static_cast<CFGAnalysisTestSuite &>(pass);
+  auto &noelle = cfgPass.getAnalysis<Noelle>();
+  auto &cfgAnalysis = noelle.getCFGAnalysis();
+  uint64_t numberOfBlocksInCycles = 0;
+  Values mismatches;
+
+  for (auto &F : *cfgPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    for (auto &bb : F) {
+      if (reachesItself(&bb)) {
+        numberOfBlocksInCycles++;
+      }
+    }
+
+    /*
+     * Ask twice to check the cycles kept from the first query.
+     */
+    compareCycles(cfgAnalysis, F, suite, "first query", mismatches);
+    compareCycles(cfgAnalysis, F, suite, "second query", mismatches);
+  }
+  if (numberOfBlocksInCycles == 0) {
+    return { "no cycles" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values CFGAnalysisTestSuite::cyclesFollowCodeChanges(ModulePass &pass,
+                                                     TestSuite &suite) {
+  CFGAnalysisTestSuite &cfgPass = static_cast<CFGAnalysisTestSuite &>(pass);
+  auto &noelle = cfgPass.getAnalysis<Noelle>();
+  auto &cfgAnalysis = noelle.getCFGAnalysis();
+  uint64_t numberOfChanges = 0;
+  Values mismatches;
+
+  for (auto &F : *cfgPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    compareCycles(cfgAnalysis, F, suite, "before the change", mismatches);
+
+    /*
+     * Fetch a basic block outside cycles that jumps unconditionally to its
+     * successor.
+     */
+    BranchInst *branch = nullptr;
+    for (auto &bb : F) {
+      auto terminator = dyn_cast<BranchInst>(bb.getTerminator());
+      if ((terminator == nullptr) || terminator->isConditional()) {
+        continue;
+      }
+      if (reachesItself(&bb)) {
+        continue;
+      }
+      branch = terminator;
+      break;
+    }
+    if (branch == nullptr) {
+      continue;
+    }
+    auto bb = branch->getParent();
+    auto succ = branch->getSuccessor(0);
+    numberOfChanges++;
+
+    /*
+     * Add a basic block that loops on itself between @bb and its successor.
+     */
+    auto &context = F.getContext();
+    auto spin = BasicBlock::Create(context, "spin", &F, succ);
+    BranchInst::Create(spin,
+                       succ,
+                       UndefValue::get(Type::getInt1Ty(context)),
+                       spin);
+    branch->setSuccessor(0, spin);
+    for (auto &phi : succ->phis()) {
+      for (auto i = 0u; i < phi.getNumIncomingValues(); i++) {
+        if (phi.getIncomingBlock(i) == bb) {
+          phi.setIncomingBlock(i, spin);
+        }
+      }
+    }
+    cfgAnalysis.invalidateCycles(&F);
+    if (!cfgAnalysis.isIncludedInACycle(*spin)) {
+      mismatches.insert(F.getName().str() + ": new cycle");
+    }
+    compareCycles(cfgAnalysis, F, suite, "after adding a cycle", mismatches);
+
+    /*
+     * Remove the cycle.
+     */
+    branch->setSuccessor(0, succ);
+    for (auto &phi : succ->phis()) {
+      for (auto i = 0u; i < phi.getNumIncomingValues(); i++) {
+        if (phi.getIncomingBlock(i) == spin) {
+          phi.setIncomingBlock(i, bb);
+        }
+      }
+    }
+    spin->eraseFromParent();
+    noelle.updateProgramDependenceGraph(std::set<Function *>{ &F });
+    compareCycles(cfgAnalysis,
+                  F,
+                  suite,
+                  "after removing the cycle",
+                  mismatches);
+  }
+  if (numberOfChanges == 0) {
+    return { "no changes" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+bool CFGAnalysisTestSuite::reachesItself(BasicBlock *bb) {
+
+  /*
+   * Walk the CFG from the successors of @bb.
+   */
+  std::unordered_set<BasicBlock *> visited;
+  std::vector<BasicBlock *> worklist(succ_begin(bb), succ_end(bb));
+  while (!worklist.empty()) {
+    auto current = worklist.back();
+    worklist.pop_back();
+    if (current == bb) {
+      return true;
+    }
+    if (!visited.insert(current).second) {
+      continue;
+    }
+    for (auto succ : successors(current)) {
+      worklist.push_back(succ);
+    }
+  }
+
+  return false;
+}
+
+void CFGAnalysisTestSuite::compareCycles(CFGAnalysis &cfgAnalysis,
+                                         Function &F,
+                                         TestSuite &suite,
+                                         std::string when,
+                                         Values &mismatches) {
+  for (auto &bb : F) {
+    auto inCycle = reachesItself(&bb);
+    auto bbName = F.getName().str() + ": "
+                  + suite.printAsOperandToString(&bb);
+    if (cfgAnalysis.isIncludedInACycle(bb) != inCycle) {
+      mismatches.insert(bbName + " " + when);
+    }
+    for (auto &inst : bb) {
+      if (cfgAnalysis.isIncludedInACycle(inst) != inCycle) {
+        mismatches.insert(bbName + ": instructions " + when);
+        break;
+      }
+    }
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
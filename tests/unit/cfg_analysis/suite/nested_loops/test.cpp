@@ -0,0 +1,29 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int square (int v){
+  return v * v;
+}
+
+int main (int argc, char *argv[]){
+  auto n = argc * 10;
+  auto s = 0;
+  for (auto i = 0; i < n; i++){
+    for (auto j = 0; j < i; j++){
+      s += square(j);
+    }
+  }
+
+  auto k = n;
+  while (k > 1){
+    if (k % 2 == 0){
+      k /= 2;
+    } else {
+      k = 3 * k + 1;
+    }
+    s++;
+  }
+  printf("%d\n", s);
+
+  return 0;
+}
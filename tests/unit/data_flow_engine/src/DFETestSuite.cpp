@@ -0,0 +1,555 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DFETestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char DFETestSuite::ID = 0;
+static RegisterPass<DFETestSuite> X("UnitTester",
+                                    "Data Flow Engine Unit Tester");
+
+// Register pass to "clang"
+static DFETestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+                                        [](const PassManagerBuilder &,
+                                           legacy::PassManagerBase &PM) {
+                                          if (!_PassMaker) {
+                                            PM.add(_PassMaker =
+                                                       new DFETestSuite());
+                                          }
+                                        }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new DFETestSuite());
+      }
+    }); // ** for -O0
+
+const char *DFETestSuite::tests[] = {
+  "sets match bit vectors",
+  "reachable instructions match a walk of the CFG",
+  "backward block summaries match the instruction solver",
+  "forward block summaries match the instruction solver",
+  "acyclic functions visit each basic block once",
+  "the solver computes reachable instructions",
+  "parallel results match sequential results"
+};
+
+TestFunction DFETestSuite::testFns[] = {
+  DFETestSuite::setsMatchBitVectors,
+  DFETestSuite::reachableInstructionsMatchCFGWalk,
+  DFETestSuite::backwardSummariesMatchInstructionSolver,
+  DFETestSuite::forwardSummariesMatchInstructionSolver,
+  DFETestSuite::acyclicFunctionsVisitEachBlockOnce,
+  DFETestSuite::solverComputesReachableInstructions,
+  DFETestSuite::parallelResultsMatchSequentialResults
+};
+
+bool DFETestSuite::doInitialization(Module &M) {
+  errs() << "DFETestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite =
+      new TestSuite("DFETestSuite", tests, testFns, numTests, "test.txt");
+  return false;
+}
+
+void DFETestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+bool DFETestSuite::runOnModule(Module &M) {
+  errs() << "DFETestSuite: Start\n";
+
+  /*
+   * Fetch the functions with a body.
+   */
+  for (auto &F : M) {
+    if (F.empty()) {
+      continue;
+    }
+    this->functions.push_back(&F);
+  }
+
+  errs() << "DFETestSuite: Running tests\n";
+  suite->runTests((ModulePass &)*this);
+
+  delete this->suite;
+
+  return false;
+}
+
+/*
+ * The equations of the reachable analysis solved by the instruction-level
+ * solver are IN[i] = GEN[i] U OUT[i] and OUT[i] = U IN[s] for every successor
+ * s of i, where GEN[i] = { i }.
+ */
+static void computeReachableGEN(Instruction *i, DataFlowBitVectorResult *df) {
+  auto &gen = df->GEN(i);
+  gen.set(df->getID(i));
+
+  return;
+}
+
+static void computeNoKILL(Instruction *i, DataFlowBitVectorResult *df) {
+  return;
+}
+
+Values DFETestSuite::setsMatchBitVectors(ModulePass &pass, TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  /*
+   * The reachable analysis computed with std::set.
+   */
+  auto computeGEN = [](Instruction *i, DataFlowResult *df) {
+    auto &gen = df->GEN(i);
+    gen.insert(i);
+  };
+  auto computeKILL = [](Instruction *i, DataFlowResult *df) { return; };
+  auto computeIN =
+      [](Instruction *i, std::set<Value *> &IN, DataFlowResult *df) {
+        auto &gen = df->GEN(i);
+        auto &out = df->OUT(i);
+        IN.insert(gen.begin(), gen.end());
+        IN.insert(out.begin(), out.end());
+      };
+  auto computeOUT = [](Instruction *i,
+                       Instruction *successor,
+                       std::set<Value *> &OUT,
+                       DataFlowResult *df) {
+    auto &inOfSuccessor = df->IN(successor);
+    OUT.insert(inOfSuccessor.begin(), inOfSuccessor.end());
+  };
+
+  /*
+   * The same analysis computed with bit vectors.
+   */
+  auto computeBitVectorIN =
+      [](Instruction *i, BitVector &IN, DataFlowBitVectorResult *df) {
+        IN |= df->GEN(i);
+        IN |= df->OUT(i);
+      };
+  auto computeBitVectorOUT = [](Instruction *i,
+                                Instruction *successor,
+                                BitVector &OUT,
+                                DataFlowBitVectorResult *df) {
+    OUT |= df->IN(successor);
+  };
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  DataFlowEngine dfe{};
+  for (auto f : dfePass.functions) {
+    auto sets =
+        dfe.applyBackward(f, computeGEN, computeKILL, computeIN, computeOUT);
+    auto bitVectors = dfe.applyBackward(f,
+                                        computeReachableGEN,
+                                        computeNoKILL,
+                                        computeBitVectorIN,
+                                        computeBitVectorOUT);
+    for (auto &inst : instructions(*f)) {
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              sets->IN(&inst),
+                              bitVectors->getValues(bitVectors->IN(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              sets->OUT(&inst),
+                              bitVectors->getValues(bitVectors->OUT(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+    }
+    delete sets;
+    delete bitVectors;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+Values DFETestSuite::reachableInstructionsMatchCFGWalk(ModulePass &pass,
+                                                       TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  DataFlowAnalysis dfa{};
+  for (auto f : dfePass.functions) {
+    auto df = dfa.runReachableAnalysis(f);
+    for (auto &inst : instructions(*f)) {
+      auto expected = DFETestSuite::walkCFG(&inst);
+      auto obtained = df->getValues(df->IN(&inst));
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              expected,
+                              obtained,
+                              mismatches,
+                              nonEmptySetsFound);
+    }
+    delete df;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+Values DFETestSuite::backwardSummariesMatchInstructionSolver(
+    ModulePass &pass,
+    TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  auto computeIN =
+      [](Instruction *i, BitVector &IN, DataFlowBitVectorResult *df) {
+        IN |= df->GEN(i);
+        IN |= df->OUT(i);
+      };
+  auto computeOUT = [](Instruction *i,
+                       Instruction *successor,
+                       BitVector &OUT,
+                       DataFlowBitVectorResult *df) {
+    OUT |= df->IN(successor);
+  };
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  DataFlowEngine dfe{};
+  for (auto f : dfePass.functions) {
+    auto summaries =
+        dfe.applyBackwardWithBlockSummaries(f,
+                                            computeReachableGEN,
+                                            computeNoKILL,
+                                            DataFlowMeetOperator::Union);
+    auto df = dfe.applyBackward(f,
+                                computeReachableGEN,
+                                computeNoKILL,
+                                computeIN,
+                                computeOUT);
+    for (auto &inst : instructions(*f)) {
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              df->getValues(df->IN(&inst)),
+                              summaries->getValues(summaries->IN(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              df->getValues(df->OUT(&inst)),
+                              summaries->getValues(summaries->OUT(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+    }
+    delete df;
+    delete summaries;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+Values DFETestSuite::forwardSummariesMatchInstructionSolver(ModulePass &pass,
+                                                            TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  /*
+   * The instructions that might have been executed before reaching a given
+   * point.
+   */
+  auto initializeIN = [](Instruction *i, BitVector &IN) { return; };
+  auto initializeOUT = [](Instruction *i, BitVector &OUT) { return; };
+  auto computeIN = [](Instruction *i,
+                      Instruction *predecessor,
+                      BitVector &IN,
+                      DataFlowBitVectorResult *df) {
+    IN |= df->OUT(predecessor);
+  };
+  auto computeOUT =
+      [](Instruction *i, BitVector &OUT, DataFlowBitVectorResult *df) {
+        OUT |= df->GEN(i);
+        OUT |= df->IN(i);
+      };
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  DataFlowEngine dfe{};
+  for (auto f : dfePass.functions) {
+    auto summaries =
+        dfe.applyForwardWithBlockSummaries(f,
+                                           computeReachableGEN,
+                                           computeNoKILL,
+                                           DataFlowMeetOperator::Union);
+    auto df = dfe.applyForward(f,
+                               computeReachableGEN,
+                               computeNoKILL,
+                               initializeIN,
+                               initializeOUT,
+                               computeIN,
+                               computeOUT);
+    for (auto &inst : instructions(*f)) {
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              df->getValues(df->IN(&inst)),
+                              summaries->getValues(summaries->IN(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              df->getValues(df->OUT(&inst)),
+                              summaries->getValues(summaries->OUT(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+    }
+    delete df;
+    delete summaries;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+Values DFETestSuite::acyclicFunctionsVisitEachBlockOnce(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  auto initializeIN = [](Instruction *i, BitVector &IN) { return; };
+  auto initializeOUT = [](Instruction *i, BitVector &OUT) { return; };
+  auto computeIN = [](Instruction *i,
+                      Instruction *predecessor,
+                      BitVector &IN,
+                      DataFlowBitVectorResult *df) {
+    IN |= df->OUT(predecessor);
+  };
+  auto computeOUT =
+      [](Instruction *i, BitVector &OUT, DataFlowBitVectorResult *df) {
+        OUT |= df->GEN(i);
+        OUT |= df->IN(i);
+      };
+
+  /*
+   * The working list follows the reverse post-order of the CFG.
+   * Hence, the basic blocks of an acyclic CFG are visited once.
+   */
+  Values mismatches;
+  auto acyclicFunctionFound = false;
+  DataFlowEngine dfe{};
+  for (auto f : dfePass.functions) {
+    if (!DFETestSuite::isAcyclic(f)) {
+      continue;
+    }
+    acyclicFunctionFound = true;
+    auto checkVisits = [&](const std::string &analysis) {
+      for (auto &bb : *f) {
+        if (dfe.getNumberOfVisits(&bb) == 1) {
+          continue;
+        }
+        mismatches.insert(f->getName().str() + ": " + analysis + ": "
+                          + std::to_string(dfe.getNumberOfVisits(&bb)));
+      }
+    };
+
+    auto df = dfe.applyForward(f,
+                               computeReachableGEN,
+                               computeNoKILL,
+                               initializeIN,
+                               initializeOUT,
+                               computeIN,
+                               computeOUT);
+    checkVisits("forward");
+    delete df;
+
+    df = dfe.applyForwardWithBlockSummaries(f,
+                                            computeReachableGEN,
+                                            computeNoKILL,
+                                            DataFlowMeetOperator::Union);
+    checkVisits("forward with block summaries");
+    delete df;
+
+    df = dfe.applyBackwardWithBlockSummaries(f,
+                                             computeReachableGEN,
+                                             computeNoKILL,
+                                             DataFlowMeetOperator::Union);
+    checkVisits("backward with block summaries");
+    delete df;
+  }
+
+  return DFETestSuite::summarize(mismatches, acyclicFunctionFound);
+}
+
+Values DFETestSuite::solverComputesReachableInstructions(ModulePass &pass,
+                                                         TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  /*
+   * Use the solver directly, so the equations are not wrapped in
+   * std::function.
+   */
+  auto initializeIN = [](Instruction *i, BitVector &IN) { return; };
+  auto initializeOUT = [](Instruction *i, BitVector &OUT) { return; };
+  auto computeOUT = [](Instruction *i,
+                       Instruction *successor,
+                       BitVector &OUT,
+                       DataFlowBitVectorResult *df) {
+    OUT |= df->IN(successor);
+  };
+  auto computeIN =
+      [](Instruction *i, BitVector &IN, DataFlowBitVectorResult *df) {
+        IN |= df->GEN(i);
+        IN |= df->OUT(i);
+      };
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  for (auto f : dfePass.functions) {
+    DataFlowSolver<DataFlowDirection::Backward,
+                   DataFlowBitVectorResult,
+                   BitVector>
+        solver{};
+    auto df = new DataFlowBitVectorResult(f);
+    solver.solve(f,
+                 df,
+                 computeReachableGEN,
+                 computeNoKILL,
+                 initializeIN,
+                 initializeOUT,
+                 computeOUT,
+                 computeIN);
+    for (auto &inst : instructions(*f)) {
+      DFETestSuite::checkSets(suite,
+                              &inst,
+                              DFETestSuite::walkCFG(&inst),
+                              df->getValues(df->IN(&inst)),
+                              mismatches,
+                              nonEmptySetsFound);
+    }
+    delete df;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+Values DFETestSuite::parallelResultsMatchSequentialResults(ModulePass &pass,
+                                                           TestSuite &suite) {
+  auto &dfePass = static_cast<DFETestSuite &>(pass);
+
+  /*
+   * Consider only the calls, so the filter is exercised as well.
+   */
+  auto filter = [](Instruction *i) -> bool { return isa<CallBase>(i); };
+
+  Values mismatches;
+  auto nonEmptySetsFound = false;
+  DataFlowAnalysis dfa{};
+  auto parallelResults = dfa.runReachableAnalysis(dfePass.functions, filter);
+  for (auto i = 0u; i < dfePass.functions.size(); i++) {
+    auto f = dfePass.functions[i];
+    auto parallelResult = parallelResults[i];
+    auto sequentialResult = dfa.runReachableAnalysis(f, filter);
+    for (auto &inst : instructions(*f)) {
+      DFETestSuite::checkSets(
+          suite,
+          &inst,
+          sequentialResult->getValues(sequentialResult->IN(&inst)),
+          parallelResult->getValues(parallelResult->IN(&inst)),
+          mismatches,
+          nonEmptySetsFound);
+    }
+    delete sequentialResult;
+    delete parallelResult;
+  }
+
+  return DFETestSuite::summarize(mismatches, nonEmptySetsFound);
+}
+
+std::set<Value *> DFETestSuite::walkCFG(Instruction *inst) {
+  std::set<Value *> reachable;
+
+  /*
+   * Add @inst and the instructions that follow it in its basic block.
+   */
+  auto bb = inst->getParent();
+  for (auto iter = BasicBlock::iterator(inst); iter != bb->end(); iter++) {
+    reachable.insert(&*iter);
+  }
+
+  /*
+   * Add the instructions of the basic blocks reachable from the successors of
+   * the basic block of @inst.
+   */
+  std::set<BasicBlock *> visited;
+  std::vector<BasicBlock *> toVisit(succ_begin(bb), succ_end(bb));
+  while (!toVisit.empty()) {
+    auto currentBB = toVisit.back();
+    toVisit.pop_back();
+    if (!visited.insert(currentBB).second) {
+      continue;
+    }
+    for (auto &i : *currentBB) {
+      reachable.insert(&i);
+    }
+    toVisit.insert(toVisit.end(), succ_begin(currentBB), succ_end(currentBB));
+  }
+
+  return reachable;
+}
+
+bool DFETestSuite::isAcyclic(Function *f) {
+  for (auto &bb : *f) {
+    for (auto succBB : successors(&bb)) {
+      auto reachable = DFETestSuite::walkCFG(&succBB->front());
+      if (reachable.find(&bb.front()) != reachable.end()) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void DFETestSuite::checkSets(TestSuite &suite,
+                             Instruction *inst,
+                             const std::set<Value *> &expected,
+                             const std::set<Value *> &obtained,
+                             Values &mismatches,
+                             bool &nonEmptySetsFound) {
+  if (!expected.empty()) {
+    nonEmptySetsFound = true;
+  }
+  if (expected == obtained) {
+    return;
+  }
+
+  auto f = inst->getFunction();
+  mismatches.insert(f->getName().str() + ": " + suite.valueToString(inst));
+
+  return;
+}
+
+Values DFETestSuite::summarize(Values &mismatches, bool nonEmptySetsFound) {
+  if (!mismatches.empty()) {
+    return mismatches;
+  }
+  if (!nonEmptySetsFound) {
+    return { "only empty sets" };
+  }
+
+  return { "consistent" };
+}
+
+} // namespace arcana::noelle
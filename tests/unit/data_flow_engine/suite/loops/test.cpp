@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static int64_t sumUpTo(int64_t n) {
+  int64_t s = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    if ((i % 3) == 0) {
+      continue;
+    }
+    s += i;
+  }
+
+  return s;
+}
+
+static int64_t distance(int64_t a, int64_t b) {
+  if (a > b) {
+    return a - b;
+  }
+
+  return b - a;
+}
+
+int main (int argc, char *argv[]){
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+
+  int64_t total = 0;
+  for (int64_t i = 0; i < iterations; ++i) {
+    for (int64_t j = 0; j < i; ++j) {
+      total += sumUpTo(j) + distance(i, j);
+      if (total > 1000000) {
+        break;
+      }
+    }
+  }
+
+  printf("%lld\n", (long long int)total);
+  return 0;
+}
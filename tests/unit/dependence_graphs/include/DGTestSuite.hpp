@@ -28,9 +28,12 @@
 
 #include "arcana/noelle/core/PDGPrinter.hpp"
 #include "arcana/noelle/core/PDG.hpp"
+#include "arcana/noelle/core/PDGCache.hpp"
+#include "arcana/noelle/core/FrozenDG.hpp"
 #include "arcana/noelle/core/SCC.hpp"
 #include "arcana/noelle/core/SCCDAG.hpp"
 #include "arcana/noelle/core/PDGGenerator.hpp"
+#include "arcana/noelle/core/AliasQueryCache.hpp"
 #include "TestSuite.hpp"
 
 #include <sstream>
@@ -69,6 +72,34 @@ private:
                                                    TestSuite &suite);
   static Values sccdagExternalNodesOfOutermostLoop(ModulePass &pass,
                                                    TestSuite &suite);
+  static Values memoryDependencesConnectMemoryInstructions(ModulePass &pass,
+                                                           TestSuite &suite);
+  static Values aliasQueryCacheKeepsResults(ModulePass &pass,
+                                            TestSuite &suite);
+  static Values updatedPDGKeepsDependencesOfUnchangedCode(ModulePass &pass,
+                                                          TestSuite &suite);
+  static Values updatedPDGFollowsStoresOfCallees(ModulePass &pass,
+                                                 TestSuite &suite);
+  static Values pdgCacheRestoresDependences(ModulePass &pass,
+                                            TestSuite &suite);
+  static Values frozenPDGHasDependencesOfPDG(ModulePass &pass,
+                                             TestSuite &suite);
+  static Values sccdagReachabilityMatchesWalk(ModulePass &pass,
+                                              TestSuite &suite);
+  static Values sccdagHasSCCsOfPDG(ModulePass &pass, TestSuite &suite);
+
+  static std::string dependenceToString(TestSuite &suite,
+                                        DGEdge<Value, Value> *dependence);
+  static std::multiset<std::string> getDependences(TestSuite &suite,
+                                                   PDG *pdg);
+  static void compareDependences(
+      const std::multiset<std::string> &expected,
+      const std::multiset<std::string> &obtained,
+      Values &mismatches);
+  static void checkFrozenDG(TestSuite &suite, PDG *pdg, Values &mismatches);
+  static void checkSCCDAGReachability(TestSuite &suite,
+                                      SCCDAG *sccdag,
+                                      Values &mismatches);
 
   Values getSCCValues(std::set<SCC *> sccs);
 
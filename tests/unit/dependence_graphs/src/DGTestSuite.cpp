@@ -54,7 +54,15 @@ const char *DGTestSuite::tests[] = {
   "pdg leaf values",
   "pdg disjoint values",
   "sccdag internal nodes (of outermost loop)",
-  "sccdag external nodes (of outermost loop)"
+  "sccdag external nodes (of outermost loop)",
+  "memory dependences connect memory instructions of a function",
+  "alias query cache keeps the results of queries",
+  "updated pdg keeps the dependences of unchanged code",
+  "updated pdg follows the stores of callees",
+  "pdg cache restores the dependences",
+  "frozen pdg has the dependences of the pdg",
+  "sccdag reachability matches a walk of the sccdag",
+  "sccdag has the strongly connected components of the pdg"
 };
 
 TestFunction DGTestSuite::testFns[] = {
@@ -65,7 +73,15 @@ TestFunction DGTestSuite::testFns[] = {
   DGTestSuite::pdgIdentifiesLeafValues,
   DGTestSuite::pdgIdentifiesDisconnectedValueSets,
   DGTestSuite::sccdagInternalNodesOfOutermostLoop,
-  DGTestSuite::sccdagExternalNodesOfOutermostLoop
+  DGTestSuite::sccdagExternalNodesOfOutermostLoop,
+  DGTestSuite::memoryDependencesConnectMemoryInstructions,
+  DGTestSuite::aliasQueryCacheKeepsResults,
+  DGTestSuite::updatedPDGKeepsDependencesOfUnchangedCode,
+  DGTestSuite::updatedPDGFollowsStoresOfCallees,
+  DGTestSuite::pdgCacheRestoresDependences,
+  DGTestSuite::frozenPDGHasDependencesOfPDG,
+  DGTestSuite::sccdagReachabilityMatchesWalk,
+  DGTestSuite::sccdagHasSCCsOfPDG
 };
 
 bool DGTestSuite::doInitialization(Module &M) {
@@ -224,3 +240,678 @@ Values DGTestSuite::getSCCValues(std::set<SCC *> sccs) {
   }
   return sccStrings;
 }
+
+Values DGTestSuite::memoryDependencesConnectMemoryInstructions(
+    ModulePass &pass,
+    TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto pdg = dgPass.getAnalysis<PDGGenerator>().getPDG();
+
+  /*
+   * Memory dependences are collected per function (possibly in parallel) and
+   * they must connect instructions of the same function that access memory.
+   */
+  Values mismatches;
+  auto memoryDependences = 0;
+  for (auto edge : pdg->getEdges()) {
+    if (!isa<MemoryDependence<Value, Value>>(edge)) {
+      continue;
+    }
+    memoryDependences++;
+    auto src = dyn_cast<Instruction>(edge->getSrc());
+    auto dst = dyn_cast<Instruction>(edge->getDst());
+    if ((src == nullptr) || (dst == nullptr)
+        || (src->getFunction() != dst->getFunction())
+        || (!PDGGenerator::canAccessMemory(src))
+        || (!PDGGenerator::canAccessMemory(dst))) {
+      mismatches.insert(dependenceToString(suite, edge));
+    }
+  }
+  if (memoryDependences == 0) {
+    return { "no memory dependences" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::aliasQueryCacheKeepsResults(ModulePass &pass,
+                                               TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &context = dgPass.M->getContext();
+  AliasResult aliasResults[] = { NoAlias, MayAlias, PartialAlias, MustAlias };
+
+  /*
+   * Values and memory locations to query.
+   * There are enough pairs of them to make the cache grow several times.
+   */
+  std::vector<Value *> values;
+  for (auto i = 0; i < 64; i++) {
+    values.push_back(ConstantInt::get(Type::getInt64Ty(context), i));
+  }
+  auto pointer = ConstantPointerNull::get(Type::getInt8PtrTy(context));
+  std::vector<MemoryLocation> locations;
+  for (auto size = 1; size <= 32; size++) {
+    locations.push_back(MemoryLocation(pointer, LocationSize::precise(size)));
+  }
+
+  /*
+   * Cache the results of the queries.
+   * The result of a query depends on the order of its operands.
+   */
+  AliasQueryCache cache;
+  Values mismatches;
+  uint64_t expectedHits = 0;
+  uint64_t expectedMisses = 0;
+  for (auto i = 0u; i < values.size(); i++) {
+    for (auto j = 0u; j < values.size(); j++) {
+      if (cache.lookup(values[i], values[j])) {
+        mismatches.insert("value query cached before its insertion");
+      }
+      expectedMisses++;
+      cache.insert(values[i], values[j], aliasResults[(i * 7 + j) % 4]);
+    }
+  }
+  for (auto i = 0u; i < locations.size(); i++) {
+    for (auto j = 0u; j < locations.size(); j++) {
+      if (cache.lookup(locations[i], locations[j])) {
+        mismatches.insert("location query cached before its insertion");
+      }
+      expectedMisses++;
+      cache.insert(locations[i], locations[j], aliasResults[(i + 5 * j) % 4]);
+    }
+  }
+
+  /*
+   * Check the results cached.
+   */
+  for (auto i = 0u; i < values.size(); i++) {
+    for (auto j = 0u; j < values.size(); j++) {
+      auto result = cache.lookup(values[i], values[j]);
+      expectedHits++;
+      if ((!result) || (*result != aliasResults[(i * 7 + j) % 4])) {
+        mismatches.insert("value query " + std::to_string(i) + ";"
+                          + std::to_string(j));
+      }
+    }
+  }
+  for (auto i = 0u; i < locations.size(); i++) {
+    for (auto j = 0u; j < locations.size(); j++) {
+      auto result = cache.lookup(locations[i], locations[j]);
+      expectedHits++;
+      if ((!result) || (*result != aliasResults[(i + 5 * j) % 4])) {
+        mismatches.insert("location query " + std::to_string(i) + ";"
+                          + std::to_string(j));
+      }
+    }
+  }
+
+  /*
+   * Queries between values are not queries between memory locations.
+   */
+  if (cache.lookup(pointer, pointer)) {
+    mismatches.insert("value query answered by a location query");
+  }
+  expectedMisses++;
+
+  /*
+   * Check the counters.
+   */
+  if (cache.getNumberOfHits() != expectedHits) {
+    mismatches.insert("hits");
+  }
+  if (cache.getNumberOfMisses() != expectedMisses) {
+    mismatches.insert("misses");
+  }
+
+  /*
+   * Nothing is cached after clearing the cache.
+   */
+  cache.clear();
+  if (cache.lookup(values[0], values[1])
+      || cache.lookup(locations[0], locations[1])) {
+    mismatches.insert("query cached after clearing the cache");
+  }
+  cache.insert(values[1], values[0], MustAlias);
+  auto result = cache.lookup(values[1], values[0]);
+  if ((!result) || (*result != MustAlias)) {
+    mismatches.insert("query not cached after clearing the cache");
+  }
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::updatedPDGKeepsDependencesOfUnchangedCode(
+    ModulePass &pass,
+    TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &pdgGenerator = dgPass.getAnalysis<PDGGenerator>();
+  auto pdg = pdgGenerator.getPDG();
+  auto dependences = getDependences(suite, pdg);
+  auto numberOfNodes = pdg->numNodes();
+  if (dependences.size() == 0) {
+    return { "no dependences" };
+  }
+  Values mismatches;
+
+  /*
+   * Recompute the dependences of main while its code did not change.
+   */
+  pdgGenerator.updatePDG(std::set<Function *>{ dgPass.mainF });
+  compareDependences(dependences, getDependences(suite, pdg), mismatches);
+
+  /*
+   * Add a new function to the program.
+   */
+  auto &context = dgPass.M->getContext();
+  auto newFunctionType =
+      FunctionType::get(Type::getVoidTy(context),
+                        { Type::getInt32PtrTy(context) },
+                        false);
+  auto newFunction = Function::Create(newFunctionType,
+                                      GlobalValue::InternalLinkage,
+                                      "dg_test_suite_new_function",
+                                      dgPass.M);
+  auto entry = BasicBlock::Create(context, "entry", newFunction);
+  IRBuilder<> builder{ entry };
+  auto pointer = &*newFunction->arg_begin();
+  builder.CreateStore(ConstantInt::get(Type::getInt32Ty(context), 0),
+                      pointer);
+  builder.CreateLoad(pointer);
+  builder.CreateRetVoid();
+  pdgGenerator.updatePDG(std::set<Function *>{ newFunction });
+  for (auto &inst : instructions(*newFunction)) {
+    if (!pdg->isInternal(&inst)) {
+      mismatches.insert("missing: " + suite.valueToString(&inst));
+    }
+  }
+
+  /*
+   * Erase the new function.
+   * The PDG must be the one of the original program.
+   */
+  newFunction->eraseFromParent();
+  pdgGenerator.updatePDG(std::set<Function *>{ newFunction });
+  compareDependences(dependences, getDependences(suite, pdg), mismatches);
+  if (pdg->numNodes() != numberOfNodes) {
+    mismatches.insert("number of nodes");
+  }
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::updatedPDGFollowsStoresOfCallees(ModulePass &pass,
+                                                    TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &pdgGenerator = dgPass.getAnalysis<PDGGenerator>();
+  auto pdg = pdgGenerator.getPDG();
+  auto dependences = getDependences(suite, pdg);
+  auto numberOfNodes = pdg->numNodes();
+  Values mismatches;
+
+  /*
+   * Add a callee that does not access memory and a caller that accesses the
+   * memory given to the callee before and after invoking it.
+   */
+  auto &context = dgPass.M->getContext();
+  auto integerType = Type::getInt32Ty(context);
+  auto calleeType = FunctionType::get(Type::getVoidTy(context),
+                                      { Type::getInt32PtrTy(context) },
+                                      false);
+  auto callee = Function::Create(calleeType,
+                                 GlobalValue::InternalLinkage,
+                                 "dg_test_suite_callee",
+                                 dgPass.M);
+  callee->addFnAttr(Attribute::ReadNone);
+  auto calleeEntry = BasicBlock::Create(context, "entry", callee);
+  IRBuilder<> calleeBuilder{ calleeEntry };
+  calleeBuilder.CreateRetVoid();
+  auto callerType = FunctionType::get(integerType,
+                                      { Type::getInt32PtrTy(context) },
+                                      false);
+  auto caller = Function::Create(callerType,
+                                 GlobalValue::InternalLinkage,
+                                 "dg_test_suite_caller",
+                                 dgPass.M);
+  auto callerEntry = BasicBlock::Create(context, "entry", caller);
+  IRBuilder<> builder{ callerEntry };
+  auto pointer = &*caller->arg_begin();
+  builder.CreateStore(ConstantInt::get(integerType, 1), pointer);
+  auto call = builder.CreateCall(callee, { pointer });
+  auto load = builder.CreateLoad(pointer);
+  builder.CreateRet(load);
+  pdgGenerator.updatePDG(std::set<Function *>{ callee, caller });
+
+  /*
+   * Make the callee store to the memory it is given.
+   * Only the callee is reported as modified.
+   */
+  callee->removeFnAttr(Attribute::ReadNone);
+  calleeBuilder.SetInsertPoint(calleeEntry->getTerminator());
+  calleeBuilder.CreateStore(ConstantInt::get(integerType, 2),
+                            &*callee->arg_begin());
+  auto updatedFunctions =
+      pdgGenerator.updatePDG(std::set<Function *>{ callee });
+  if (updatedFunctions.find(caller) == updatedFunctions.end()) {
+    mismatches.insert("caller not updated");
+  }
+  auto callDependsOnStore = false;
+  for (auto edge : pdg->fetchNode(call)->getOutgoingEdges()) {
+    if (isa<MemoryDependence<Value, Value>>(edge) && (edge->getDst() == load)) {
+      callDependsOnStore = true;
+    }
+  }
+  if (!callDependsOnStore) {
+    mismatches.insert("missing: the load depends on the store of the callee");
+  }
+
+  /*
+   * The dependences must be the ones obtained when the caller is reported as
+   * well.
+   */
+  auto dependencesAfterCallee = getDependences(suite, pdg);
+  pdgGenerator.updatePDG(std::set<Function *>{ callee, caller });
+  compareDependences(getDependences(suite, pdg),
+                     dependencesAfterCallee,
+                     mismatches);
+
+  /*
+   * Erase the new functions.
+   * The PDG must be the one of the original program.
+   */
+  caller->eraseFromParent();
+  callee->eraseFromParent();
+  pdgGenerator.updatePDG(std::set<Function *>{ callee, caller });
+  compareDependences(dependences, getDependences(suite, pdg), mismatches);
+  if (pdg->numNodes() != numberOfNodes) {
+    mismatches.insert("number of nodes");
+  }
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::pdgCacheRestoresDependences(ModulePass &pass,
+                                               TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto pdg = dgPass.getAnalysis<PDGGenerator>().getPDG();
+  SmallString<128> fileName;
+  if (sys::fs::createTemporaryFile("dg_test_suite", "pdg", fileName)) {
+    return { "temporary file" };
+  }
+  Values mismatches;
+
+  /*
+   * Store the PDG and load it back.
+   */
+  PDGCache cache(*dgPass.M, fileName.str().str());
+  if (!cache.store(pdg)) {
+    mismatches.insert("store");
+  }
+  auto loadedPDG = cache.load();
+  if (loadedPDG == nullptr) {
+    mismatches.insert("load");
+  } else {
+    compareDependences(getDependences(suite, pdg),
+                       getDependences(suite, loadedPDG),
+                       mismatches);
+    if (loadedPDG->numNodes() != pdg->numNodes()) {
+      mismatches.insert("number of nodes");
+    }
+    delete loadedPDG;
+  }
+
+  /*
+   * The PDG stored does not belong to a module with a new global.
+   */
+  auto &context = dgPass.M->getContext();
+  auto global = new GlobalVariable(*dgPass.M,
+                                   Type::getInt32Ty(context),
+                                   false,
+                                   GlobalValue::InternalLinkage,
+                                   ConstantInt::get(Type::getInt32Ty(context),
+                                                    0),
+                                   "dg_test_suite_new_global");
+  PDGCache cacheOfChangedModule(*dgPass.M, fileName.str().str());
+  loadedPDG = cacheOfChangedModule.load();
+  if (loadedPDG != nullptr) {
+    mismatches.insert("load after changing the module");
+    delete loadedPDG;
+  }
+
+  /*
+   * The PDG stored belongs to the module again once the global is removed.
+   */
+  global->eraseFromParent();
+  PDGCache cacheOfRestoredModule(*dgPass.M, fileName.str().str());
+  loadedPDG = cacheOfRestoredModule.load();
+  if (loadedPDG == nullptr) {
+    mismatches.insert("load after restoring the module");
+  } else {
+    delete loadedPDG;
+  }
+
+  /*
+   * The PDG stored was not computed with different analysis options.
+   */
+  PDGCache cacheWithOtherOptions(*dgPass.M, fileName.str().str(), 1);
+  loadedPDG = cacheWithOtherOptions.load();
+  if (loadedPDG != nullptr) {
+    mismatches.insert("load with different analysis options");
+    delete loadedPDG;
+  }
+
+  sys::fs::remove(fileName);
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::frozenPDGHasDependencesOfPDG(ModulePass &pass,
+                                                TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  Values mismatches;
+
+  /*
+   * Check the snapshot of the PDG of main, which has only internal nodes, and
+   * of its outermost loop, which also has external nodes.
+   */
+  checkFrozenDG(suite, dgPass.fdg, mismatches);
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto loopDG = dgPass.fdg->createLoopsSubgraph(LI.getLoopsInPreorder()[0]);
+  checkFrozenDG(suite, loopDG, mismatches);
+  delete loopDG;
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+void DGTestSuite::checkFrozenDG(TestSuite &suite,
+                                PDG *pdg,
+                                Values &mismatches) {
+  FrozenDG<Value> frozenDG(*pdg);
+
+  /*
+   * Check the nodes.
+   */
+  if ((frozenDG.getNumberOfNodes() != pdg->numNodes())
+      || (frozenDG.getNumberOfInternalNodes() != pdg->numInternalNodes())) {
+    mismatches.insert("number of nodes");
+  }
+  for (auto nodeID = 0u; nodeID < frozenDG.getNumberOfNodes(); nodeID++) {
+    auto value = frozenDG.getT(nodeID);
+    if ((frozenDG.getNodeID(value) != nodeID)
+        || (frozenDG.isInternal(nodeID) != pdg->isInternal(value))) {
+      mismatches.insert("node: " + suite.valueToString(value));
+    }
+  }
+
+  /*
+   * Check the outgoing and incoming edges of each node.
+   */
+  std::multiset<std::string> dependences;
+  for (auto nodeID = 0u; nodeID < frozenDG.getNumberOfNodes(); nodeID++) {
+    for (auto &edge : frozenDG.getOutgoingEdges(nodeID)) {
+      auto dependence = dependenceToString(suite, edge.edge);
+      dependences.insert(dependence);
+      if ((edge.src != nodeID)
+          || (frozenDG.getT(edge.src) != edge.edge->getSrc())
+          || (frozenDG.getT(edge.dst) != edge.edge->getDst())
+          || (edge.kind != edge.edge->getKind())
+          || (edge.isLoopCarried != edge.edge->isLoopCarriedDependence())) {
+        mismatches.insert("outgoing: " + dependence);
+      }
+    }
+    auto node = frozenDG.getNode(nodeID);
+    auto incomingEdges = std::distance(node->getIncomingEdges().begin(),
+                                       node->getIncomingEdges().end());
+    if (frozenDG.inDegree(nodeID) != static_cast<uint64_t>(incomingEdges)) {
+      mismatches.insert("incoming: "
+                        + suite.valueToString(frozenDG.getT(nodeID)));
+    }
+    for (auto edgeID : frozenDG.getIncomingEdgeIDs(nodeID)) {
+      if (frozenDG.getEdge(edgeID).dst != nodeID) {
+        mismatches.insert("incoming: "
+                          + suite.valueToString(frozenDG.getT(nodeID)));
+      }
+    }
+  }
+  compareDependences(getDependences(suite, pdg), dependences, mismatches);
+
+  return;
+}
+
+Values DGTestSuite::sccdagReachabilityMatchesWalk(ModulePass &pass,
+                                                 TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto loopDG = dgPass.fdg->createLoopsSubgraph(LI.getLoopsInPreorder()[0]);
+  auto sccdag = new SCCDAG(loopDG);
+  Values mismatches;
+
+  /*
+   * Check the reachability computed when the SCCDAG is built.
+   */
+  checkSCCDAGReachability(suite, sccdag, mismatches);
+
+  /*
+   * Merge two internal SCCs connected by a dependence and check the
+   * reachability updated by the merge.
+   */
+  for (auto edge : sccdag->getEdges()) {
+    auto srcNode = edge->getSrcNode();
+    auto dstNode = edge->getDstNode();
+    if ((srcNode == dstNode) || (!sccdag->isInternal(srcNode->getT()))
+        || (!sccdag->isInternal(dstNode->getT()))) {
+      continue;
+    }
+    std::set<DGNode<SCC> *> sccsToMerge{ srcNode, dstNode };
+    sccdag->mergeSCCs(sccsToMerge);
+    checkSCCDAGReachability(suite, sccdag, mismatches);
+    break;
+  }
+
+  delete sccdag;
+  delete loopDG;
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values DGTestSuite::sccdagHasSCCsOfPDG(ModulePass &pass, TestSuite &suite) {
+  DGTestSuite &dgPass = static_cast<DGTestSuite &>(pass);
+  auto &LI =
+      dgPass.getAnalysis<LoopInfoWrapperPass>(*dgPass.mainF).getLoopInfo();
+  auto loopDG = dgPass.fdg->createLoopsSubgraph(LI.getLoopsInPreorder()[0]);
+  auto sccdag = new SCCDAG(loopDG);
+  Values mismatches;
+
+  /*
+   * Compute the values reachable from each value of the loop.
+   */
+  std::unordered_map<Value *, std::set<Value *>> reachable;
+  for (auto node : loopDG->getNodes()) {
+    auto &reachableFromNode = reachable[node->getT()];
+    std::vector<DGNode<Value> *> toVisit{ node };
+    while (!toVisit.empty()) {
+      auto current = toVisit.back();
+      toVisit.pop_back();
+      for (auto edge : current->getOutgoingEdges()) {
+        auto dst = edge->getDstNode();
+        if (reachableFromNode.insert(dst->getT()).second) {
+          toVisit.push_back(dst);
+        }
+      }
+    }
+  }
+
+  /*
+   * Two values belong to the same SCC if and only if they reach each other.
+   */
+  for (auto &valueAndReachable : reachable) {
+    auto value = valueAndReachable.first;
+    auto scc = sccdag->sccOfValue(value);
+    if (scc == nullptr) {
+      mismatches.insert("missing: " + suite.valueToString(value));
+      continue;
+    }
+    for (auto &otherValueAndReachable : reachable) {
+      auto otherValue = otherValueAndReachable.first;
+      if (otherValue == value) {
+        continue;
+      }
+      auto areInTheSameSCC =
+          (valueAndReachable.second.count(otherValue) > 0)
+          && (otherValueAndReachable.second.count(value) > 0);
+      if ((sccdag->sccOfValue(otherValue) == scc) != areInTheSameSCC) {
+        mismatches.insert(suite.valueToString(value)
+                          + suite.unorderedValueDelimiter
+                          + suite.valueToString(otherValue));
+      }
+    }
+  }
+
+  /*
+   * Two SCCs are connected if and only if some of their values are.
+   */
+  std::set<std::pair<SCC *, SCC *>> connectedSCCs;
+  for (auto edge : loopDG->getEdges()) {
+    auto srcSCC = sccdag->sccOfValue(edge->getSrc());
+    auto dstSCC = sccdag->sccOfValue(edge->getDst());
+    if (srcSCC != dstSCC) {
+      connectedSCCs.insert({ srcSCC, dstSCC });
+    }
+  }
+  std::set<std::pair<SCC *, SCC *>> sccdagEdges;
+  for (auto edge : sccdag->getEdges()) {
+    sccdagEdges.insert({ edge->getSrc(), edge->getDst() });
+  }
+  if (connectedSCCs != sccdagEdges) {
+    mismatches.insert("sccdag edges");
+  }
+
+  delete sccdag;
+  delete loopDG;
+
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+void DGTestSuite::checkSCCDAGReachability(TestSuite &suite,
+                                          SCCDAG *sccdag,
+                                          Values &mismatches) {
+  auto nameOf = [&suite](SCC *scc) -> std::string {
+    return suite.valueToString((*scc->begin_nodes())->getT());
+  };
+
+  for (auto node : sccdag->getNodes()) {
+
+    /*
+     * Walk the SCCDAG from the current node.
+     */
+    std::set<DGNode<SCC> *> reachable;
+    std::vector<DGNode<SCC> *> toVisit{ node };
+    while (!toVisit.empty()) {
+      auto current = toVisit.back();
+      toVisit.pop_back();
+      for (auto edge : current->getOutgoingEdges()) {
+        auto dst = edge->getDstNode();
+        if (reachable.insert(dst).second) {
+          toVisit.push_back(dst);
+        }
+      }
+    }
+
+    /*
+     * Compare the nodes reached with the reachability of the SCCDAG.
+     */
+    for (auto otherNode : sccdag->getNodes()) {
+      if (otherNode == node) {
+        continue;
+      }
+      auto isReachable = (reachable.find(otherNode) != reachable.end());
+      if (sccdag->orderedBefore(node->getT(), otherNode->getT())
+          != isReachable) {
+        mismatches.insert(nameOf(node->getT()) + suite.orderedValueDelimiter
+                          + nameOf(otherNode->getT()));
+      }
+    }
+  }
+
+  return;
+}
+
+std::multiset<std::string> DGTestSuite::getDependences(TestSuite &suite,
+                                                       PDG *pdg) {
+  std::multiset<std::string> dependences;
+  for (auto edge : pdg->getEdges()) {
+    dependences.insert(dependenceToString(suite, edge));
+  }
+
+  return dependences;
+}
+
+void DGTestSuite::compareDependences(
+    const std::multiset<std::string> &expected,
+    const std::multiset<std::string> &obtained,
+    Values &mismatches) {
+  std::vector<std::string> missing;
+  std::set_difference(expected.begin(),
+                      expected.end(),
+                      obtained.begin(),
+                      obtained.end(),
+                      std::back_inserter(missing));
+  for (auto &dependence : missing) {
+    mismatches.insert("missing: " + dependence);
+  }
+  std::vector<std::string> unexpected;
+  std::set_difference(obtained.begin(),
+                      obtained.end(),
+                      expected.begin(),
+                      expected.end(),
+                      std::back_inserter(unexpected));
+  for (auto &dependence : unexpected) {
+    mismatches.insert("unexpected: " + dependence);
+  }
+
+  return;
+}
+
+std::string DGTestSuite::dependenceToString(TestSuite &suite,
+                                            DGEdge<Value, Value> *dependence) {
+  auto attributes = dependence->toString();
+  while ((attributes.size() > 0) && (attributes.back() == '\n')) {
+    attributes.pop_back();
+  }
+  auto delim = suite.orderedValueDelimiter;
+
+  return suite.valueToString(dependence->getSrc()) + delim
+         + suite.valueToString(dependence->getDst()) + delim + attributes;
+}
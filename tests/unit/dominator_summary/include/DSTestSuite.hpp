@@ -58,6 +58,17 @@ public:
 private:
   static Values domTreesAreIdentical(ModulePass &pass, TestSuite &suite);
 
+  static Values instructionDominanceMatchesDomTrees(ModulePass &pass,
+                                                    TestSuite &suite);
+
+  static Values instructionDominanceFollowsCodeMotion(ModulePass &pass,
+                                                      TestSuite &suite);
+
+  static Values instructionDominanceIsIdentical(DSTestSuite &pass,
+                                                Function &F);
+
+  static bool isBeforeOrEqual(Instruction *I, Instruction *J);
+
   static Values domNodeIsIdentical(DSTestSuite &pass,
                                    DomTreeNodeBase<BasicBlock> &node,
                                    arcana::noelle::DominatorNode &nodeS);
@@ -69,6 +80,7 @@ private:
 
   TestSuite *suite;
   Module *M;
+  Function *mainFunction;
   arcana::noelle::DominatorSummary *ds;
   DominatorTree *dt;
   PostDominatorTree *pdt;
@@ -48,9 +48,13 @@ static RegisterStandardPasses _RegPass2(
 
 const char *DSTestSuite::tests[] = {
   "dom trees are identical",
+  "instruction dominance matches the dom trees",
+  "instruction dominance follows code motion",
 };
 TestFunction DSTestSuite::testFns[] = {
   DSTestSuite::domTreesAreIdentical,
+  DSTestSuite::instructionDominanceMatchesDomTrees,
+  DSTestSuite::instructionDominanceFollowsCodeMotion,
 };
 
 bool DSTestSuite::doInitialization(Module &M) {
@@ -70,6 +74,7 @@ void DSTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
 bool DSTestSuite::runOnModule(Module &M) {
   errs() << "DSTestSuite: Start\n";
   auto mainFunction = M.getFunction("main");
+  this->mainFunction = mainFunction;
 
   this->dt = &getAnalysis<DominatorTreeWrapperPass>(*mainFunction).getDomTree();
   this->pdt = &getAnalysis<PostDominatorTreeWrapperPass>(*mainFunction)
@@ -149,3 +154,115 @@ Values DSTestSuite::domTreesAreIdentical(ModulePass &pass, TestSuite &suite) {
     return errors;
   return {};
 }
+
+Values DSTestSuite::instructionDominanceMatchesDomTrees(ModulePass &pass,
+                                                        TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+  return DSTestSuite::instructionDominanceIsIdentical(dsPass,
+                                                      *dsPass.mainFunction);
+}
+
+Values DSTestSuite::instructionDominanceFollowsCodeMotion(ModulePass &pass,
+                                                          TestSuite &suite) {
+  auto &dsPass = static_cast<DSTestSuite &>(pass);
+
+  /*
+   * Fetch a basic block with at least two instructions that can be moved.
+   */
+  Instruction *inst = nullptr;
+  for (auto &bb : *dsPass.mainFunction) {
+    auto first = bb.getFirstNonPHI();
+    if ((first != bb.getTerminator())
+        && (first->getNextNode() != bb.getTerminator())) {
+      inst = first;
+      break;
+    }
+  }
+  if (inst == nullptr) {
+    return { "No basic block has instructions to move" };
+  }
+  auto bb = inst->getParent();
+  auto next = inst->getNextNode();
+
+  /*
+   * Number the instructions of the basic block.
+   */
+  Values errors = DSTestSuite::instructionDominanceIsIdentical(
+      dsPass,
+      *dsPass.mainFunction);
+  if (errors.size() > 0)
+    return errors;
+
+  /*
+   * Add an instruction to the basic block.
+   */
+  auto one = ConstantInt::get(Type::getInt32Ty(bb->getContext()), 1);
+  auto newInst = BinaryOperator::CreateAdd(one, one, "", bb->getTerminator());
+  errors = DSTestSuite::instructionDominanceIsIdentical(dsPass,
+                                                        *dsPass.mainFunction);
+  newInst->eraseFromParent();
+  dsPass.ds->invalidateInstructionOrdinals(bb);
+  if (errors.size() > 0)
+    return errors;
+
+  /*
+   * Move an instruction to the end of the basic block and then back.
+   */
+  inst->moveBefore(bb->getTerminator());
+  dsPass.ds->invalidateInstructionOrdinals(bb);
+  errors = DSTestSuite::instructionDominanceIsIdentical(dsPass,
+                                                        *dsPass.mainFunction);
+  inst->moveBefore(next);
+  dsPass.ds->invalidateInstructionOrdinals();
+  if (errors.size() > 0)
+    return errors;
+
+  return DSTestSuite::instructionDominanceIsIdentical(dsPass,
+                                                      *dsPass.mainFunction);
+}
+
+Values DSTestSuite::instructionDominanceIsIdentical(DSTestSuite &pass,
+                                                    Function &F) {
+  for (auto &I : instructions(F)) {
+    for (auto &J : instructions(F)) {
+
+      /*
+       * Compute the expected dominance between the instructions.
+       */
+      bool dominates, postDominates;
+      auto B1 = I.getParent();
+      auto B2 = J.getParent();
+      if (B1 == B2) {
+        dominates = DSTestSuite::isBeforeOrEqual(&I, &J);
+        postDominates = !dominates;
+      } else {
+        dominates = pass.dt->dominates(B1, B2);
+        postDominates = pass.pdt->dominates(B1, B2);
+      }
+
+      /*
+       * Compare it with the summary.
+       */
+      if (pass.ds->DT.dominates(&I, &J) != dominates) {
+        return { "Dominance summary is not correct for: "
+                 + pass.suite->printToString(&I) + " and "
+                 + pass.suite->printToString(&J) };
+      }
+      if (pass.ds->PDT.dominates(&I, &J) != postDominates) {
+        return { "Post-dominance summary is not correct for: "
+                 + pass.suite->printToString(&I) + " and "
+                 + pass.suite->printToString(&J) };
+      }
+    }
+  }
+  return {};
+}
+
+bool DSTestSuite::isBeforeOrEqual(Instruction *I, Instruction *J) {
+  for (auto inst = I; inst != nullptr; inst = inst->getNextNode()) {
+    if (inst == J) {
+      return true;
+    }
+  }
+  return false;
+}
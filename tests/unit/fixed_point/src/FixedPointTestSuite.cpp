@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "FixedPointTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char FixedPointTestSuite::ID = 0;
+static RegisterPass<FixedPointTestSuite> X("UnitTester",
+                                           "Fixed Point Unit Tester");
+
+char FixedPointTestStep::ID = 0;
+uint32_t FixedPointTestStep::runs = 0;
+static RegisterPass<FixedPointTestStep> Y("FixedPointTestStep",
+                                          "Remove one call to step");
+
+// Register pass to "clang"
+static FixedPointTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FixedPointTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FixedPointTestSuite());
+      }
+    }); // ** for -O0
+
+const char *FixedPointTestSuite::tests[] = {
+  "fixed point runs until the module does not change",
+};
+TestFunction FixedPointTestSuite::testFns[] = {
+  FixedPointTestSuite::fixedPointRunsUntilTheModuleDoesNotChange,
+};
+
+bool FixedPointTestSuite::doInitialization(Module &M) {
+  errs() << "FixedPointTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("FixedPointTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void FixedPointTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+bool FixedPointTestSuite::runOnModule(Module &M) {
+  errs() << "FixedPointTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values FixedPointTestSuite::fixedPointRunsUntilTheModuleDoesNotChange(
+    ModulePass &pass,
+    TestSuite &suite) {
+  FixedPointTestSuite &fixedPointPass =
+      static_cast<FixedPointTestSuite &>(pass);
+  auto &M = *fixedPointPass.M;
+  Values results;
+
+  auto runFixedPoint = [&M, &results, &suite](std::string run) {
+    FixedPointTestStep::runs = 0;
+    legacy::PassManager passes;
+    passes.add(new FixedPoint());
+    auto modified = passes.run(M);
+    results.insert(run + suite.orderedValueDelimiter
+                   + (modified ? "modified" : "not modified"));
+    results.insert(run + suite.orderedValueDelimiter + "rounds"
+                   + suite.orderedValueDelimiter
+                   + std::to_string(FixedPointTestStep::runs));
+  };
+
+  /*
+   * Every round removes one call until none is left.
+   */
+  auto calls = FixedPointTestStep::getStepCalls(M).size();
+  results.insert("calls before" + suite.orderedValueDelimiter
+                 + std::to_string(calls));
+  runFixedPoint("first run");
+  results.insert("calls after" + suite.orderedValueDelimiter
+                 + std::to_string(FixedPointTestStep::getStepCalls(M).size()));
+  if (verifyModule(M, &errs())) {
+    results.insert("broken module");
+  }
+
+  /*
+   * The module is at its fixed point already.
+   */
+  runFixedPoint("second run");
+
+  return results;
+}
+
+std::vector<CallInst *> FixedPointTestStep::getStepCalls(Module &M) {
+  std::vector<CallInst *> calls;
+  for (auto &F : M) {
+    for (auto &inst : instructions(F)) {
+      auto call = dyn_cast<CallInst>(&inst);
+      if ((call == nullptr) || (call->getCalledFunction() == nullptr)) {
+        continue;
+      }
+      if (call->getCalledFunction()->getName() == "step") {
+        calls.push_back(call);
+      }
+    }
+  }
+
+  return calls;
+}
+
+bool FixedPointTestStep::runOnModule(Module &M) {
+  runs++;
+
+  auto calls = getStepCalls(M);
+  if (calls.empty()) {
+    return false;
+  }
+  calls.front()->eraseFromParent();
+
+  return true;
+}
+
+void FixedPointTestStep::getAnalysisUsage(AnalysisUsage &AU) const {
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,14 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+extern "C" void step (int i){
+  printf("Step %d\n", i);
+}
+
+int main (int argc, char *argv[]){
+  step(argc);
+  step(argc + 1);
+  step(argc + 2);
+
+  return 0;
+}
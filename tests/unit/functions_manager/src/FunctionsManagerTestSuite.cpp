@@ -0,0 +1,198 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "FunctionsManagerTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char FunctionsManagerTestSuite::ID = 0;
+static RegisterPass<FunctionsManagerTestSuite> X(
+    "UnitTester",
+    "Functions Manager Unit Tester");
+
+// Register pass to "clang"
+static FunctionsManagerTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FunctionsManagerTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new FunctionsManagerTestSuite());
+      }
+    }); // ** for -O0
+
+const char *FunctionsManagerTestSuite::tests[] = {
+  "reachable functions match a walk of the call graph",
+  "reachable functions from many roots match a walk of the call graph",
+};
+TestFunction FunctionsManagerTestSuite::testFns[] = {
+  FunctionsManagerTestSuite::reachableFunctionsMatchCallGraphWalk,
+  FunctionsManagerTestSuite::reachableFunctionsFromManyRootsMatchCallGraphWalk,
+};
+
+bool FunctionsManagerTestSuite::doInitialization(Module &M) {
+  errs() << "FunctionsManagerTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("FunctionsManagerTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void FunctionsManagerTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+}
+
+bool FunctionsManagerTestSuite::runOnModule(Module &M) {
+  errs() << "FunctionsManagerTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values FunctionsManagerTestSuite::reachableFunctionsMatchCallGraphWalk(
+    ModulePass &pass,
+    TestSuite &suite) {
+  FunctionsManagerTestSuite &fmPass =
+      static_cast<FunctionsManagerTestSuite &>(pass);
+  auto &noelle = fmPass.getAnalysis<Noelle>();
+  auto fm = noelle.getFunctionsManager();
+  auto callGraph = fm->getProgramCallGraph();
+  Values mismatches;
+
+  for (auto &F : *fmPass.M) {
+    auto expected = walkCallGraph(callGraph, &F);
+
+    /*
+     * Ask twice: the second time the reachable functions are cached.
+     */
+    for (auto i = 0; i < 2; i++) {
+      auto obtained = fm->getFunctionsReachableFrom(&F);
+      compareReachableFunctions(&F, expected, obtained, mismatches);
+    }
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values FunctionsManagerTestSuite::
+    reachableFunctionsFromManyRootsMatchCallGraphWalk(ModulePass &pass,
+                                                      TestSuite &suite) {
+  FunctionsManagerTestSuite &fmPass =
+      static_cast<FunctionsManagerTestSuite &>(pass);
+  auto &noelle = fmPass.getAnalysis<Noelle>();
+  auto fm = noelle.getFunctionsManager();
+  auto callGraph = fm->getProgramCallGraph();
+  Values mismatches;
+
+  /*
+   * Drop the reachable functions cached by the previous tests, so they are
+   * computed in parallel.
+   */
+  fm->invalidateProgramCallGraphSnapshot();
+
+  /*
+   * Use every function as a root.
+   */
+  std::vector<Function *> roots;
+  for (auto &F : *fmPass.M) {
+    roots.push_back(&F);
+  }
+  auto obtained = fm->getFunctionsReachableFrom(roots);
+
+  for (auto root : roots) {
+    auto expected = walkCallGraph(callGraph, root);
+    compareReachableFunctions(root, expected, obtained[root], mismatches);
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+void FunctionsManagerTestSuite::compareReachableFunctions(
+    Function *startingPoint,
+    const std::set<Function *> &expected,
+    const std::set<Function *> &obtained,
+    Values &mismatches) {
+  for (auto f : expected) {
+    if (obtained.find(f) == obtained.end()) {
+      mismatches.insert(startingPoint->getName().str() + ": missing "
+                        + f->getName().str());
+    }
+  }
+  for (auto f : obtained) {
+    if (expected.find(f) == expected.end()) {
+      mismatches.insert(startingPoint->getName().str() + ": unexpected "
+                        + f->getName().str());
+    }
+  }
+
+  return;
+}
+
+std::set<Function *> FunctionsManagerTestSuite::walkCallGraph(
+    CallGraph *callGraph,
+    Function *startingPoint) {
+
+  /*
+   * Visit the callees that have a body, starting from @startingPoint.
+   */
+  std::set<Function *> functions;
+  std::vector<Function *> functionsToVisit{ startingPoint };
+  while (!functionsToVisit.empty()) {
+    auto function = functionsToVisit.back();
+    functionsToVisit.pop_back();
+    if (!functions.insert(function).second) {
+      continue;
+    }
+    auto node = callGraph->getFunctionNode(function);
+    if (node == nullptr) {
+      continue;
+    }
+    for (auto edge : callGraph->getOutgoingEdges(node)) {
+      auto callee = edge->getCallee()->getFunction();
+      if ((callee == nullptr) || callee->empty()) {
+        continue;
+      }
+      functionsToVisit.push_back(callee);
+    }
+  }
+
+  return functions;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static int leaf (int v){
+  return v * 2 + 1;
+}
+
+int even (int v);
+
+int odd (int v){
+  if (v == 0){
+    return 0;
+  }
+  return even(v - 1);
+}
+
+int even (int v){
+  if (v == 0){
+    return 1;
+  }
+  return odd(v - 1);
+}
+
+int applyTwice (int (*f)(int), int v){
+  return f(f(v));
+}
+
+int notCalled (int v){
+  return leaf(v) + odd(v);
+}
+
+int main (int argc, char *argv[]){
+  auto s = applyTwice(leaf, argc);
+  s += even(argc);
+  printf("%d\n", s);
+
+  return 0;
+}
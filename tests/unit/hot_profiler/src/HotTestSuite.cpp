@@ -0,0 +1,207 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "HotTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char HotTestSuite::ID = 0;
+static RegisterPass<HotTestSuite> X("UnitTester", "Hot Unit Tester");
+
+// Register pass to "clang"
+static HotTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(PassManagerBuilder::EP_OptimizerLast,
+                                        [](const PassManagerBuilder &,
+                                           legacy::PassManagerBase &PM) {
+                                          if (!_PassMaker) {
+                                            PM.add(_PassMaker =
+                                                       new HotTestSuite());
+                                          }
+                                        }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new HotTestSuite());
+      }
+    }); // ** for -O0
+
+const char *HotTestSuite::tests[] = {
+  "static instructions follow code changes",
+  "loop aggregates match their basic blocks",
+};
+TestFunction HotTestSuite::testFns[] = {
+  HotTestSuite::staticInstructionsFollowCodeChanges,
+  HotTestSuite::loopAggregatesMatchTheirBasicBlocks,
+};
+
+bool HotTestSuite::doInitialization(Module &M) {
+  errs() << "HotTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite =
+      new TestSuite("HotTestSuite", tests, testFns, numTests, "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void HotTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+}
+
+bool HotTestSuite::runOnModule(Module &M) {
+  errs() << "HotTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values HotTestSuite::staticInstructionsFollowCodeChanges(ModulePass &pass,
+                                                         TestSuite &suite) {
+  HotTestSuite &hotPass = static_cast<HotTestSuite &>(pass);
+  auto &noelle = hotPass.getAnalysis<Noelle>();
+  auto hot = noelle.getProfiles();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *hotPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    auto loops = noelle.getLoopStructures(&F);
+    for (auto loopID = 0u; loopID < loops->size(); loopID++) {
+      numberOfLoops++;
+      auto loop = (*loops)[loopID];
+      auto header = loop->getHeader();
+      auto headerName = suite.printAsOperandToString(header);
+
+      /*
+       * Fetch the static instructions before changing the code.
+       */
+      auto headerInstructions = hot->getStaticInstructions(header);
+      auto functionInstructions = hot->getStaticInstructions(&F);
+      std::vector<uint64_t> loopInstructions;
+      for (auto otherLoop : *loops) {
+        loopInstructions.push_back(hot->getStaticInstructions(otherLoop));
+      }
+
+      /*
+       * Add an instruction to the header of the loop.
+       * Only the basic block, the function, and the loops that include the
+       * header grow.
+       */
+      auto newInst = BinaryOperator::CreateNot(
+          ConstantInt::get(Type::getInt32Ty(F.getContext()), 0));
+      newInst->insertBefore(header->getTerminator());
+      if ((hot->getStaticInstructions(header) != (headerInstructions + 1))
+          || (hot->getStaticInstructions(newInst) != 1)) {
+        mismatches.insert(headerName + ": basic block");
+      }
+      if (hot->getStaticInstructions(&F) != (functionInstructions + 1)) {
+        mismatches.insert(headerName + ": function");
+      }
+      for (auto i = 0u; i < loops->size(); i++) {
+        auto otherLoop = (*loops)[i];
+        auto growth = otherLoop->isIncluded(header) ? 1 : 0;
+        if (hot->getStaticInstructions(otherLoop)
+            != (loopInstructions[i] + growth)) {
+          mismatches.insert(headerName + ": loop "
+                            + suite.printAsOperandToString(
+                                otherLoop->getHeader()));
+        }
+      }
+
+      /*
+       * Remove the instruction.
+       */
+      newInst->eraseFromParent();
+      if ((hot->getStaticInstructions(header) != headerInstructions)
+          || (hot->getStaticInstructions(&F) != functionInstructions)
+          || (hot->getStaticInstructions(loop) != loopInstructions[loopID])) {
+        mismatches.insert(headerName + ": removal");
+      }
+    }
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values HotTestSuite::loopAggregatesMatchTheirBasicBlocks(ModulePass &pass,
+                                                         TestSuite &suite) {
+  HotTestSuite &hotPass = static_cast<HotTestSuite &>(pass);
+  auto &noelle = hotPass.getAnalysis<Noelle>();
+  auto hot = noelle.getProfiles();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  auto checkLoops = [hot, &suite, &mismatches](
+                        std::vector<LoopStructure *> *loops,
+                        std::string when) {
+    for (auto loop : *loops) {
+      uint64_t staticInstructions = 0;
+      uint64_t totalInstructions = 0;
+      for (auto bb : loop->getBasicBlocks()) {
+        staticInstructions += hot->getStaticInstructions(bb);
+        totalInstructions += hot->getTotalInstructions(bb);
+      }
+      auto headerName = suite.printAsOperandToString(loop->getHeader());
+      if ((hot->getStaticInstructions(loop) != staticInstructions)
+          || (hot->getSelfInstructions(loop) != staticInstructions)) {
+        mismatches.insert(headerName + ": static instructions " + when);
+      }
+      if (hot->getTotalInstructions(loop) != totalInstructions) {
+        mismatches.insert(headerName + ": total instructions " + when);
+      }
+    }
+  };
+
+  for (auto &F : *hotPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    auto loops = noelle.getLoopStructures(&F);
+    numberOfLoops += loops->size();
+    checkLoops(loops, "before");
+
+    /*
+     * The aggregates do not change when the dependences are updated.
+     */
+    noelle.updateProgramDependenceGraph(std::set<Function *>{ &F });
+    checkLoops(loops, "after update");
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+} // namespace arcana::noelle
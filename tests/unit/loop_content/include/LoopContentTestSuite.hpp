@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "llvm/Pass.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+
+#include "arcana/noelle/core/Noelle.hpp"
+#include "arcana/noelle/core/LoopContent.hpp"
+#include "arcana/noelle/core/LoopCarriedDependencies.hpp"
+
+#include "TestSuite.hpp"
+
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace parallelizertests;
+
+namespace arcana::noelle {
+
+class LoopContentTestSuite : public ModulePass {
+public:
+  LoopContentTestSuite() : ModulePass{ ID } {}
+
+  /*
+   * Class fields
+   */
+  static char ID;
+  static const char *tests[];
+  static parallelizertests::TestFunction testFns[];
+
+  bool doInitialization(Module &M) override;
+  bool runOnModule(Module &M) override;
+  void getAnalysisUsage(AnalysisUsage &AU) const override;
+
+private:
+  static Values lazyLoopContentsMatchEagerLoopContents(ModulePass &pass,
+                                                       TestSuite &suite);
+
+  static Values loopContentsComputeSubAnalysesOnDemand(ModulePass &pass,
+                                                       TestSuite &suite);
+
+  static Values loopContentsFetchedInParallelAreComputed(ModulePass &pass,
+                                                         TestSuite &suite);
+
+  static Values loopContentsSurviveDependenceGraphUpdates(ModulePass &pass,
+                                                          TestSuite &suite);
+
+  static Values loopStructuresMatchLLVMLoops(ModulePass &pass,
+                                             TestSuite &suite);
+
+  static Values loopTreesFindInnermostLoopsAndAncestors(ModulePass &pass,
+                                                        TestSuite &suite);
+
+  static Values dependencesBetweenSiblingLoopsAreNotLoopCarried(
+      ModulePass &pass,
+      TestSuite &suite);
+
+  static void compareLoopContents(TestSuite &suite,
+                                  LoopContent *expected,
+                                  LoopContent *obtained,
+                                  Values &mismatches);
+
+  static Values getLoopDependences(TestSuite &suite, LoopContent *lc);
+
+  static Values getSCCs(TestSuite &suite, LoopContent *lc);
+
+  static Values getLoopInvariants(TestSuite &suite, LoopContent *lc);
+
+  static Values getInductionVariables(TestSuite &suite, LoopContent *lc);
+
+  static void compareValues(std::string kind,
+                            const Values &expected,
+                            const Values &obtained,
+                            Values &mismatches);
+
+  static void deleteLoopContents(std::vector<LoopContent *> *loopContents);
+
+  TestSuite *suite;
+  Module *M;
+};
+} // namespace arcana::noelle
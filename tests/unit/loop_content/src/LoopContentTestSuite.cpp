@@ -0,0 +1,836 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopContentTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char LoopContentTestSuite::ID = 0;
+static RegisterPass<LoopContentTestSuite> X("UnitTester",
+                                            "Loop Content Unit Tester");
+
+// Register pass to "clang"
+static LoopContentTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopContentTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new LoopContentTestSuite());
+      }
+    }); // ** for -O0
+
+const char *LoopContentTestSuite::tests[] = {
+  "lazy loop contents match eager loop contents",
+  "loop contents compute sub-analyses on demand",
+  "loop contents fetched in parallel are computed already",
+  "loop contents survive updates of the dependence graph",
+  "loop structures match the llvm loops",
+  "loop trees find the innermost loops and their common ancestors",
+  "dependences between sibling loops are not loop-carried",
+};
+TestFunction LoopContentTestSuite::testFns[] = {
+  LoopContentTestSuite::lazyLoopContentsMatchEagerLoopContents,
+  LoopContentTestSuite::loopContentsComputeSubAnalysesOnDemand,
+  LoopContentTestSuite::loopContentsFetchedInParallelAreComputed,
+  LoopContentTestSuite::loopContentsSurviveDependenceGraphUpdates,
+  LoopContentTestSuite::loopStructuresMatchLLVMLoops,
+  LoopContentTestSuite::loopTreesFindInnermostLoopsAndAncestors,
+  LoopContentTestSuite::dependencesBetweenSiblingLoopsAreNotLoopCarried,
+};
+
+bool LoopContentTestSuite::doInitialization(Module &M) {
+  errs() << "LoopContentTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("LoopContentTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void LoopContentTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<PDGGenerator>();
+  AU.addRequired<DominatorTreeWrapperPass>();
+  AU.addRequired<PostDominatorTreeWrapperPass>();
+  AU.addRequired<ScalarEvolutionWrapperPass>();
+  AU.addRequired<LoopInfoWrapperPass>();
+  AU.addRequired<CallGraphWrapperPass>();
+  AU.addRequired<Noelle>();
+}
+
+bool LoopContentTestSuite::runOnModule(Module &M) {
+  errs() << "LoopContentTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values LoopContentTestSuite::lazyLoopContentsMatchEagerLoopContents(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  auto com = noelle.getCompilationOptionsManager();
+  auto pdg = noelle.getProgramDependenceGraph();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+
+    /*
+     * Fetch the loop contents that compute their sub-analyses on demand.
+     */
+    auto loopContents = noelle.getLoopContents(&F);
+    if (loopContents->size() == 0) {
+      deleteLoopContents(loopContents);
+      continue;
+    }
+    auto fdg = pdg->createFunctionSubgraph(F);
+    auto DS = noelle.getDominators(&F);
+    LDGGenerator ldgGenerator;
+
+    for (auto lazyLC : *loopContents) {
+      numberOfLoops++;
+
+      /*
+       * Compute all the sub-analyses of the same loop immediately.
+       * This is done before the lazy loop content fetches the LLVM analyses
+       * of the function, which frees the ones fetched here.
+       */
+      auto &LI = lcPass.getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+      auto &SE = lcPass.getAnalysis<ScalarEvolutionWrapperPass>(F).getSE();
+      auto loopNode = lazyLC->getLoopHierarchyStructures();
+      auto llvmLoop = LI.getLoopFor(loopNode->getLoop()->getHeader());
+      auto eagerLC = new LoopContent(ldgGenerator,
+                                     com,
+                                     fdg,
+                                     loopNode,
+                                     llvmLoop,
+                                     *DS,
+                                     SE,
+                                     com->getMaximumNumberOfCores(),
+                                     {},
+                                     true,
+                                     8);
+
+      compareLoopContents(suite, eagerLC, lazyLC, mismatches);
+      delete eagerLC;
+    }
+
+    delete DS;
+    delete fdg;
+    deleteLoopContents(loopContents);
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::loopContentsComputeSubAnalysesOnDemand(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+
+    /*
+     * Creating the loop contents must not compute their sub-analyses.
+     */
+    auto loopDGs = LoopContent::getNumberOfComputationsOf(LOOP_DG_ANALYSIS);
+    auto loopContents = noelle.getLoopContents(&F);
+    if (LoopContent::getNumberOfComputationsOf(LOOP_DG_ANALYSIS) != loopDGs) {
+      mismatches.insert(F.getName().str() + ": computed when created");
+    }
+
+    for (auto lc : *loopContents) {
+      numberOfLoops++;
+      auto header = suite.printAsOperandToString(
+          lc->getLoopStructure()->getHeader());
+
+      /*
+       * The loop dependence graph is computed once, when it is first
+       * requested.
+       */
+      loopDGs = LoopContent::getNumberOfComputationsOf(LOOP_DG_ANALYSIS);
+      auto sccdagAttrs = LoopContent::getNumberOfComputationsOf(
+          LOOP_SCCDAG_ATTRIBUTES_ANALYSIS);
+      auto loopDG = lc->getLoopDG();
+      if (LoopContent::getNumberOfComputationsOf(LOOP_DG_ANALYSIS)
+          != (loopDGs + 1)) {
+        mismatches.insert(header + ": loop dependence graph not computed");
+      }
+      if (lc->getLoopDG() != loopDG) {
+        mismatches.insert(header + ": loop dependence graph not kept");
+      }
+      if (LoopContent::getNumberOfComputationsOf(
+              LOOP_SCCDAG_ATTRIBUTES_ANALYSIS)
+          != sccdagAttrs) {
+        mismatches.insert(header + ": SCCDAG attributes computed early");
+      }
+
+      /*
+       * The SCCDAG attributes reuse the loop dependence graph.
+       */
+      auto sccManager = lc->getSCCManager();
+      if (LoopContent::getNumberOfComputationsOf(
+              LOOP_SCCDAG_ATTRIBUTES_ANALYSIS)
+          != (sccdagAttrs + 1)) {
+        mismatches.insert(header + ": SCCDAG attributes not computed");
+      }
+      if (lc->getSCCManager() != sccManager) {
+        mismatches.insert(header + ": SCCDAG attributes not kept");
+      }
+      if (LoopContent::getNumberOfComputationsOf(LOOP_DG_ANALYSIS)
+          != (loopDGs + 1)) {
+        mismatches.insert(header + ": loop dependence graph recomputed");
+      }
+    }
+
+    deleteLoopContents(loopContents);
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::loopContentsFetchedInParallelAreComputed(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  LoopContentAnalysis analyses[] = { LOOP_DG_ANALYSIS,
+                                     LOOP_SCCDAG_ANALYSIS,
+                                     LOOP_ENVIRONMENT_ANALYSIS,
+                                     LOOP_INVARIANTS_ANALYSIS,
+                                     LOOP_INDUCTION_VARIABLES_ANALYSIS,
+                                     LOOP_SCCDAG_ATTRIBUTES_ANALYSIS };
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+
+    /*
+     * Every sub-analysis of every loop is computed once by the time the loop
+     * contents are returned.
+     */
+    std::vector<uint64_t> computations;
+    for (auto analysis : analyses) {
+      computations.push_back(LoopContent::getNumberOfComputationsOf(analysis));
+    }
+    auto loopContents = noelle.getLoopContents(&F);
+    numberOfLoops += loopContents->size();
+    for (auto i = 0u; i < computations.size(); i++) {
+      computations[i] += loopContents->size();
+      if (LoopContent::getNumberOfComputationsOf(analyses[i])
+          != computations[i]) {
+        mismatches.insert(F.getName().str() + ": analysis "
+                          + std::to_string(analyses[i]) + " not computed");
+      }
+    }
+
+    /*
+     * Requesting the sub-analyses does not compute them again.
+     */
+    for (auto lc : *loopContents) {
+      lc->getSCCManager();
+      lc->getEnvironment();
+      lc->getInvariantManager();
+    }
+    for (auto i = 0u; i < computations.size(); i++) {
+      if (LoopContent::getNumberOfComputationsOf(analyses[i])
+          != computations[i]) {
+        mismatches.insert(F.getName().str() + ": analysis "
+                          + std::to_string(analyses[i]) + " recomputed");
+      }
+    }
+
+    deleteLoopContents(loopContents);
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::loopContentsSurviveDependenceGraphUpdates(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+
+    /*
+     * Fetch the loop contents of the function twice.
+     * The second time, the function dependence graph is already cached.
+     */
+    auto loopContents = noelle.getLoopContents(&F);
+    auto cachedLoopContents = noelle.getLoopContents(&F);
+
+    /*
+     * Recompute the dependences of the function while its code did not
+     * change.
+     * This frees the function dependence graph the loop contents were
+     * created from.
+     */
+    noelle.updateProgramDependenceGraph(std::set<Function *>{ &F });
+    auto updatedLoopContents = noelle.getLoopContents(&F);
+    if ((loopContents->size() != cachedLoopContents->size())
+        || (loopContents->size() != updatedLoopContents->size())) {
+      mismatches.insert(F.getName().str() + ": number of loops");
+    } else {
+      for (auto i = 0u; i < loopContents->size(); i++) {
+        numberOfLoops++;
+        compareLoopContents(suite,
+                            (*updatedLoopContents)[i],
+                            (*loopContents)[i],
+                            mismatches);
+        compareLoopContents(suite,
+                            (*updatedLoopContents)[i],
+                            (*cachedLoopContents)[i],
+                            mismatches);
+      }
+    }
+
+    deleteLoopContents(loopContents);
+    deleteLoopContents(cachedLoopContents);
+    deleteLoopContents(updatedLoopContents);
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::loopStructuresMatchLLVMLoops(ModulePass &pass,
+                                                          TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    auto &LI = lcPass.getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    for (auto llvmLoop : LI.getLoopsInPreorder()) {
+      numberOfLoops++;
+      auto ls = new LoopStructure(llvmLoop);
+      auto header = suite.printAsOperandToString(ls->getHeader());
+
+      /*
+       * Check the basic blocks of the loop.
+       */
+      std::unordered_set<BasicBlock *> blocks(llvmLoop->block_begin(),
+                                              llvmLoop->block_end());
+      if (ls->getBasicBlocks() != blocks) {
+        mismatches.insert(header + ": basic blocks");
+      }
+      SmallVector<BasicBlock *, 4> llvmLatches;
+      llvmLoop->getLoopLatches(llvmLatches);
+      std::unordered_set<BasicBlock *> latches(llvmLatches.begin(),
+                                               llvmLatches.end());
+      if (ls->getLatches() != latches) {
+        mismatches.insert(header + ": latches");
+      }
+      if (ls->getNestingLevel() != llvmLoop->getLoopDepth()) {
+        mismatches.insert(header + ": nesting level");
+      }
+
+      /*
+       * The ordered basic blocks start from the header and include every
+       * basic block of the loop once.
+       */
+      auto orderedBlocks = ls->getOrderedBasicBlocks();
+      std::unordered_set<BasicBlock *> orderedBlockSet(orderedBlocks.begin(),
+                                                       orderedBlocks.end());
+      if ((orderedBlocks.size() == 0)
+          || (orderedBlocks.front() != llvmLoop->getHeader())
+          || (orderedBlocks.size() != blocks.size())
+          || (orderedBlockSet != blocks)) {
+        mismatches.insert(header + ": ordered basic blocks");
+      }
+
+      /*
+       * The instructions follow the ordered basic blocks.
+       */
+      std::vector<Instruction *> loopInstructions;
+      for (auto bb : orderedBlocks) {
+        for (auto &inst : *bb) {
+          loopInstructions.push_back(&inst);
+        }
+      }
+      auto loopStructureInstructions = ls->getInstructions();
+      if (!std::equal(loopStructureInstructions.begin(),
+                      loopStructureInstructions.end(),
+                      loopInstructions.begin(),
+                      loopInstructions.end())
+          || (ls->getNumberOfInstructions() != loopInstructions.size())) {
+        mismatches.insert(header + ": instructions");
+      }
+      std::unordered_set<Instruction *> instructionSet(
+          loopInstructions.begin(),
+          loopInstructions.end());
+      for (auto &inst : instructions(F)) {
+        if (ls->isIncluded(&inst) != (instructionSet.count(&inst) > 0)) {
+          mismatches.insert(header + ": inclusion of "
+                            + suite.valueToString(&inst));
+        }
+      }
+
+      /*
+       * The instructions added to the loop after the loop structure has been
+       * created belong to the loop.
+       */
+      auto newInst = BinaryOperator::CreateNot(
+          ConstantInt::get(Type::getInt32Ty(F.getContext()), 0));
+      newInst->insertBefore(ls->getHeader()->getTerminator());
+      auto newInstructions = ls->getInstructions();
+      if ((std::find(newInstructions.begin(), newInstructions.end(), newInst)
+           == newInstructions.end())
+          || !ls->isIncluded(newInst)) {
+        mismatches.insert(header + ": new instruction not included");
+      }
+      uint64_t numberOfNewInstructions =
+          std::distance(newInstructions.begin(), newInstructions.end());
+      if (numberOfNewInstructions != (loopInstructions.size() + 1)) {
+        mismatches.insert(header + ": new instruction counted");
+      }
+      newInst->eraseFromParent();
+
+      delete ls;
+    }
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::loopTreesFindInnermostLoopsAndAncestors(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  uint64_t numberOfLoops = 0;
+  Values mismatches;
+
+  for (auto &F : *lcPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    auto loopStructures = noelle.getLoopStructures(&F);
+    auto forest = noelle.organizeLoopsInTheirNestingForest(*loopStructures);
+    auto &LI = lcPass.getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
+    numberOfLoops += loopStructures->size();
+    auto headerOf = [&suite](LoopStructure *ls) -> std::string {
+      if (ls == nullptr) {
+        return "none";
+      }
+      return suite.printAsOperandToString(ls->getHeader());
+    };
+    auto headerOfLLVMLoop = [&suite](Loop *l) -> std::string {
+      if (l == nullptr) {
+        return "none";
+      }
+      return suite.printAsOperandToString(l->getHeader());
+    };
+
+    /*
+     * The innermost loop of a basic block is the one LLVM assigns it to.
+     */
+    for (auto &bb : F) {
+      auto llvmLoop = LI.getLoopFor(&bb);
+      auto node = forest->getInnermostLoopThatContains(&bb);
+      auto innermost = (node != nullptr) ? node->getLoop() : nullptr;
+      if (headerOf(innermost) != headerOfLLVMLoop(llvmLoop)) {
+        mismatches.insert("forest: " + suite.printAsOperandToString(&bb));
+      }
+      auto outermostLLVMLoop = llvmLoop;
+      while ((outermostLLVMLoop != nullptr)
+             && (outermostLLVMLoop->getParentLoop() != nullptr)) {
+        outermostLLVMLoop = outermostLLVMLoop->getParentLoop();
+      }
+
+      for (auto tree : forest->getTrees()) {
+        auto isInTree =
+            (outermostLLVMLoop != nullptr)
+            && (tree->getLoop()->getHeader() == outermostLLVMLoop->getHeader());
+        auto expectedInnermost =
+            isInTree ? headerOfLLVMLoop(llvmLoop) : std::string("none");
+        auto expectedOutermost = isInTree ? headerOfLLVMLoop(outermostLLVMLoop)
+                                          : std::string("none");
+        auto innermostNode = tree->getInnermostLoopNodeThatContains(&bb);
+        if ((headerOf(tree->getInnermostLoopThatContains(&bb))
+             != expectedInnermost)
+            || (headerOf(tree->getInnermostLoopThatContains(&*bb.begin()))
+                != expectedInnermost)
+            || (((innermostNode != nullptr) ? headerOf(innermostNode->getLoop())
+                                            : std::string("none"))
+                != expectedInnermost)) {
+          mismatches.insert("innermost: " + suite.printAsOperandToString(&bb));
+        }
+        if (headerOf(tree->getOutermostLoopThatContains(&bb))
+            != expectedOutermost) {
+          mismatches.insert("outermost: " + suite.printAsOperandToString(&bb));
+        }
+      }
+    }
+
+    for (auto tree : forest->getTrees()) {
+      auto nodes = tree->getNodes();
+      for (auto n1 : nodes) {
+
+        /*
+         * The parent of a loop is the one LLVM assigns it to.
+         */
+        auto llvmLoop = LI.getLoopFor(n1->getLoop()->getHeader());
+        auto parent = n1->getParent();
+        if (headerOf((parent != nullptr) ? parent->getLoop() : nullptr)
+            != headerOfLLVMLoop(llvmLoop->getParentLoop())) {
+          mismatches.insert("parent: " + headerOf(n1->getLoop()));
+        }
+
+        /*
+         * The lowest common ancestor of two loops is the first ancestor of
+         * the second loop that is also an ancestor of the first one.
+         */
+        std::unordered_set<LoopTree *> ancestors;
+        for (auto n = n1; n != nullptr; n = n->getParent()) {
+          ancestors.insert(n);
+        }
+        for (auto n2 : nodes) {
+          auto expected = n2;
+          while (ancestors.count(expected) == 0) {
+            expected = expected->getParent();
+          }
+          if (tree->getLowestCommonAncestor(n1, n2) != expected) {
+            mismatches.insert("common ancestor: " + headerOf(n1->getLoop())
+                              + suite.unorderedValueDelimiter
+                              + headerOf(n2->getLoop()));
+          }
+        }
+      }
+    }
+
+    delete loopStructures;
+  }
+  if (numberOfLoops == 0) {
+    return { "no loops" };
+  }
+  if (mismatches.size() == 0) {
+    return { "consistent" };
+  }
+
+  return mismatches;
+}
+
+Values LoopContentTestSuite::dependencesBetweenSiblingLoopsAreNotLoopCarried(
+    ModulePass &pass,
+    TestSuite &suite) {
+  LoopContentTestSuite &lcPass = static_cast<LoopContentTestSuite &>(pass);
+  auto &noelle = lcPass.getAnalysis<Noelle>();
+  auto &context = lcPass.M->getContext();
+  auto integerType = Type::getInt32Ty(context);
+  auto boolType = Type::getInt1Ty(context);
+
+  /*
+   * Add a function with an outer loop that includes two sibling loops.
+   * A value of the first sub-loop reaches the header of the second sub-loop
+   * only from some paths of the same iteration of the outer loop:
+   *
+   * header: i = phi [0, entry], [i + 1, latch]; br c, first, skip
+   * first: p = i + 1; br c, first, fromFirst
+   * fromFirst: br second
+   * skip: br second
+   * second: q = phi [p, fromFirst], [0, skip], [q, second]; br c, second, latch
+   * latch: br i + 1 < 10, header, exit
+   */
+  auto functionType =
+      FunctionType::get(Type::getVoidTy(context), { boolType }, false);
+  auto F = Function::Create(functionType,
+                            GlobalValue::InternalLinkage,
+                            "loop_content_test_suite_sibling_loops",
+                            lcPass.M);
+  auto condition = &*F->arg_begin();
+  auto entry = BasicBlock::Create(context, "entry", F);
+  auto header = BasicBlock::Create(context, "header", F);
+  auto first = BasicBlock::Create(context, "first", F);
+  auto fromFirst = BasicBlock::Create(context, "fromFirst", F);
+  auto skip = BasicBlock::Create(context, "skip", F);
+  auto second = BasicBlock::Create(context, "second", F);
+  auto latch = BasicBlock::Create(context, "latch", F);
+  auto exit = BasicBlock::Create(context, "exit", F);
+  IRBuilder<> builder{ entry };
+  builder.CreateBr(header);
+  builder.SetInsertPoint(header);
+  auto i = builder.CreatePHI(integerType, 2);
+  builder.CreateCondBr(condition, first, skip);
+  builder.SetInsertPoint(first);
+  auto p = builder.CreateAdd(i, ConstantInt::get(integerType, 1));
+  builder.CreateCondBr(condition, first, fromFirst);
+  builder.SetInsertPoint(fromFirst);
+  builder.CreateBr(second);
+  builder.SetInsertPoint(skip);
+  builder.CreateBr(second);
+  builder.SetInsertPoint(second);
+  auto q = builder.CreatePHI(integerType, 3);
+  builder.CreateCondBr(condition, second, latch);
+  builder.SetInsertPoint(latch);
+  auto nextI = builder.CreateAdd(i, ConstantInt::get(integerType, 1));
+  auto isLastIteration =
+      builder.CreateICmpULT(nextI, ConstantInt::get(integerType, 10));
+  builder.CreateCondBr(isLastIteration, header, exit);
+  builder.SetInsertPoint(exit);
+  builder.CreateRetVoid();
+  i->addIncoming(ConstantInt::get(integerType, 0), entry);
+  i->addIncoming(nextI, latch);
+  q->addIncoming(p, fromFirst);
+  q->addIncoming(ConstantInt::get(integerType, 0), skip);
+  q->addIncoming(q, second);
+  noelle.updateProgramDependenceGraph(std::set<Function *>{ F });
+
+  /*
+   * Compute the loop-carried dependences of the outer loop.
+   */
+  Values results;
+  auto &LI = lcPass.getAnalysis<LoopInfoWrapperPass>(*F).getLoopInfo();
+  auto fdg = noelle.getProgramDependenceGraph()->createFunctionSubgraph(*F);
+  auto loopDG = fdg->createLoopsSubgraph(LI.getLoopFor(header));
+  auto loopStructures = noelle.getLoopStructures(F, 0);
+  auto forest = noelle.organizeLoopsInTheirNestingForest(*loopStructures);
+  auto DS = noelle.getDominators(F);
+  for (auto tree : forest->getTrees()) {
+    if (tree->getLoop()->getHeader() != header) {
+      continue;
+    }
+    LoopCarriedDependencies::setLoopCarriedDependencies(tree, *DS, *loopDG);
+    for (auto edge : loopDG->fetchNode(p)->getOutgoingEdges()) {
+      if (edge->getDst() != q) {
+        continue;
+      }
+      results.insert(edge->isLoopCarriedDependence() ? "loop-carried"
+                                                     : "not loop-carried");
+    }
+  }
+  delete DS;
+  delete loopDG;
+  delete fdg;
+  delete loopStructures;
+
+  /*
+   * Remove the function.
+   */
+  F->eraseFromParent();
+  noelle.updateProgramDependenceGraph(std::set<Function *>{ F });
+
+  return results;
+}
+
+void LoopContentTestSuite::compareLoopContents(TestSuite &suite,
+                                               LoopContent *expected,
+                                               LoopContent *obtained,
+                                               Values &mismatches) {
+  auto header =
+      suite.printAsOperandToString(expected->getLoopStructure()->getHeader());
+
+  /*
+   * Compare the dependences of the loops.
+   */
+  compareValues(header + ": dependence",
+                getLoopDependences(suite, expected),
+                getLoopDependences(suite, obtained),
+                mismatches);
+
+  /*
+   * Compare the strongly connected components of the loops.
+   */
+  compareValues(header + ": SCC",
+                getSCCs(suite, expected),
+                getSCCs(suite, obtained),
+                mismatches);
+
+  /*
+   * Compare the environments of the loops.
+   */
+  auto expectedEnv = expected->getEnvironment();
+  auto obtainedEnv = obtained->getEnvironment();
+  if ((expectedEnv->getNumberOfLiveIns() != obtainedEnv->getNumberOfLiveIns())
+      || (expectedEnv->getNumberOfLiveOuts()
+          != obtainedEnv->getNumberOfLiveOuts())) {
+    mismatches.insert(header + ": environment");
+  }
+
+  /*
+   * Compare the invariants and the induction variables of the loops.
+   */
+  compareValues(header + ": invariant",
+                getLoopInvariants(suite, expected),
+                getLoopInvariants(suite, obtained),
+                mismatches);
+  compareValues(header + ": induction variable",
+                getInductionVariables(suite, expected),
+                getInductionVariables(suite, obtained),
+                mismatches);
+
+  return;
+}
+
+Values LoopContentTestSuite::getLoopDependences(TestSuite &suite,
+                                                LoopContent *lc) {
+  Values dependences;
+  for (auto edge : lc->getLoopDG()->getEdges()) {
+    auto attributes = edge->toString();
+    while ((attributes.size() > 0) && (attributes.back() == '\n')) {
+      attributes.pop_back();
+    }
+    dependences.insert(suite.valueToString(edge->getSrc())
+                       + suite.orderedValueDelimiter
+                       + suite.valueToString(edge->getDst())
+                       + suite.orderedValueDelimiter + attributes);
+  }
+
+  return dependences;
+}
+
+Values LoopContentTestSuite::getSCCs(TestSuite &suite, LoopContent *lc) {
+  Values sccs;
+  auto sccdag = lc->getSCCManager()->getSCCDAG();
+  for (auto sccNode : sccdag->getNodes()) {
+    std::vector<std::string> values;
+    for (auto nodePair : sccNode->getT()->internalNodePairs()) {
+      values.push_back(suite.valueToString(nodePair.first));
+    }
+    std::sort(values.begin(), values.end());
+    sccs.insert(suite.combineUnorderedValues(values));
+  }
+
+  return sccs;
+}
+
+Values LoopContentTestSuite::getLoopInvariants(TestSuite &suite,
+                                               LoopContent *lc) {
+  Values invariants;
+  auto invariantManager = lc->getInvariantManager();
+  for (auto inst :
+       invariantManager->getLoopInstructionsThatAreLoopInvariants()) {
+    invariants.insert(suite.valueToString(inst));
+  }
+
+  return invariants;
+}
+
+Values LoopContentTestSuite::getInductionVariables(TestSuite &suite,
+                                                   LoopContent *lc) {
+  Values ivs;
+  auto ivManager = lc->getInductionVariableManager();
+  for (auto iv : ivManager->getInductionVariables()) {
+    ivs.insert(suite.valueToString(iv->getLoopEntryPHI()));
+  }
+  auto governingIV = ivManager->getLoopGoverningInductionVariable();
+  if (governingIV != nullptr) {
+    auto phi = governingIV->getInductionVariable()->getLoopEntryPHI();
+    ivs.insert("governing" + suite.orderedValueDelimiter
+               + suite.valueToString(phi));
+  }
+
+  return ivs;
+}
+
+void LoopContentTestSuite::compareValues(std::string kind,
+                                         const Values &expected,
+                                         const Values &obtained,
+                                         Values &mismatches) {
+  for (auto &value : expected) {
+    if (obtained.count(value) == 0) {
+      mismatches.insert(kind + " missing: " + value);
+    }
+  }
+  for (auto &value : obtained) {
+    if (expected.count(value) == 0) {
+      mismatches.insert(kind + " unexpected: " + value);
+    }
+  }
+
+  return;
+}
+
+void LoopContentTestSuite::deleteLoopContents(
+    std::vector<LoopContent *> *loopContents) {
+  for (auto lc : *loopContents) {
+    delete lc;
+  }
+  delete loopContents;
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long computeSum (long long *a, int n){
+  long long s = 0;
+  for (int i = 0; i < n; i++){
+    s += a[i];
+  }
+
+  return s;
+}
+
+int main (int argc, char *argv[]){
+  if (argc < 3){
+    return -1;
+  }
+  auto rows = atoi(argv[1]);
+  auto columns = atoi(argv[2]);
+  auto a = (long long *) calloc(rows * columns, sizeof(long long));
+
+  for (int i = 0; i < rows; i++){
+    for (int j = 0; j < columns; j++){
+      a[i * columns + j] = i + j;
+      if (j > 0){
+        a[i * columns + j] += a[i * columns + j - 1];
+      }
+    }
+  }
+
+  long long s = 0;
+  for (int k = 0; k < argc; k++){
+    s += computeSum(a, rows * columns);
+  }
+  printf("%lld\n", s);
+
+  free(a);
+  return 0;
+}
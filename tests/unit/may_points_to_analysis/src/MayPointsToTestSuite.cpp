@@ -0,0 +1,369 @@
+/*
+ * Copyright 2024  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do
+ so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+ OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "MayPointsToTestSuite.hpp"
+
+namespace arcana::noelle {
+
+// Register pass to "opt"
+char MayPointsToTestSuite::ID = 0;
+static RegisterPass<MayPointsToTestSuite> X("UnitTester",
+                                            "May Points-To Unit Tester");
+
+// Register pass to "clang"
+static MayPointsToTestSuite *_PassMaker = NULL;
+static RegisterStandardPasses _RegPass1(
+    PassManagerBuilder::EP_OptimizerLast,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new MayPointsToTestSuite());
+      }
+    }); // ** for -Ox
+static RegisterStandardPasses _RegPass2(
+    PassManagerBuilder::EP_EnabledOnOptLevel0,
+    [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+      if (!_PassMaker) {
+        PM.add(_PassMaker = new MayPointsToTestSuite());
+      }
+    }); // ** for -O0
+
+const char *MayPointsToTestSuite::tests[] = {
+  "joint privatization matches single candidates",
+  "objects reachable through an argument escape",
+  "copy-edge cycles through unknown keep their pointees",
+  "summaries follow code changes",
+};
+TestFunction MayPointsToTestSuite::testFns[] = {
+  MayPointsToTestSuite::jointPrivatizationMatchesSingleCandidates,
+  MayPointsToTestSuite::objectsReachableThroughAnArgumentEscape,
+  MayPointsToTestSuite::copyEdgeCyclesThroughUnknownKeepTheirPointees,
+  MayPointsToTestSuite::summariesFollowCodeChanges,
+};
+
+bool MayPointsToTestSuite::doInitialization(Module &M) {
+  errs() << "MayPointsToTestSuite: Initialize\n";
+  const int numTests = sizeof(tests) / sizeof(tests[0]);
+  this->suite = new TestSuite("MayPointsToTestSuite",
+                              tests,
+                              testFns,
+                              numTests,
+                              "test.txt");
+  this->M = &M;
+  return false;
+}
+
+void MayPointsToTestSuite::getAnalysisUsage(AnalysisUsage &AU) const {
+  AU.addRequired<Noelle>();
+}
+
+bool MayPointsToTestSuite::runOnModule(Module &M) {
+  errs() << "MayPointsToTestSuite: Start\n";
+
+  suite->runTests((ModulePass &)*this);
+
+  return false;
+}
+
+Values MayPointsToTestSuite::jointPrivatizationMatchesSingleCandidates(
+    ModulePass &pass,
+    TestSuite &suite) {
+
+  /*
+   * @c is stored into @b and @d is returned: they cannot be privatized.
+   */
+  auto module = parseModule(pass, R"(
+    @a = global i32 0
+    @b = global i32* null
+    @c = global i32 0
+    @d = global i32 0
+
+    define i32* @candidates() {
+      store i32 1, i32* @a
+      store i32* @c, i32** @b
+      %v = load i32, i32* @d
+      ret i32* @d
+    }
+  )");
+  if (module == nullptr) {
+    return { "parse error" };
+  }
+  auto F = module->getFunction("candidates");
+
+  /*
+   * Compute the answers one candidate at a time, and then for all candidates
+   * together.
+   */
+  MayPointsToAnalysis mpa;
+  mpa.disableJointPrivatizationAnalysis();
+  std::unordered_map<GlobalVariable *, bool> singleResults;
+  for (auto &global : module->globals()) {
+    singleResults[&global] = mpa.notPrivatizable(&global, F);
+  }
+  mpa.enableJointPrivatizationAnalysis();
+  Values results;
+  for (auto &global : module->globals()) {
+    auto jointResult = mpa.notPrivatizable(&global, F);
+    auto name = global.getName().str();
+    if (jointResult != singleResults[&global]) {
+      results.insert(name + ": mismatch");
+      continue;
+    }
+    results.insert(name + suite.orderedValueDelimiter
+                   + (jointResult ? "not privatizable" : "privatizable"));
+  }
+
+  /*
+   * Disabling the joint analysis again restores the answers of single
+   * candidates, which reuse the summary of the function.
+   */
+  mpa.disableJointPrivatizationAnalysis();
+  for (auto &global : module->globals()) {
+    if (mpa.notPrivatizable(&global, F) != singleResults[&global]) {
+      results.insert(global.getName().str() + ": mismatch after disabling");
+    }
+  }
+
+  return results;
+}
+
+Values MayPointsToTestSuite::objectsReachableThroughAnArgumentEscape(
+    ModulePass &pass,
+    TestSuite &suite) {
+
+  /*
+   * %mid becomes reachable from the argument %box only through the memory
+   * object of %box, and %obj only through the one of %mid.
+   */
+  auto module = parseModule(pass, R"(
+    declare void @ext(i8***)
+    declare i8* @get()
+
+    define void @escape() {
+      %obj = alloca i8
+      %other = alloca i8
+      %mid = alloca i8*
+      %box = alloca i8**
+      %unused = alloca i8*
+      call void @ext(i8*** %box)
+      store i8** %mid, i8*** %box
+      store i8* %obj, i8** %mid
+      store i8* %other, i8** %unused
+      %r = call i8* @get()
+      ret void
+    }
+  )");
+  if (module == nullptr) {
+    return { "parse error" };
+  }
+  auto F = module->getFunction("escape");
+
+  /*
+   * Every object reachable from %box escapes, and the pointer returned by an
+   * external call may point to all of them.
+   */
+  MayPointsToAnalysis mpa;
+  Values results;
+  for (auto name : { "obj", "other", "mid", "box", "unused" }) {
+    addEscape(results, mpa, getInstruction(*F, name), suite);
+  }
+  addPointees(results, mpa, getInstruction(*F, "r"), suite);
+
+  return results;
+}
+
+Values MayPointsToTestSuite::copyEdgeCyclesThroughUnknownKeepTheirPointees(
+    ModulePass &pass,
+    TestSuite &suite) {
+
+  /*
+   * %p and %r form a copy-edge cycle that goes through the "unknown" memory
+   * object.
+   */
+  auto module = parseModule(pass, R"(
+    declare i8* @ext(i8*)
+
+    define void @cycle(i1 %c) {
+    entry:
+      %local = alloca i8
+      %private = alloca i8
+      %slot = alloca i8*
+      store i8* %private, i8** %slot
+      br label %loop
+
+    loop:
+      %p = phi i8* [ %local, %entry ], [ %r, %loop ]
+      %r = call i8* @ext(i8* %p)
+      br i1 %c, label %loop, label %exit
+
+    exit:
+      %v = load i8*, i8** %slot
+      ret void
+    }
+  )");
+  if (module == nullptr) {
+    return { "parse error" };
+  }
+  auto F = module->getFunction("cycle");
+
+  /*
+   * The nodes of the cycle share their pointees, while the objects outside
+   * the cycle keep their own.
+   */
+  MayPointsToAnalysis mpa;
+  Values results;
+  for (auto name : { "local", "private", "slot" }) {
+    addEscape(results, mpa, getInstruction(*F, name), suite);
+  }
+  for (auto name : { "p", "r", "v" }) {
+    addPointees(results, mpa, getInstruction(*F, name), suite);
+  }
+
+  return results;
+}
+
+Values MayPointsToTestSuite::summariesFollowCodeChanges(ModulePass &pass,
+                                                        TestSuite &suite) {
+  MayPointsToTestSuite &mpaPass = static_cast<MayPointsToTestSuite &>(pass);
+  auto &noelle = mpaPass.getAnalysis<Noelle>();
+
+  /*
+   * The analysis is shared, and so are the summaries it keeps.
+   */
+  auto &mpa = noelle.getMayPointsToAnalysis();
+  Values results;
+  if (&noelle.getMayPointsToAnalysis() != &mpa) {
+    results.insert("not shared");
+  }
+
+  /*
+   * Fetch the memory object allocated by malloc.
+   */
+  std::vector<Function *> functions;
+  CallInst *mallocCall = nullptr;
+  for (auto &F : *mpaPass.M) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    functions.push_back(&F);
+    for (auto &inst : instructions(F)) {
+      auto call = dyn_cast<CallInst>(&inst);
+      if ((call == nullptr) || (call->getCalledFunction() == nullptr)) {
+        continue;
+      }
+      if (call->getCalledFunction()->getName() == "malloc") {
+        mallocCall = call;
+      }
+    }
+  }
+  if (mallocCall == nullptr) {
+    return { "no malloc" };
+  }
+  auto F = mallocCall->getFunction();
+
+  /*
+   * The memory object is freed without escaping.
+   */
+  mpa.computeSummaries(functions, 2);
+  auto addEscapeOf = [&mpa, mallocCall, &results, &suite](std::string when) {
+    auto escape = mpa.mayEscape(mallocCall) ? "escapes" : "does not escape";
+    results.insert(when + suite.orderedValueDelimiter + escape);
+  };
+  addEscapeOf("before");
+
+  /*
+   * Pass the memory object to an external function.
+   * The summary of the function must be computed again.
+   */
+  auto escapeType = FunctionType::get(Type::getVoidTy(F->getContext()),
+                                      { mallocCall->getType() },
+                                      false);
+  auto escapeFunction = Function::Create(escapeType,
+                                         GlobalValue::ExternalLinkage,
+                                         "mpa_test_suite_escape",
+                                         mpaPass.M);
+  auto escapeCall = CallInst::Create(escapeFunction, { mallocCall });
+  escapeCall->insertAfter(mallocCall);
+  noelle.updateProgramDependenceGraph(std::set<Function *>{ F });
+  addEscapeOf("after adding the call");
+
+  /*
+   * Remove the call.
+   */
+  escapeCall->eraseFromParent();
+  escapeFunction->eraseFromParent();
+  noelle.updateProgramDependenceGraph(std::set<Function *>{ F });
+  addEscapeOf("after removing the call");
+
+  return results;
+}
+
+std::unique_ptr<Module> MayPointsToTestSuite::parseModule(
+    ModulePass &pass,
+    const std::string &ir) {
+  MayPointsToTestSuite &mpaPass = static_cast<MayPointsToTestSuite &>(pass);
+  SMDiagnostic error;
+  auto module = parseAssemblyString(ir, error, mpaPass.M->getContext());
+  if (module == nullptr) {
+    error.print("MayPointsToTestSuite", errs());
+  }
+
+  return module;
+}
+
+Instruction *MayPointsToTestSuite::getInstruction(Function &F,
+                                                  const std::string &name) {
+  for (auto &inst : instructions(F)) {
+    if (inst.getName() == name) {
+      return &inst;
+    }
+  }
+  assert(false && "The instruction does not exist");
+
+  return nullptr;
+}
+
+void MayPointsToTestSuite::addEscape(Values &results,
+                                     MayPointsToAnalysis &mpa,
+                                     Instruction *memobj,
+                                     TestSuite &suite) {
+  auto escape = mpa.mayEscape(memobj) ? "escapes" : "does not escape";
+  results.insert(memobj->getName().str() + suite.orderedValueDelimiter
+                 + escape);
+
+  return;
+}
+
+void MayPointsToTestSuite::addPointees(Values &results,
+                                       MayPointsToAnalysis &mpa,
+                                       Instruction *ptr,
+                                       TestSuite &suite) {
+  auto F = ptr->getFunction();
+  for (auto pointee : mpa.getPointees(ptr, F)) {
+    auto pointeeName =
+        (pointee == nullptr) ? "unknown" : pointee->getName().str();
+    results.insert(ptr->getName().str() + suite.orderedValueDelimiter
+                   + pointeeName);
+  }
+
+  return;
+}
+
+} // namespace arcana::noelle
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int compute (int n){
+  auto values = (int *) malloc(sizeof(int) * n);
+  for (auto i = 0; i < n; i++){
+    values[i] = i * 3;
+  }
+
+  auto s = 0;
+  for (auto i = 0; i < n; i++){
+    s += values[i];
+  }
+  free(values);
+
+  return s;
+}
+
+int main (int argc, char *argv[]){
+  printf("%d\n", compute(argc * 10));
+
+  return 0;
+}